@@ -0,0 +1,766 @@
+#ifndef AGGREGATE_MAP_H
+#define AGGREGATE_MAP_H
+
+#include <algorithm>  // Para std::max
+#include <cstddef>    // Para std::size_t
+#include <functional> // Para std::less y std::plus
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/****** Mapa asociativo AVL que mantiene un agregado de los valores (monoide) *******/
+/************************************************************************************/
+
+// Es el mapa de avl_map.h con un dato más por nodo: total, la combinación de
+// todos los valores de su subárbol en orden de claves. Combine tiene que ser
+// asociativa y identity su elemento neutro (un monoide): std::plus<V> con 0
+// da sumas, min_of y max_of con el máximo y el mínimo representable dan
+// mínimos y máximos, pero sirve cualquier operación asociativa aunque no sea
+// conmutativa.
+//
+// Los totales se recalculan junto con la altura cada vez que un nodo cambia
+// de hijos (en balance_tree y en las rotaciones), así que insertar y borrar
+// siguen costando O(log n) y la combinación de los valores de cualquier
+// rango de claves se obtiene en O(log n) juntando O(log n) totales, en lugar
+// de recorrer el rango con each.
+//
+// Como cambiar un valor obliga a recalcular los totales de sus ancestros,
+// los valores no se pueden modificar a través de los iteradores ni hay
+// operator[]: para cambiar un valor hay que usar insert_or_assign.
+
+// Combinaciones para obtener mínimos y máximos
+struct min_of {
+    template <typename T>
+    T operator()(const T & x, const T & y) const {
+        return y < x ? y : x;
+    }
+};
+
+struct max_of {
+    template <typename T>
+    T operator()(const T & x, const T & y) const {
+        return x < y ? y : x;
+    }
+};
+
+template <typename K, typename V, typename Combine = std::plus<V>, typename Compare = std::less<K>>
+class aggregate_map {
+    using value_type = std::pair<const K, V>;
+
+    // Como en avl_map.h, la cabecera tiene sólo los enlaces; el par y el
+    // total están en node.
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
+        int height;
+
+        node_base * find_minimum() {
+            node_base * minimum = this;
+            while (minimum->left != nullptr) {
+                minimum = minimum->left;
+            }
+            return minimum;
+        }
+
+        node_base * find_maximum() {
+            node_base * maximum = this;
+            while (maximum->right != nullptr) {
+                maximum = maximum->right;
+            }
+            return maximum;
+        }
+    };
+
+    struct node : node_base {
+        value_type data;
+        V total;
+
+        node(const value_type & a_data, node_base * a_parent, int a_height, const V & a_total)
+            : data(a_data), total(a_total) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+            this->height = a_height;
+        }
+    };
+
+    static value_type & data_of(node_base * n) {
+        return static_cast<node *>(n)->data;
+    }
+
+    static const value_type & data_of(const node_base * n) {
+        return static_cast<const node *>(n)->data;
+    }
+
+    // La raíz cuelga a la izquierda de m_header, que hace de padre de la raíz
+    // y de end() como en avl_map.h. Como la cabecera no tiene par, K y V no
+    // necesitan poder construirse por defecto (V sólo si no se da el neutro).
+    node_base m_header;
+    V m_identity;
+    Combine m_combine;
+    Compare m_cmp;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    explicit aggregate_map(const V & identity = V(), const Combine & combine = Combine(),
+                           const Compare & cmp = Compare())
+        : m_identity(identity), m_combine(combine), m_cmp(cmp) {
+        init_header();
+    }
+
+    aggregate_map(const aggregate_map & x)
+        : m_identity(x.m_identity), m_combine(x.m_combine), m_cmp(x.m_cmp) {
+        init_header();
+        copy_nodes(x.m_header.left);
+    }
+
+    ~aggregate_map() {
+        clear();
+    }
+
+    aggregate_map & operator=(aggregate_map x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(aggregate_map & x, aggregate_map & y) {
+        using namespace std;
+        node_base * root = x.m_header.left;
+        x.set_root(y.m_header.left);
+        y.set_root(root);
+        swap(x.m_identity, y.m_identity);
+        swap(x.m_combine, y.m_combine);
+        swap(x.m_cmp, y.m_cmp);
+    }
+
+    /************************************************************************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        node_base * m_current;
+
+        friend class aggregate_map;
+
+    public:
+        using value_type = aggregate_map::value_type;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(node_base * current = nullptr) {
+            m_current = current;
+        }
+
+        reference operator*() {
+            // Precondición: m_current != end()
+            return data_of(m_current);
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        // Al subir desde el máximo se llega a la cabecera, que es end()
+        iterator & operator++() {
+            // Precondición: m_current != end()
+            if (m_current->right != nullptr) {
+                m_current = m_current->right->find_minimum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->right == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        // Desde end() baja al máximo, porque la raíz es el hijo izquierdo
+        // de la cabecera.
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        return iterator(m_header.find_minimum());
+    }
+
+    iterator end() {
+        return iterator(&m_header);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_header.left == nullptr;
+    }
+
+    friend
+    bool operator==(aggregate_map & x, aggregate_map & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(aggregate_map & x, aggregate_map & y) {
+        return !(x == y);
+    }
+
+    iterator find(const K & key) {
+        return make_iterator(find_node(key));
+    }
+
+    bool contains(const K & key) {
+        return find_node(key) != nullptr;
+    }
+
+    // Devuelve el primer elemento cuya clave no es menor a key
+    iterator lower_bound(const K & key) {
+        return make_iterator(find_bound(key, false));
+    }
+
+    // Devuelve el primer elemento cuya clave es mayor a key
+    iterator upper_bound(const K & key) {
+        return make_iterator(find_bound(key, true));
+    }
+
+    iterator minimum() {
+        return begin();
+    }
+
+    iterator maximum() {
+        if (empty())
+            return end();
+        return iterator(m_header.left->find_maximum());
+    }
+
+    // Combinación de todos los valores del mapa, en O(1)
+    V aggregate() const {
+        return total(m_header.left);
+    }
+
+    // Combinación de los valores cuyas claves están en [low, high], en
+    // O(log n). Baja hasta el primer nodo dentro del rango (donde se separan
+    // los caminos a low y a high) y desde ahí junta los totales de los
+    // subárboles que quedan enteros dentro del rango: los de la derecha del
+    // camino a low y los de la izquierda del camino a high.
+    V aggregate(const K & low, const K & high) const {
+        const node_base * split = m_header.left;
+        while (split != nullptr) {
+            if (m_cmp(data_of(split).first, low)) {
+                split = split->right;
+            } else if (m_cmp(high, data_of(split).first)) {
+                split = split->left;
+            } else {
+                break;
+            }
+        }
+        if (split == nullptr) {
+            return m_identity;
+        }
+
+        // Valores no menores a low del subárbol izquierdo. Lo que se junta
+        // al bajar a la izquierda queda a la derecha de lo ya juntado.
+        V left_part = m_identity;
+        for (const node_base * current = split->left; current != nullptr; ) {
+            if (m_cmp(data_of(current).first, low)) {
+                current = current->right;
+            } else {
+                left_part = m_combine(m_combine(data_of(current).second, total(current->right)), left_part);
+                current = current->left;
+            }
+        }
+
+        // Valores no mayores a high del subárbol derecho, en espejo
+        V right_part = m_identity;
+        for (const node_base * current = split->right; current != nullptr; ) {
+            if (m_cmp(high, data_of(current).first)) {
+                current = current->left;
+            } else {
+                right_part = m_combine(right_part, m_combine(total(current->left), data_of(current).second));
+                current = current->right;
+            }
+        }
+
+        return m_combine(m_combine(left_part, data_of(split).second), right_part);
+    }
+
+    // func recibe el valor como referencia constante: cambiarlo obligaría a
+    // recalcular los totales de todos sus ancestros.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](node_base * n) {
+            func(data_of(n).first, static_cast<const V &>(data_of(n).second));
+            return true;
+        });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](node_base * n) {
+            return bool(func(data_of(n).first, static_cast<const V &>(data_of(n).second)));
+        });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    iterator insert(const K & key, const V & value) {
+        return insert_or_assign(key, value).first;
+    }
+
+    // Agrega el par o, si la clave ya estaba, cambia su valor y recalcula
+    // los totales de sus ancestros. Devuelve además si la clave fue agregada
+    // (true) o si ya estaba (false).
+    std::pair<iterator, bool> insert_or_assign(const K & key, const V & value) {
+        node_base * parent;
+        node_base ** ptr = find_link(key, parent);
+        if (*ptr != nullptr) {
+            data_of(*ptr).second = value;
+            update_totals_from(*ptr);
+            return { iterator(*ptr), false };
+        }
+        node_base * inserted = new node(value_type(key, value), parent, 1, value);
+        *ptr = inserted;
+        rebalance_from(parent);
+        return { iterator(inserted), true };
+    }
+
+    std::pair<bool, iterator> erase(const K & key) {
+        node_base * current = find_node(key);
+        if (current == nullptr) {
+            return { false, end() };
+        }
+        iterator next = ++iterator(current);
+        erase_node(current);
+        return { true, next };
+    }
+
+    void clear() {
+        do_clear(m_header.left);
+        m_header.left = nullptr;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Los recorridos usan una pila de tamaño fijo en lugar de recursión,
+    // como en avl_map.h.
+
+    static const int max_height = 64;
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        while (current != nullptr || size > 0) {
+            while (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            }
+            current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    const V & total(const node_base * a_node) const {
+        return a_node != nullptr ? static_cast<const node *>(a_node)->total : m_identity;
+    }
+
+    // Recalcula la altura y el total de n a partir de sus hijos, que tienen
+    // que estar al día
+    void update(node_base * n) {
+        int left_height = n->left != nullptr ? n->left->height : 0;
+        int right_height = n->right != nullptr ? n->right->height : 0;
+        n->height = 1 + std::max(left_height, right_height);
+        static_cast<node *>(n)->total = m_combine(m_combine(total(n->left), data_of(n).second), total(n->right));
+    }
+
+    // Copia los nodos de other sin recursión ni pila: avanza en pre-orden
+    // sobre ambos árboles a la vez, subiendo por los enlaces a los padres.
+    void copy_nodes(const node_base * other) {
+        if (other == nullptr) {
+            return;
+        }
+        const node_base * other_root = other;
+        set_root(new node(data_of(other), nullptr, other->height, total(other)));
+        node_base * current = m_header.left;
+        while (true) {
+            if (other->left != nullptr && current->left == nullptr) {
+                other = other->left;
+                current->left = new node(data_of(other), current, other->height, total(other));
+                current = current->left;
+            } else if (other->right != nullptr && current->right == nullptr) {
+                other = other->right;
+                current->right = new node(data_of(other), current, other->height, total(other));
+                current = current->right;
+            } else if (other != other_root) {
+                other = other->parent;
+                current = current->parent;
+            } else {
+                break;
+            }
+        }
+    }
+
+    void init_header() {
+        m_header.left = m_header.right = m_header.parent = nullptr;
+        m_header.height = 0;
+    }
+
+    void set_root(node_base * root) {
+        m_header.left = root;
+        assign_parent(m_header.left, &m_header);
+    }
+
+    // Los nodos que no se encuentran se representan con end()
+    iterator make_iterator(node_base * a_node) {
+        return iterator(a_node == nullptr ? &m_header : a_node);
+    }
+
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de la
+    // cabecera)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    // Sube desde current hasta la raíz actualizando alturas y totales y
+    // rotando donde haga falta. A diferencia de avl_map.h no se puede cortar
+    // cuando la altura de un subárbol no cambia, porque su total sí cambió.
+    void rebalance_from(node_base * current) {
+        while (current != &m_header) {
+            node_base * & link = link_to(current);
+            balance_tree(link);
+            current = link->parent;
+        }
+    }
+
+    // Como rebalance_from, pero cuando sólo cambió un valor y la forma del
+    // árbol sigue igual
+    void update_totals_from(node_base * current) {
+        while (current != &m_header) {
+            update(current);
+            current = current->parent;
+        }
+    }
+
+    node_base * find_node(const K & key) {
+        node_base * current = m_header.left;
+        while (current != nullptr) {
+            if (m_cmp(key, data_of(current).first)) {
+                current = current->left;
+            } else if (m_cmp(data_of(current).first, key)) {
+                current = current->right;
+            } else {
+                return current;
+            }
+        }
+        return nullptr;
+    }
+
+    // Busca el primer nodo con clave mayor a key (si strict) o no menor a key
+    node_base * find_bound(const K & key, bool strict) {
+        node_base * current = m_header.left;
+        node_base * result = nullptr;
+        while (current != nullptr) {
+            bool goes_left = strict ? m_cmp(key, data_of(current).first)
+                                    : !m_cmp(data_of(current).first, key);
+            if (goes_left) {
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return result;
+    }
+
+    // Devuelve el enlace donde está (o debería estar) key y deja en parent
+    // al nodo del que cuelga ese enlace.
+    node_base ** find_link(const K & key, node_base * & parent) {
+        node_base ** ptr = &m_header.left;
+        parent = &m_header;
+        while (*ptr != nullptr) {
+            if (m_cmp(key, data_of(*ptr).first)) {
+                parent = *ptr;
+                ptr = &parent->left;
+            } else if (m_cmp(data_of(*ptr).first, key)) {
+                parent = *ptr;
+                ptr = &parent->right;
+            } else {
+                break;
+            }
+        }
+        return ptr;
+    }
+
+    void balance_tree(node_base * & root) {
+        int bf = balance_factor(root);
+        if (bf == 2) {
+            if (balance_factor(root->left) == -1) {
+                rotate_left(root->left);
+            }
+            rotate_right(root);
+        } else if (bf == -2) {
+            if (balance_factor(root->right) == 1) {
+                rotate_right(root->right);
+            }
+            rotate_left(root);
+        } else {
+            update(root);
+        }
+    }
+
+    int balance_factor(const node_base * a_node) {
+        int result = 0;
+        if (a_node != nullptr) {
+            if (a_node->left != nullptr) {
+                result = a_node->left->height;
+            }
+            if (a_node->right != nullptr) {
+                result -= a_node->right->height;
+            }
+        }
+        return result;
+    }
+
+    void assign_parent(node_base * & n, node_base * p) {
+        if (n != nullptr) {
+            n->parent = p;
+        }
+    }
+
+    // Las rotaciones sólo cambian los hijos de los dos nodos que giran, así
+    // que basta con recalcular sus totales (primero el que queda abajo)
+    void rotate_left(node_base * & root) {
+        node_base * right_tree = root->right;
+        root->right = right_tree->left;
+        assign_parent(root->right, root);
+        right_tree->left = root;
+        right_tree->parent = root->parent;
+        root->parent = right_tree;
+        root = right_tree;
+        update(root->left);
+        update(root);
+    }
+
+    void rotate_right(node_base * & root) {
+        node_base * left_tree = root->left;
+        root->left = left_tree->right;
+        assign_parent(root->left, root);
+        left_tree->right = root;
+        left_tree->parent = root->parent;
+        root->parent = left_tree;
+        root = left_tree;
+        update(root->right);
+        update(root);
+    }
+
+    // Desengancha y libera a n y rebalancea
+    void erase_node(node_base * n) {
+        node_base * rebalance_start;
+        if (n->left != nullptr && n->right != nullptr) {
+            // Pone en el lugar de n a su predecesor (el máximo del subárbol
+            // izquierdo), desenganchándolo antes de su posición original.
+            // Su total se recalcula al pasar rebalance_from por él.
+            node_base * max = n->left->find_maximum();
+            rebalance_start = max->parent == n ? max : max->parent;
+            link_to(max) = max->left;
+            assign_parent(max->left, max->parent);
+            max->left = n->left;
+            max->right = n->right;
+            assign_parent(max->left, max);
+            assign_parent(max->right, max);
+            max->parent = n->parent;
+            max->height = n->height;
+            link_to(n) = max;
+        } else {
+            node_base * child = n->left != nullptr ? n->left : n->right;
+            rebalance_start = n->parent;
+            link_to(n) = child;
+            assign_parent(child, n->parent);
+        }
+        rebalance_from(rebalance_start);
+        delete static_cast<node *>(n);
+    }
+
+    // Borra los nodos sin recursión ni pila: baja hasta una hoja, la borra y
+    // vuelve a su padre, que eventualmente se convierte también en hoja.
+    void do_clear(node_base * current) {
+        assign_parent(current, nullptr);
+        while (current != nullptr) {
+            if (current->left != nullptr) {
+                current = current->left;
+            } else if (current->right != nullptr) {
+                current = current->right;
+            } else {
+                node_base * parent = current->parent;
+                if (parent != nullptr) {
+                    if (parent->left == current) {
+                        parent->left = nullptr;
+                    } else {
+                        parent->right = nullptr;
+                    }
+                }
+                delete static_cast<node *>(current);
+                current = parent;
+            }
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
+        if (current != nullptr) {
+            calculate_nodes_placement(current->left, x, h+1, placements);
+            placements.emplace_back(h, x++, current);
+            calculate_nodes_placement(current->right, x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando
+    // caracteres ASCII. Cada nodo se muestra como clave:total.
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_header.left, count, 0, placements);
+
+        const int node_value_size = 7;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node_base * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            std::ostringstream label;
+            label << data_of(the_node).first << ':' << total(the_node);
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << label.str();
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // AGGREGATE_MAP_H
@@ -0,0 +1,133 @@
+#include "aggregate_map.h"
+#include "../avl-as-map/avl_map.h"
+#include "../benchmark/measure.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename K, typename V, typename F, typename C>
+ostream & operator<<(ostream & out, aggregate_map<K, V, F, C> & t) {
+    out << "aggregate_map { ";
+    for (const auto & x : t) {
+        out << x.first << ":" << x.second << " ";
+    }
+    out << "}" << endl << t.str();
+    return out;
+}
+
+int main() {
+    cout << ":: Ventas por día en t1 (cada nodo muestra clave:total de su subárbol):" << endl;
+    aggregate_map<int, int> t1;
+    aggregate_map<int, int, max_of> t2(INT_MIN);
+    for (int day = 1; day <= 12; ++day) {
+        int sales = (day * 37) % 23;
+        t1.insert(day, sales);
+        t2.insert(day, sales);
+    }
+    cout << "  t1 = " << t1 << endl;
+
+    for (auto range : {make_pair(1, 12), make_pair(3, 7), make_pair(8, 8), make_pair(13, 20)}) {
+        cout << ":: Días [" << range.first << ", " << range.second << "]: suma "
+             << t1.aggregate(range.first, range.second) << ", máximo "
+             << t2.aggregate(range.first, range.second) << endl;
+    }
+
+    cout << ":: Cambiando las ventas del día 5 a 100 y borrando el día 6:" << endl;
+    t1.insert_or_assign(5, 100);
+    t2.insert_or_assign(5, 100);
+    t1.erase(6);
+    t2.erase(6);
+    cout << "  t1 = " << t1 << endl;
+    cout << ":: Días [3, 7]: suma " << t1.aggregate(3, 7) << ", máximo " << t2.aggregate(3, 7) << endl;
+
+    cout << ":: Concatenando palabras (la combinación no tiene que ser conmutativa):" << endl;
+    aggregate_map<int, string> t3;
+    int position = 0;
+    for (const char * word : {"los ", "treaps ", "y ", "los ", "AVL ", "son ", "árboles"}) {
+        t3.insert(position += 10, word);
+    }
+    cout << "  t3.aggregate() = \"" << t3.aggregate() << "\"" << endl;
+    cout << "  t3.aggregate(25, 55) = \"" << t3.aggregate(25, 55) << "\"" << endl << endl;
+
+    const int n = 1000000;
+    const int queries = 200000;
+    const int width = n / 100;
+    cout << ":: Sumas de rangos de " << width << " claves consecutivas en un mapa de " << n << " pares:" << endl;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    for (int i = 0; i < n; ++i) {
+        keys[i] = i;
+    }
+    shuffle(keys.begin(), keys.end(), rng);
+    vector<long> values(n);
+    for (auto & value : values) {
+        value = long(rng() % 1000);
+    }
+
+    aggregate_map<int, long> augmented;
+    tree<int, long> plain;
+    double augmented_insert = measure([&] {
+        for (int key : keys) {
+            augmented.insert(key, values[key]);
+        }
+    });
+    double plain_insert = measure([&] {
+        for (int key : keys) {
+            plain.insert(key, values[key]);
+        }
+    });
+    cout << "  insertando: mapa con agregados " << augmented_insert << " s, avl_map " << plain_insert << " s" << endl;
+
+    vector<int> lows(queries);
+    for (auto & low : lows) {
+        low = int(rng() % (n - width));
+    }
+    long augmented_sum = 0;
+    long range_sum = 0;
+    long each_sum = 0;
+    double augmented_time = measure([&] {
+        for (int low : lows) {
+            augmented_sum += augmented.aggregate(low, low + width - 1);
+        }
+    });
+    const int range_queries = 2000;
+    long range_check = 0;
+    double range_time = measure([&] {
+        for (int i = 0; i < range_queries; ++i) {
+            int low = lows[i];
+            for (auto p = plain.lower_bound(low); p != plain.end() && p->first < low + width; ++p) {
+                range_sum += p->second;
+            }
+        }
+    });
+    const int each_queries = 100;
+    long each_check = 0;
+    double each_time = measure([&] {
+        for (int i = 0; i < each_queries; ++i) {
+            int low = lows[i];
+            plain.each([&](int key, long value) {
+                if (low <= key && key < low + width) {
+                    each_sum += value;
+                }
+            });
+        }
+    });
+    for (int i = 0; i < range_queries; ++i) {
+        range_check += augmented.aggregate(lows[i], lows[i] + width - 1);
+        if (i < each_queries) {
+            each_check += augmented.aggregate(lows[i], lows[i] + width - 1);
+        }
+    }
+    cout << "  aggregate: " << augmented_time / queries * 1e6 << " µs por consulta (" << queries
+         << " consultas, suman " << augmented_sum << ")" << endl;
+    cout << "  avl_map con lower_bound y el iterador: " << range_time / range_queries * 1e6 << " µs por consulta"
+         << " - ¿mismos resultados? " << boolalpha << (range_sum == range_check) << endl;
+    cout << "  avl_map con each: " << each_time / each_queries * 1e6 << " µs por consulta"
+         << " - ¿mismos resultados? " << (each_sum == each_check) << endl;
+}
@@ -3,9 +3,10 @@
 
 #include <algorithm>  // Para std::max
 #include <cstddef>    // Para std::size_t
-#include <functional> // Para std::function
-#include <iterator>   // Para std::forward_iterator_tag
-#include <utility>    // Para std::pair y std::swap
+#include <functional> // Para std::less
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <tuple>      // Para std::forward_as_tuple
+#include <utility>    // Para std::pair, std::swap, std::forward, std::move y std::piecewise_construct
 
 /************************************************************************************/
 /*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
@@ -15,34 +16,39 @@
 #include <iostream>
 #include <sstream>
 #include <string>
-#include <tuple>
 #include <vector>
 
 /************************************************************************************/
 /**** Árbol AVL balanceado con iterador liviano funcionando como mapa asociativo ****/
 /************************************************************************************/
 
-template <typename K, typename V>
+// El comparador define el orden de las claves. Si es transparente (como
+// std::less<>, que define is_transparent), find, contains y las cotas pueden
+// recibir cualquier tipo comparable con K sin tener que construir una clave.
+template <typename K, typename V, typename Compare = std::less<K>>
 class tree {
     using value_type = std::pair<const K, V>;
 
-    struct node {
-        value_type data;
-        node * left;
-        node * right;
-        node * parent;
+    // Como en avl.h, la cabecera tiene sólo los enlaces y los elementos son
+    // node, que agrega el par. La clave del par no es constante para que un
+    // node_handle pueda cambiarla; mientras el nodo está en el árbol, los
+    // iteradores sólo la dan como referencia constante.
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
         int height;
 
-        node * find_minimum() {
-            node * minimum = this;
+        node_base * find_minimum() {
+            node_base * minimum = this;
             while (minimum->left != nullptr) {
                 minimum = minimum->left;
             }
             return minimum;
         }
 
-        node * find_maximum() {
-            node * maximum = this;
+        node_base * find_maximum() {
+            node_base * maximum = this;
             while (maximum->right != nullptr) {
                 maximum = maximum->right;
             }
@@ -62,7 +68,31 @@ class tree {
         }
     };
 
-    node * m_root;
+    struct node : node_base {
+        std::pair<K, V> data;
+
+        template <typename... Args>
+        node(node_base * a_parent, int a_height, Args &&... args) : data(std::forward<Args>(args)...) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+            this->height = a_height;
+        }
+    };
+
+    static std::pair<K, V> & data_of(node_base * n) {
+        return static_cast<node *>(n)->data;
+    }
+
+    static const std::pair<K, V> & data_of(const node_base * n) {
+        return static_cast<const node *>(n)->data;
+    }
+
+    // La raíz cuelga a la izquierda de m_header, un nodo cabecera que hace
+    // de padre de la raíz y de posición final de los iteradores, así que se
+    // puede retroceder desde end(). Como la cabecera no tiene par, K y V no
+    // necesitan poder construirse por defecto.
+    node_base m_header;
+    Compare m_cmp;
 
 public:
 
@@ -71,12 +101,26 @@ public:
     /************************************************************************/
 
     tree() {
-        m_root = nullptr;
+        init_header();
     }
 
-    tree(const tree & x) {
-        m_root = nullptr;
-        copy_nodes(x.m_root, m_root, nullptr);
+    explicit tree(const Compare & cmp) : m_cmp(cmp) {
+        init_header();
+    }
+
+    tree(const tree & x) : m_cmp(x.m_cmp) {
+        init_header();
+        copy_nodes(x.m_header.left);
+    }
+
+    // Carga masiva en O(n): [first, last) tiene que estar ordenado por clave
+    // y sin claves repetidas, y cada elemento tiene que tener first y second
+    // (un std::pair, por ejemplo). Arma directamente un árbol perfectamente
+    // balanceado, sin comparar claves ni rotar.
+    template <typename RandomIt>
+    tree(RandomIt first, RandomIt last, const Compare & cmp = Compare()) : m_cmp(cmp) {
+        init_header();
+        set_root(build_sorted(first, last - first));
     }
 
     ~tree() {
@@ -91,35 +135,54 @@ public:
     friend
     void swap(tree & x, tree & y) {
         using namespace std;
-        swap(x.m_root, y.m_root);
+        node_base * root = x.m_header.left;
+        x.set_root(y.m_header.left);
+        y.set_root(root);
+        swap(x.m_cmp, y.m_cmp);
     }
 
     /************************************************************************/
-    /************ ITERADOR LIVIANO QUE RECORRE AL ÁRBOL EN ORDEN ************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
     /************************************************************************/
 
     class iterator {
     private:
-        node * m_current;
+        node_base * m_current;
+
+        friend class tree;
 
     public:
         using value_type = tree::value_type;
-        using pointer = value_type *;
-        using reference = value_type &;
+        using reference = std::pair<const K &, V &>;
         using difference_type = std::size_t;
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        // El nodo no guarda un value_type al que apuntar, así que, como en
+        // flat_map, operator-> devuelve un objeto con el par de referencias.
+        class pointer {
+        private:
+            reference m_reference;
 
-        iterator(node * current = nullptr) {
+        public:
+            pointer(reference r) : m_reference(r) {
+            }
+
+            reference * operator->() {
+                return &m_reference;
+            }
+        };
+
+        iterator(node_base * current = nullptr) {
             m_current = current;
         }
 
         reference operator*() {
-            // Precondición: m_current != nullptr
-            return m_current->data;
+            // Precondición: m_current != end()
+            return { data_of(m_current).first, data_of(m_current).second };
         }
 
         pointer operator->() {
-            return &operator*();
+            return pointer(operator*());
         }
 
         friend
@@ -132,16 +195,17 @@ public:
             return !(x == y);
         }
 
+        // Al subir desde el máximo se llega a la cabecera, que es end()
         iterator & operator++() {
-            // Precondición: m_current != nullptr
+            // Precondición: m_current != end()
             if (m_current->right != nullptr) {
                 m_current = m_current->right->find_minimum();
             } else {
-                node * prev;
+                node_base * prev;
                 do {
                     prev = m_current;
                     m_current = m_current->parent;
-                } while (m_current != nullptr and m_current->right == prev);
+                } while (m_current->right == prev);
             }
             return *this;
         }
@@ -151,16 +215,46 @@ public:
             operator++();
             return tmp;
         }
+
+        // Desde end() baja al máximo, porque la raíz es el hijo izquierdo
+        // de la cabecera.
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
     };
 
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
     iterator begin() {
-        if (empty())
-            return end();
-        return iterator(m_root->find_minimum());
+        return iterator(m_header.find_minimum());
     }
 
     iterator end() {
-        return iterator(nullptr);
+        return iterator(&m_header);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
     }
 
     /************************************************************************/
@@ -168,7 +262,7 @@ public:
     /************************************************************************/
 
     bool empty() {
-        return m_root == nullptr;
+        return m_header.left == nullptr;
     }
 
     friend
@@ -190,58 +284,258 @@ public:
     }
 
     iterator find(const K & key) {
-        node * current = m_root;
-        while (current != nullptr) {
-            if (key < current->data.first) {
-                current = current->left;
-            } else if (key > current->data.first) {
-                current = current->right;
-            } else {
-                return iterator(current);
-            }
-        }
-        return end();
+        return make_iterator(find_node(key));
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const Key & key) {
+        return make_iterator(find_node(key));
     }
 
     bool contains(const K & key) {
-        return find(key) != end();
+        return find_node(key) != nullptr;
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const Key & key) {
+        return find_node(key) != nullptr;
+    }
+
+    // Devuelve el primer elemento cuya clave no es menor a key
+    iterator lower_bound(const K & key) {
+        return make_iterator(find_bound(key, false));
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const Key & key) {
+        return make_iterator(find_bound(key, false));
+    }
+
+    // Devuelve el primer elemento cuya clave es mayor a key
+    iterator upper_bound(const K & key) {
+        return make_iterator(find_bound(key, true));
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const Key & key) {
+        return make_iterator(find_bound(key, true));
     }
 
     iterator minimum() {
-        if (m_root == nullptr)
-            return end();
-        return iterator(m_root->find_minimum());
+        return begin();
     }
 
     iterator maximum() {
-        if (m_root == nullptr)
+        if (empty())
             return end();
-        return iterator(m_root->find_maximum());
+        return iterator(m_header.left->find_maximum());
     }
 
-    void each(std::function<void(const K &, V &)> func) {
-        do_each(m_root, func);
+    // func recibe la clave como referencia constante y el valor como
+    // referencia modificable, igual que al recorrer con iteradores.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](node_base * n) { func(data_of(n).first, data_of(n).second); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](node_base * n) { return bool(func(data_of(n).first, data_of(n).second)); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](node_base * n) { func(data_of(n).first, data_of(n).second); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](node_base * n) { func(data_of(n).first, data_of(n).second); return true; });
     }
 
     /************************************************************************/
     /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
     /************************************************************************/
 
+    // Si la clave ya estaba, insert reemplaza el valor asociado.
+
     iterator insert(const K & key, const V & value) {
-        return do_insert(m_root, nullptr, key, value);
+        return insert_or_assign(key, value).first;
     }
 
-    std::pair<bool, iterator> erase(const K & key) {
-        auto result = do_erase(m_root, key);
-        if (result.first && !empty()) {
-            m_root->update_height();
+    iterator insert(K && key, V && value) {
+        return insert_or_assign(std::move(key), std::move(value)).first;
+    }
+
+    // Tanto insert_or_assign como try_emplace construyen el par directamente
+    // dentro del nodo. Devuelven además si la clave fue agregada (true) o si
+    // ya estaba (false).
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K & key, M && value) {
+        auto result = do_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(K && key, M && value) {
+        auto result = do_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
         }
         return result;
     }
 
+    // Si la clave ya estaba, try_emplace no hace nada (ni siquiera consume
+    // los argumentos); si no, construye el valor con args.
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K & key, Args &&... args) {
+        return do_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K && key, Args &&... args) {
+        return do_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Devuelve el valor asociado a key, agregándolo (construido por defecto)
+    // si la clave no estaba.
+
+    V & operator[](const K & key) {
+        return try_emplace(key).first->second;
+    }
+
+    V & operator[](K && key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    std::pair<bool, iterator> erase(const K & key) {
+        node_base * current = find_node(key);
+        if (current == nullptr) {
+            return { false, end() };
+        }
+        iterator next = ++iterator(current);
+        erase_node(current);
+        return { true, next };
+    }
+
     void clear() {
-        do_clear(m_root);
-        m_root = nullptr;
+        do_clear(m_header.left);
+        m_header.left = nullptr;
+    }
+
+    /************************************************************************/
+    /********** NODOS SUELTOS: EXTRAER, REINSERTAR Y MEZCLAR ÁRBOLES ********/
+    /************************************************************************/
+
+    // Un node_handle es dueño de un nodo que se sacó del árbol con extract.
+    // Permite cambiar la clave o el valor y volver a insertar el nodo (en
+    // éste o en otro árbol) sin liberar ni pedir memoria. Si se destruye sin
+    // reinsertarlo, libera el nodo.
+    class node_handle {
+    private:
+        node * m_node;
+
+        friend class tree;
+
+        explicit node_handle(node * a_node) {
+            m_node = a_node;
+        }
+
+    public:
+        node_handle() {
+            m_node = nullptr;
+        }
+
+        node_handle(node_handle && x) {
+            m_node = x.m_node;
+            x.m_node = nullptr;
+        }
+
+        node_handle & operator=(node_handle && x) {
+            if (this != &x) {
+                delete m_node;
+                m_node = x.m_node;
+                x.m_node = nullptr;
+            }
+            return *this;
+        }
+
+        ~node_handle() {
+            delete m_node;
+        }
+
+        bool empty() const {
+            return m_node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return !empty();
+        }
+
+        // Mientras el nodo está suelto la clave no ordena nada, así que se
+        // puede modificar
+        K & key() {
+            // Precondición: !empty()
+            return m_node->data.first;
+        }
+
+        V & mapped() {
+            // Precondición: !empty()
+            return m_node->data.second;
+        }
+    };
+
+    // Devuelve un node_handle vacío si key no está en el árbol
+    node_handle extract(const K & key) {
+        node_base * current = find_node(key);
+        if (current == nullptr) {
+            return node_handle();
+        }
+        unlink_node(current);
+        return node_handle(static_cast<node *>(current));
+    }
+
+    node_handle extract(iterator position) {
+        // Precondición: position != end()
+        unlink_node(position.m_current);
+        return node_handle(static_cast<node *>(position.m_current));
+    }
+
+    // Si la clave ya estaba, el nodo queda en handle y devuelve la posición
+    // del elemento que ya estaba junto con false.
+    std::pair<iterator, bool> insert(node_handle && handle) {
+        if (handle.empty()) {
+            return { end(), false };
+        }
+        auto result = insert_node(handle.m_node);
+        if (result.second) {
+            handle.m_node = nullptr;
+        }
+        return result;
+    }
+
+    // Pasa a este árbol los nodos de other cuyas claves no están en éste
+    // (los demás quedan en other) sin liberar ni pedir memoria.
+    void merge(tree & other) {
+        if (&other == this) {
+            return;
+        }
+        node_base * pending = other.m_header.left;
+        other.m_header.left = nullptr;
+        while (pending != nullptr) {
+            node_base * n = detach_preorder_first(pending);
+            if (!insert_node(n).second) {
+                other.insert_node(n);
+            }
+        }
     }
 
 private:
@@ -250,44 +544,270 @@ private:
     /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
     /************************************************************************/
 
-    void copy_nodes(const node * other_node, node * & this_node, node * parent) {
-        if (other_node != nullptr) {
-            this_node = new node { other_node->data, nullptr, nullptr, parent, other_node->height };
-            copy_nodes(other_node->left, this_node->left, this_node);
-            copy_nodes(other_node->right, this_node->right, this_node);
+    // Los recorridos usan una pila de tamaño fijo en lugar de recursión: la
+    // altura de un árbol AVL con n nodos es menor a 1.45 * log2(n + 2), así
+    // que max_height niveles alcanzan para cualquier árbol que entre en
+    // memoria. visit recibe cada nodo y devuelve false para interrumpir el
+    // recorrido.
+
+    static const int max_height = 64;
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        while (current != nullptr || size > 0) {
+            while (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            }
+            current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
         }
+        return true;
     }
 
-    void do_each(node * current, std::function<void(const K &, V &)> func) {
-        if (current != nullptr) {
-            do_each(current->left, func);
-            func(current->data.first, current->data.second);
-            do_each(current->right, func);
+    template <typename F>
+    bool visit_preorder(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        if (m_header.left != nullptr) {
+            pending[size++] = m_header.left;
         }
+        while (size > 0) {
+            node_base * current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending[size++] = current->right;
+            }
+            if (current->left != nullptr) {
+                pending[size++] = current->left;
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        node_base * last = nullptr;
+        while (current != nullptr || size > 0) {
+            if (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            } else {
+                node_base * top = pending[size - 1];
+                if (top->right != nullptr && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    --size;
+                }
+            }
+        }
+        return true;
     }
 
-    iterator do_insert(node * & current, node * parent, const K & key, const V & value) {
-        if (current == nullptr) {
-            current = new node { { key, value }, nullptr, nullptr, parent, 1 };
-            return iterator(current);
+    // Copia los nodos de other sin recursión ni pila: avanza en pre-orden
+    // sobre ambos árboles a la vez, subiendo por los enlaces a los padres.
+    void copy_nodes(const node_base * other) {
+        if (other == nullptr) {
+            return;
         }
+        const node_base * other_root = other;
+        set_root(new node(nullptr, other->height, data_of(other)));
+        node_base * current = m_header.left;
+        while (true) {
+            if (other->left != nullptr && current->left == nullptr) {
+                other = other->left;
+                current->left = new node(current, other->height, data_of(other));
+                current = current->left;
+            } else if (other->right != nullptr && current->right == nullptr) {
+                other = other->right;
+                current->right = new node(current, other->height, data_of(other));
+                current = current->right;
+            } else if (other != other_root) {
+                other = other->parent;
+                current = current->parent;
+            } else {
+                break;
+            }
+        }
+    }
 
-        if (key == current->data.first) {
-            current->data.second = value;
-            return iterator(current);
+    // Arma un árbol perfectamente balanceado con los count elementos a
+    // partir de first. Pide los nodos en orden (el subárbol izquierdo antes
+    // que la raíz), así que los que quedan contiguos en memoria también lo
+    // están en el recorrido. La recursión tiene profundidad log2(n).
+    template <typename RandomIt>
+    node_base * build_sorted(RandomIt first, std::size_t count) {
+        if (count == 0) {
+            return nullptr;
         }
+        std::size_t middle = count / 2;
+        node_base * left = build_sorted(first, middle);
+        auto && element = *(first + middle);
+        node_base * root = new node(nullptr, 1, element.first, element.second);
+        root->left = left;
+        root->right = build_sorted(first + middle + 1, count - middle - 1);
+        assign_parent(root->left, root);
+        assign_parent(root->right, root);
+        root->update_height();
+        return root;
+    }
 
-        iterator result;
-        if (key < current->data.first) {
-            result = do_insert(current->left, current, key, value);
-        } else {
-            result = do_insert(current->right, current, key, value);
+    void init_header() {
+        m_header.left = m_header.right = m_header.parent = nullptr;
+        m_header.height = 0;
+    }
+
+    void set_root(node_base * root) {
+        m_header.left = root;
+        assign_parent(m_header.left, &m_header);
+    }
+
+    // Los nodos que no se encuentran se representan con end()
+    iterator make_iterator(node_base * a_node) {
+        return iterator(a_node == nullptr ? &m_header : a_node);
+    }
+
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de la
+    // cabecera)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    // Sube desde current hasta la raíz actualizando las alturas y rotando
+    // donde haga falta. Se detiene en cuanto un subárbol conserva la altura
+    // que tenía, porque entonces nada cambia más arriba.
+    void rebalance_from(node_base * current) {
+        while (current != &m_header) {
+            int old_height = current->height;
+            node_base * & link = link_to(current);
+            balance_tree(link);
+            if (link->height == old_height) {
+                break;
+            }
+            current = link->parent;
+        }
+    }
+
+    template <typename Key>
+    node_base * find_node(const Key & key) {
+        node_base * current = m_header.left;
+        while (current != nullptr) {
+            if (m_cmp(key, data_of(current).first)) {
+                current = current->left;
+            } else if (m_cmp(data_of(current).first, key)) {
+                current = current->right;
+            } else {
+                return current;
+            }
+        }
+        return nullptr;
+    }
+
+    // Busca el primer nodo con clave mayor a key (si strict) o no menor a key
+    template <typename Key>
+    node_base * find_bound(const Key & key, bool strict) {
+        node_base * current = m_header.left;
+        node_base * result = nullptr;
+        while (current != nullptr) {
+            bool goes_left = strict ? m_cmp(key, data_of(current).first)
+                                    : !m_cmp(data_of(current).first, key);
+            if (goes_left) {
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
         }
-        balance_tree(current);
         return result;
     }
 
-    void balance_tree(node * & root) {
+    // Devuelve el enlace donde está (o debería estar) key y deja en parent
+    // al nodo del que cuelga ese enlace.
+    template <typename Key>
+    node_base ** find_link(const Key & key, node_base * & parent) {
+        node_base ** ptr = &m_header.left;
+        parent = &m_header;
+        while (*ptr != nullptr) {
+            if (m_cmp(key, data_of(*ptr).first)) {
+                parent = *ptr;
+                ptr = &parent->left;
+            } else if (m_cmp(data_of(*ptr).first, key)) {
+                parent = *ptr;
+                ptr = &parent->right;
+            } else {
+                break;
+            }
+        }
+        return ptr;
+    }
+
+    // Saca la raíz de pending, un árbol de nodos sueltos que se recorre en
+    // preorden, y deja en pending el resto con el mismo preorden: el
+    // subárbol derecho se cuelga del último nodo en preorden del izquierdo.
+    // Así merge no necesita una pila para recordar los subárboles derechos.
+    static node_base * detach_preorder_first(node_base * & pending) {
+        node_base * first = pending;
+        if (first->left == nullptr) {
+            pending = first->right;
+        } else {
+            pending = first->left;
+            if (first->right != nullptr) {
+                node_base * last = pending;
+                while (last->left != nullptr || last->right != nullptr) {
+                    last = last->right != nullptr ? last->right : last->left;
+                }
+                last->right = first->right;
+            }
+        }
+        return first;
+    }
+
+    // Engancha un nodo suelto como hoja, salvo que su clave ya esté
+    std::pair<iterator, bool> insert_node(node_base * n) {
+        node_base * parent;
+        node_base ** ptr = find_link(data_of(n).first, parent);
+        if (*ptr != nullptr) {
+            return { iterator(*ptr), false };
+        }
+        n->left = n->right = nullptr;
+        n->parent = parent;
+        n->height = 1;
+        *ptr = n;
+        rebalance_from(parent);
+        return { iterator(n), true };
+    }
+
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> do_emplace(Key && key, Args &&... args) {
+        node_base * parent;
+        node_base ** ptr = find_link(key, parent);
+        if (*ptr != nullptr) {
+            return { iterator(*ptr), false };
+        }
+        node_base * inserted = new node(parent, 1, std::piecewise_construct,
+                                        std::forward_as_tuple(std::forward<Key>(key)),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+        *ptr = inserted;
+        rebalance_from(parent);
+        return { iterator(inserted), true };
+    }
+
+    void balance_tree(node_base * & root) {
         int bf = balance_factor(root);
         if (bf == 2) {
             if (balance_factor(root->left) == -1) {
@@ -304,7 +824,7 @@ private:
         }
     }
 
-    int balance_factor(const node * a_node) {
+    int balance_factor(const node_base * a_node) {
         int result = 0;
         if (a_node != nullptr) {
             if (a_node->left != nullptr) {
@@ -317,14 +837,14 @@ private:
         return result;
     }
 
-    void assign_parent(node * & n, node * p) {
+    void assign_parent(node_base * & n, node_base * p) {
         if (n != nullptr) {
             n->parent = p;
         }
     }
 
-    void rotate_left(node * & root) {
-        node * right_tree = root->right;
+    void rotate_left(node_base * & root) {
+        node_base * right_tree = root->right;
         root->right = right_tree->left;
         assign_parent(root->right, root);
         right_tree->left = root;
@@ -335,8 +855,8 @@ private:
         root->update_height();
     }
 
-    void rotate_right(node * & root) {
-        node * left_tree = root->left;
+    void rotate_right(node_base * & root) {
+        node_base * left_tree = root->left;
         root->left = left_tree->right;
         assign_parent(root->left, root);
         left_tree->right = root;
@@ -347,71 +867,58 @@ private:
         root->update_height();
     }
 
-    std::pair<bool, iterator> do_erase(node * & current, const K & key) {
-        if (current == nullptr) {
-            return { false, end() };
-        }
-
-        if (key == current->data.first) {
-            iterator next = ++iterator(current);
-            erase_node(current);
-            return { true, next };
-        }
-
-        std::pair<bool, iterator> result;
-        if (key < current->data.first) {
-            result = do_erase(current->left, key);
-        } else {
-            result = do_erase(current->right, key);
-        }
-        if (result.first) {
-            balance_tree(current);
-        }
-        return result;
-    }
-
-    void erase_node(node * & n) {
-        node * removed = n;
-        if (n->left == nullptr) {
-            n = n->right;
-        } else if (n->right == nullptr) {
-            n = n->left;
+    void erase_node(node_base * n) {
+        unlink_node(n);
+        delete static_cast<node *>(n);
+    }
+
+    // Desengancha a n del árbol (sin liberarlo) y rebalancea
+    void unlink_node(node_base * n) {
+        node_base * rebalance_start;
+        if (n->left != nullptr && n->right != nullptr) {
+            // Pone en el lugar de n a su predecesor (el máximo del subárbol
+            // izquierdo), desenganchándolo antes de su posición original.
+            node_base * max = n->left->find_maximum();
+            rebalance_start = max->parent == n ? max : max->parent;
+            link_to(max) = max->left;
+            assign_parent(max->left, max->parent);
+            max->left = n->left;
+            max->right = n->right;
+            assign_parent(max->left, max);
+            assign_parent(max->right, max);
+            max->parent = n->parent;
+            max->height = n->height;
+            link_to(n) = max;
         } else {
-            move_maximum_to(n, n->left);
-            balance_tree(n);
+            node_base * child = n->left != nullptr ? n->left : n->right;
+            rebalance_start = n->parent;
+            link_to(n) = child;
+            assign_parent(child, n->parent);
         }
-        assign_parent(n, removed->parent);
-        delete removed;
-    }
-
-    void move_maximum_to(node * & root, node * & current) {
-        if (current->right == nullptr) {
-            replace_node(root, current);
-        } else {
-            move_maximum_to(root, current->right);
-            current->update_height();
-        }
-    }
-
-    void replace_node(node * & original, node * & replacement) {
-        // Engancha al nodo "y" para que esté en el lugar del nodo "x",
-        // al que borrará luego de haber hecho el cambio (x <- y).
-        node * r = replacement;
-        assign_parent(replacement->left, replacement->parent);
-        replacement = replacement->left;
-        r->left = original->left;
-        r->right = original->right;
-        assign_parent(r->left, r);
-        assign_parent(r->right, r);
-        r->parent = original->parent;
-        original = r;
+        rebalance_from(rebalance_start);
     }
 
-    void do_clear(node * & current) {
-        if (current != nullptr) {
-            do_clear(current->left);
-            do_clear(current->right);
-            delete current;
+    // Borra los nodos sin recursión ni pila: baja hasta una hoja, la borra y
+    // vuelve a su padre, que eventualmente se convierte también en hoja.
+    void do_clear(node_base * current) {
+        assign_parent(current, nullptr);
+        while (current != nullptr) {
+            if (current->left != nullptr) {
+                current = current->left;
+            } else if (current->right != nullptr) {
+                current = current->right;
+            } else {
+                node_base * parent = current->parent;
+                if (parent != nullptr) {
+                    if (parent->left == current) {
+                        parent->left = nullptr;
+                    } else {
+                        parent->right = nullptr;
+                    }
+                }
+                delete static_cast<node *>(current);
+                current = parent;
+            }
         }
     }
 
@@ -419,10 +926,10 @@ private:
     /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
     /************************************************************************/
 
-    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
 
     // Calcula la posición de los nodos para poder mostrarlos en pantalla
-    void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
         if (current != nullptr) {
             calculate_nodes_placement(current->left, x, h+1, placements);
             placements.emplace_back(h, x++, current);
@@ -436,7 +943,7 @@ public:
     std::string str() const {
         int count = 0;
         nodes_placement placements;
-        calculate_nodes_placement(m_root, count, 0, placements);
+        calculate_nodes_placement(m_header.left, count, 0, placements);
 
         const int node_value_size = 3;
         std::vector<std::string> lines;
@@ -444,7 +951,7 @@ public:
         for (const auto & placement: placements) {
             int level;
             int pos;
-            const node * the_node;
+            const node_base * the_node;
             std::tie(level, pos, the_node) = placement;
 
             while (int(lines.size()) <= 2 * level) {
@@ -454,7 +961,7 @@ public:
             std::ostringstream s;
             int i = 2 * level;
             s << std::setw(pos * node_value_size - lines[i].size()) << "";
-            s << std::setw(node_value_size) << the_node->data.first;
+            s << std::setw(node_value_size) << data_of(the_node).first;
             lines[i] += s.str();
 
             if (prev_level != -1) {
@@ -0,0 +1,513 @@
+#ifndef AVL_MAP_FILE_H
+#define AVL_MAP_FILE_H
+
+#include "avl_map.h"
+
+#include <algorithm>   // Para std::lower_bound y std::upper_bound
+#include <cstddef>     // Para std::size_t
+#include <cstdint>     // Para std::uint32_t y std::uint64_t
+#include <cstdio>      // Para std::FILE, std::fopen, std::fwrite, std::rename y std::remove
+#include <cstring>     // Para std::memcpy y std::memcmp
+#include <functional>  // Para std::less
+#include <iterator>    // Para std::random_access_iterator_tag
+#include <string>      // Para std::string
+#include <type_traits> // Para std::is_trivially_copyable
+#include <utility>     // Para std::pair
+#include <vector>      // Para std::vector
+
+#include <fcntl.h>     // Para open
+#include <sys/mman.h>  // Para mmap, munmap y madvise
+#include <sys/stat.h>  // Para fstat
+#include <unistd.h>    // Para close
+
+/************************************************************************************/
+/************ Guardado en binario y carga rápida de un mapa asociativo AVL **********/
+/************************************************************************************/
+
+// Formato del archivo (en el orden de bytes de la máquina que lo escribió):
+//
+//   - una cabecera de 64 bytes (map_file_header);
+//   - las count claves ordenadas, una detrás de otra, desde keys_offset;
+//   - los count valores en el mismo orden, desde values_offset (múltiplo de
+//     64, para que queden alineados al mapear el archivo).
+//
+// Como claves y valores se copian byte a byte, K y V tienen que ser
+// trivialmente copiables (enteros, números de punto flotante, structs de
+// ellos...). La suma de verificación es una suma de Fletcher de 64 bits
+// sobre todo lo que sigue a la cabecera y después sobre la cabecera misma,
+// con el campo checksum en cero.
+//
+// Guardar recorre el árbol en orden, así que las claves quedan ordenadas y
+// hay dos maneras de volver a leerlas:
+//
+//   - load_map arma el árbol balanceado en O(n) sin comparar claves ni
+//     rotar, en lugar de insertar los pares uno por uno en O(n log n);
+//   - mapped_map mapea el archivo en memoria y responde consultas de sólo
+//     lectura con búsqueda binaria directamente sobre él, sin armar nada:
+//     abrirlo cuesta O(1) y el sistema operativo va leyendo las páginas a
+//     medida que se usan.
+//
+// Usa mmap, así que sólo funciona en sistemas POSIX.
+
+struct map_file_header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;   // map_file_byte_order escrito en el orden de la máquina
+    std::uint32_t key_size;
+    std::uint32_t value_size;
+    std::uint64_t count;
+    std::uint64_t keys_offset;
+    std::uint64_t values_offset;
+    std::uint64_t file_size;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(map_file_header) == 64, "La cabecera ocupa exactamente 64 bytes");
+
+static const char map_file_magic[8] = { 'A', 'V', 'L', 'M', 'A', 'P', '\0', '\0' };
+static const std::uint32_t map_file_version = 1;
+static const std::uint32_t map_file_byte_order = 0x01020304;
+
+/************************************************************************************/
+/************** Funcionalidad auxiliar para escribir y verificar archivos ***********/
+/************************************************************************************/
+
+// Suma de Fletcher de 64 bits: acumula las palabras de 64 bits y las sumas
+// parciales de esas sumas, así que detecta tanto bytes cambiados como
+// bloques cambiados de lugar. Es tan barata que leer el archivo cuesta más.
+class map_file_checksum {
+public:
+    map_file_checksum() {
+        m_sum = m_sum_of_sums = 0;
+    }
+
+    // Precondición: size es múltiplo de 8
+    void add(const char * data, std::size_t size) {
+        for (std::size_t i = 0; i < size; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, 8);
+            m_sum += word;
+            m_sum_of_sums += m_sum;
+        }
+    }
+
+    std::uint64_t value() const {
+        return m_sum ^ (m_sum_of_sums << 32 | m_sum_of_sums >> 32);
+    }
+
+private:
+    std::uint64_t m_sum;
+    std::uint64_t m_sum_of_sums;
+};
+
+// Completa la suma de los datos con la cabecera, que se suma al final
+// (recién al terminar de escribir se conocen sus campos) y con el campo
+// checksum en cero. Así también se detectan cabeceras dañadas.
+inline std::uint64_t map_file_header_checksum(map_file_checksum checksum, map_file_header header) {
+    header.checksum = 0;
+    checksum.add(reinterpret_cast<const char *>(&header), sizeof(header));
+    return checksum.value();
+}
+
+// Escribe a un archivo a través de un buffer, calculando la suma de
+// verificación de todo lo que se escribe
+class map_file_writer {
+public:
+    explicit map_file_writer(std::FILE * file) : m_buffer(1 << 20) {
+        m_file = file;
+        m_used = 0;
+        m_written = 0;
+        m_ok = true;
+    }
+
+    void write(const void * data, std::size_t size) {
+        const char * bytes = static_cast<const char *>(data);
+        while (size > 0) {
+            std::size_t chunk = std::min(size, m_buffer.size() - m_used);
+            std::memcpy(m_buffer.data() + m_used, bytes, chunk);
+            m_used += chunk;
+            bytes += chunk;
+            size -= chunk;
+            if (m_used == m_buffer.size()) {
+                flush();
+            }
+        }
+    }
+
+    // Completa con ceros hasta que lo escrito sea múltiplo de alignment
+    void pad_to(std::size_t alignment) {
+        static const char zeros[64] = {};
+        std::size_t padding = (alignment - (position() % alignment)) % alignment;
+        write(zeros, padding);
+    }
+
+    std::uint64_t position() const {
+        return m_written + m_used;
+    }
+
+    // Precondición: position() es múltiplo de 8
+    void flush() {
+        m_checksum.add(m_buffer.data(), m_used);
+        m_ok = m_ok && std::fwrite(m_buffer.data(), 1, m_used, m_file) == m_used;
+        m_written += m_used;
+        m_used = 0;
+    }
+
+    map_file_checksum checksum() const {
+        return m_checksum;
+    }
+
+    bool ok() const {
+        return m_ok;
+    }
+
+private:
+    std::FILE * m_file;
+    std::vector<char> m_buffer;
+    std::size_t m_used;
+    std::uint64_t m_written;
+    map_file_checksum m_checksum;
+    bool m_ok;
+};
+
+/************************************************************************************/
+/************************** Guardar y cargar un mapa AVL ****************************/
+/************************************************************************************/
+
+// Guarda t en path recorriéndolo en orden dos veces: una para las claves y
+// otra para los valores. Escribe primero a path + ".tmp" y lo renombra al
+// terminar, así que si algo falla a mitad de camino el archivo anterior
+// queda intacto. Devuelve false si no se pudo escribir.
+template <typename K, typename V, typename Compare>
+bool save_map(tree<K, V, Compare> & t, const std::string & path) {
+    static_assert(std::is_trivially_copyable<K>::value, "K tiene que ser trivialmente copiable");
+    static_assert(std::is_trivially_copyable<V>::value, "V tiene que ser trivialmente copiable");
+
+    std::string temporary = path + ".tmp";
+    std::FILE * file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    map_file_header header = {};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+    // El escritor cuenta las posiciones desde el final de la cabecera
+    map_file_writer writer(file);
+    std::uint64_t count = 0;
+    t.each([&](const K & key, const V &) {
+        writer.write(&key, sizeof(K));
+        ++count;
+    });
+    writer.pad_to(64);
+    header.values_offset = sizeof(header) + writer.position();
+    t.each([&](const K &, const V & value) {
+        writer.write(&value, sizeof(V));
+    });
+    writer.pad_to(8);
+    writer.flush();
+
+    std::memcpy(header.magic, map_file_magic, sizeof(header.magic));
+    header.version = map_file_version;
+    header.byte_order = map_file_byte_order;
+    header.key_size = sizeof(K);
+    header.value_size = sizeof(V);
+    header.count = count;
+    header.keys_offset = sizeof(header);
+    header.file_size = sizeof(header) + writer.position();
+    header.checksum = map_file_header_checksum(writer.checksum(), header);
+
+    ok = ok && writer.ok() && std::fseek(file, 0, SEEK_SET) == 0
+            && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************************/
+/********** Mapa de sólo lectura que responde consultas desde el archivo ************/
+/************************************************************************************/
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class mapped_map {
+    static_assert(std::is_trivially_copyable<K>::value, "K tiene que ser trivialmente copiable");
+    static_assert(std::is_trivially_copyable<V>::value, "V tiene que ser trivialmente copiable");
+
+public:
+
+    /************************************************************************/
+    /*********************** CONSTRUCTOR Y DESTRUCTOR ***********************/
+    /************************************************************************/
+
+    explicit mapped_map(const Compare & cmp = Compare()) : m_cmp(cmp) {
+        m_data = nullptr;
+        m_size = 0;
+        m_keys = nullptr;
+        m_values = nullptr;
+        m_count = 0;
+    }
+
+    mapped_map(const mapped_map &) = delete;
+    mapped_map & operator=(const mapped_map &) = delete;
+
+    ~mapped_map() {
+        close();
+    }
+
+    // Mapea el archivo y controla la cabecera (pero no la suma de
+    // verificación, que obligaría a leerlo entero: para eso está verify).
+    // Devuelve false si el archivo no existe, está truncado o fue escrito
+    // con otros tipos o en una máquina con otro orden de bytes.
+    bool open(const std::string & path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        bool ok = ::fstat(fd, &info) == 0 && std::size_t(info.st_size) >= sizeof(map_file_header);
+        if (ok) {
+            m_size = std::size_t(info.st_size);
+            void * data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ok = data != MAP_FAILED;
+            if (ok) {
+                m_data = static_cast<const char *>(data);
+            }
+        }
+        ::close(fd);  // El mapeo sigue vigente aunque se cierre el archivo
+        if (!ok || !read_header()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char *>(m_data), m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+        m_keys = nullptr;
+        m_values = nullptr;
+        m_count = 0;
+    }
+
+    bool is_open() const {
+        return m_data != nullptr;
+    }
+
+    // Lee todo el archivo y compara la suma de verificación con la guardada
+    bool verify() const {
+        if (!is_open()) {
+            return false;
+        }
+        ::madvise(const_cast<char *>(m_data), m_size, MADV_SEQUENTIAL);
+        map_file_checksum checksum;
+        checksum.add(m_data + sizeof(map_file_header), m_size - sizeof(map_file_header));
+        return map_file_header_checksum(checksum, header()) == header().checksum;
+    }
+
+    /************************************************************************/
+    /******** ITERADOR DE ACCESO ALEATORIO SOBRE LOS PARES GUARDADOS ********/
+    /************************************************************************/
+
+    // Las claves y los valores están en arreglos separados, así que el
+    // iterador devuelve por valor un par de referencias a ellos
+    class iterator {
+    private:
+        const mapped_map * m_map;
+        std::size_t m_index;
+
+        friend class mapped_map;
+
+    public:
+        using value_type = std::pair<K, V>;
+        using reference = std::pair<const K &, const V &>;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        iterator(const mapped_map * map = nullptr, std::size_t index = 0) {
+            m_map = map;
+            m_index = index;
+        }
+
+        reference operator*() const {
+            return reference(m_map->m_keys[m_index], m_map->m_values[m_index]);
+        }
+
+        reference operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_index == y.m_index;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        friend
+        bool operator<(const iterator & x, const iterator & y) {
+            return x.m_index < y.m_index;
+        }
+
+        iterator & operator++() {
+            ++m_index;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        iterator & operator--() {
+            --m_index;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+
+        iterator & operator+=(difference_type n) {
+            m_index += n;
+            return *this;
+        }
+
+        friend
+        iterator operator+(iterator x, difference_type n) {
+            return x += n;
+        }
+
+        iterator & operator-=(difference_type n) {
+            m_index -= n;
+            return *this;
+        }
+
+        friend
+        iterator operator-(iterator x, difference_type n) {
+            return x -= n;
+        }
+
+        friend
+        difference_type operator-(const iterator & x, const iterator & y) {
+            return difference_type(x.m_index) - difference_type(y.m_index);
+        }
+    };
+
+    iterator begin() const {
+        return iterator(this, 0);
+    }
+
+    iterator end() const {
+        return iterator(this, m_count);
+    }
+
+    /************************************************************************/
+    /****************************** CONSULTAS *******************************/
+    /************************************************************************/
+
+    std::size_t size() const {
+        return m_count;
+    }
+
+    bool empty() const {
+        return m_count == 0;
+    }
+
+    // Como en avl_map, si el comparador es transparente se puede buscar con
+    // cualquier tipo comparable con K
+    template <typename Key>
+    iterator find(const Key & key) const {
+        iterator p = lower_bound(key);
+        if (p == end() || m_cmp(key, m_keys[p.m_index])) {
+            return end();
+        }
+        return p;
+    }
+
+    template <typename Key>
+    bool contains(const Key & key) const {
+        return find(key) != end();
+    }
+
+    template <typename Key>
+    iterator lower_bound(const Key & key) const {
+        const K * p = std::lower_bound(m_keys, m_keys + m_count, key, m_cmp);
+        return iterator(this, p - m_keys);
+    }
+
+    template <typename Key>
+    iterator upper_bound(const Key & key) const {
+        const K * p = std::upper_bound(m_keys, m_keys + m_count, key, m_cmp);
+        return iterator(this, p - m_keys);
+    }
+
+    template <typename F>
+    void each(F func) const {
+        for (std::size_t i = 0; i < m_count; ++i) {
+            func(m_keys[i], m_values[i]);
+        }
+    }
+
+private:
+    const char * m_data;
+    std::size_t m_size;
+    const K * m_keys;
+    const V * m_values;
+    std::size_t m_count;
+    Compare m_cmp;
+
+    const map_file_header & header() const {
+        return *reinterpret_cast<const map_file_header *>(m_data);
+    }
+
+    bool read_header() {
+        const map_file_header & h = header();
+        if (std::memcmp(h.magic, map_file_magic, sizeof(h.magic)) != 0
+                || h.version != map_file_version
+                || h.byte_order != map_file_byte_order
+                || h.key_size != sizeof(K) || h.value_size != sizeof(V)
+                || h.file_size != m_size
+                || h.keys_offset != sizeof(map_file_header)
+                || h.values_offset % 64 != 0
+                || h.values_offset < h.keys_offset
+                || h.values_offset > m_size
+                || h.count > (h.values_offset - h.keys_offset) / sizeof(K)
+                || h.count > (m_size - h.values_offset) / sizeof(V)
+                || m_size % 8 != 0) {
+            return false;
+        }
+        m_keys = reinterpret_cast<const K *>(m_data + h.keys_offset);
+        m_values = reinterpret_cast<const V *>(m_data + h.values_offset);
+        m_count = std::size_t(h.count);
+        return true;
+    }
+};
+
+// Reemplaza el contenido de t por el del archivo, armando el árbol en O(n)
+// con la carga masiva de avl_map. Verifica antes la suma de verificación;
+// si algo falla devuelve false y deja a t como estaba.
+template <typename K, typename V, typename Compare>
+bool load_map(tree<K, V, Compare> & t, const std::string & path) {
+    mapped_map<K, V, Compare> file;
+    if (!file.open(path) || !file.verify()) {
+        return false;
+    }
+    t = tree<K, V, Compare>(file.begin(), file.end());
+    return true;
+}
+
+#endif // AVL_MAP_FILE_H
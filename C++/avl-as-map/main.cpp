@@ -1,12 +1,18 @@
 #include "avl_map.h"
+#include "avl_map_file.h"
+#include "../benchmark/measure.h"
 
+#include <cstdio>
 #include <iostream>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
-template <typename K, typename V>
-ostream & operator<<(ostream & out, tree<K, V> & t) {
+template <typename K, typename V, typename C>
+ostream & operator<<(ostream & out, tree<K, V, C> & t) {
     out << "tree { ";
     for (const auto & x :t) {
         out << x.first << ":" << x.second << " ";
@@ -68,7 +74,13 @@ int main() {
     cout << "t1 = " << t1 << endl << t1.str() << endl;
 
     cout << "Mínimo de t1 => " << t1.minimum()->first << endl;
-    cout << "Máximo de t1 => " << t1.maximum()->first << endl << endl;
+    cout << "Máximo de t1 => " << t1.maximum()->first << endl;
+    cout << "Las tres claves más grandes de t1 => ";
+    int shown = 0;
+    for (auto p = t1.rbegin(); p != t1.rend() && shown < 3; ++p, ++shown) {
+        cout << (*p).first << " ";
+    }
+    cout << endl << endl;
 
     cout << "Vaciando a t1:" << endl;
     t1.clear();
@@ -103,4 +115,120 @@ int main() {
         cout << "Borrando un " << x << " => " << t3.erase(x).first << endl;
         cout << "t3 = " << t3 << endl << t3.str() << endl;
     }
+
+    cout << "Contando palabras en t4 usando operator[]:" << endl;
+    tree<string, int, less<>> t4;
+    for (const char * palabra : { "uno", "dos", "tres", "dos", "tres", "tres" })
+        ++t4[palabra];
+    cout << "t4 = " << t4 << endl;
+
+    // Como el comparador es transparente, buscar con un const char * no
+    // construye ningún std::string temporal.
+    cout << "¿t4 contiene a \"dos\"? " << boolalpha << t4.contains("dos") << endl;
+    cout << "¿t4 contiene a \"cuatro\"? " << boolalpha << t4.contains("cuatro") << endl;
+    cout << "Primera clave no menor a \"p\" => " << t4.lower_bound("p")->first << endl;
+    cout << "Primera clave mayor a \"tres\" => "
+         << (t4.upper_bound("tres") == t4.end() ? "(ninguna)" : t4.upper_bound("tres")->first) << endl;
+
+    cout << "try_emplace(\"uno\", 42) => " << t4.try_emplace("uno", 42).second << endl;
+    cout << "try_emplace(\"cuatro\", 4) => " << t4.try_emplace("cuatro", 4).second << endl;
+    cout << "insert_or_assign(\"uno\", 100) => " << t4.insert_or_assign("uno", 100).second << endl;
+    cout << "t4 = " << t4 << endl << endl;
+
+    cout << "Cambiando la clave \"dos\" por \"cinco\" sin pedir memoria:" << endl;
+    auto nodo = t4.extract("dos");
+    nodo.key() = "cinco";
+    t4.insert(move(nodo));
+    cout << "t4 = " << t4 << endl;
+
+    cout << "Mezclando t5 = { uno:1 seis:6 siete:7 } con t4:" << endl;
+    tree<string, int, less<>> t5;
+    t5.insert("uno", 1);
+    t5.insert("seis", 6);
+    t5.insert("siete", 7);
+    t4.merge(t5);
+    cout << "t4 = " << t4 << endl;
+    cout << "t5 = " << t5 << " (las claves que ya estaban en t4 quedan en t5)" << endl << endl;
+
+    cout << "Cambiando las claves de 200000 elementos (sumándoles n):" << endl;
+    const int n = 200000;
+    vector<int> keys(n);
+    mt19937 rng(42);
+    for (auto & k : keys)
+        k = int(rng() % n);
+    tree<int, int> a;
+    tree<int, int> b;
+    for (int k : keys) {
+        a.insert(k, k);
+        b.insert(k, k);
+    }
+    double erase_insert = measure([&] {
+        for (int k : keys) {
+            auto p = a.find(k);
+            if (p != a.end()) {
+                int value = p->second;
+                a.erase(k);
+                a.insert(k + n, value);
+            }
+        }
+    });
+    double extract_insert = measure([&] {
+        for (int k : keys) {
+            auto handle = b.extract(k);
+            if (handle) {
+                handle.key() += n;
+                b.insert(move(handle));
+            }
+        }
+    });
+    cout << "  erase + insert: " << erase_insert << " s, extract + insert: " << extract_insert << " s" << endl;
+    cout << "  ¿mismos resultados? " << boolalpha << (a == b) << endl << endl;
+
+    const int entries = 4000000;
+    const int lookups = 1000000;
+    const string path = "avl_map.bin";
+    cout << "Guardando y recuperando un mapa de " << entries << " pares al azar:" << endl;
+    tree<long, double> original;
+    double rebuild = measure([&] {
+        for (int i = 0; i < entries; ++i) {
+            original.insert(long(rng()), double(i));
+        }
+    });
+    double save = measure([&] { save_map(original, path); });
+
+    tree<long, double> loaded;
+    bool load_ok = false;
+    double load = measure([&] { load_ok = load_map(loaded, path); });
+
+    mapped_map<long, double> mapped;
+    bool open_ok = false;
+    double open = measure([&] { open_ok = mapped.open(path); });
+
+    // La mitad de las búsquedas son de claves guardadas elegidas al azar y
+    // la otra mitad de claves que (casi seguro) no están
+    vector<long> wanted(lookups);
+    for (auto & key : wanted) {
+        key = rng() % 2 == 0 ? long(rng()) : mapped.begin()[long(rng() % mapped.size())].first;
+    }
+    double found_tree = 0;
+    double found_mapped = 0;
+    double tree_lookups = measure([&] {
+        for (long key : wanted) {
+            auto p = loaded.find(key);
+            found_tree += p != loaded.end() ? p->second : -1;
+        }
+    });
+    double mapped_lookups = measure([&] {
+        for (long key : wanted) {
+            auto p = mapped.find(key);
+            found_mapped += p != mapped.end() ? (*p).second : -1;
+        }
+    });
+    cout << "  insertando uno por uno: " << rebuild << " s, save_map: " << save << " s" << endl;
+    cout << "  load_map (verificando y armando el árbol en O(n)): " << load << " s - ¿mismo contenido? "
+         << (load_ok && loaded == original) << endl;
+    cout << "  mapped_map::open: " << open << " s - ¿abrió? " << open_ok << endl;
+    cout << "  " << lookups << " búsquedas: árbol " << tree_lookups << " s, archivo mapeado " << mapped_lookups
+         << " s - ¿mismos resultados? " << (found_tree == found_mapped) << endl;
+    remove(path.c_str());
 }
@@ -3,8 +3,10 @@
 
 #include <algorithm>  // Para std::max
 #include <cstddef>    // Para std::size_t
-#include <functional> // Para std::function
-#include <iterator>   // Para std::forward_iterator_tag
+#include <future>     // Para std::async y std::future
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <system_error> // Para std::system_error
+#include <thread>     // Para std::thread::hardware_concurrency
 #include <utility>    // Para std::pair y std::swap
 
 /************************************************************************************/
@@ -24,23 +26,25 @@
 
 template <typename T>
 class tree {
-    struct node {
-        T value;
-        node * left;
-        node * right;
-        node * parent;
+    // Enlaces de un nodo, sin el valor. La cabecera es sólo esto; los demás
+    // nodos son node, que agrega el valor, y se convierten a node (con
+    // value_of) únicamente cuando se sabe que son elementos del árbol.
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
         int height;
 
-        node * find_minimum() {
-            node * minimum = this;
+        node_base * find_minimum() {
+            node_base * minimum = this;
             while (minimum->left != nullptr) {
                 minimum = minimum->left;
             }
             return minimum;
         }
 
-        node * find_maximum() {
-            node * maximum = this;
+        node_base * find_maximum() {
+            node_base * maximum = this;
             while (maximum->right != nullptr) {
                 maximum = maximum->right;
             }
@@ -60,7 +64,30 @@ class tree {
         }
     };
 
-    node * m_root;
+    struct node : node_base {
+        T value;
+
+        node(const T & a_value, node_base * a_parent, int a_height) : value(a_value) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+            this->height = a_height;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // La raíz cuelga a la izquierda de m_header, un nodo cabecera que hace
+    // de padre de la raíz y de posición final de los iteradores (como en el
+    // árbol binario de búsqueda con iterador bidireccional). Gracias a eso
+    // se puede retroceder desde end(). Como la cabecera no tiene valor, T no
+    // necesita poder construirse por defecto.
+    node_base m_header;
 
 public:
 
@@ -69,12 +96,18 @@ public:
     /************************************************************************/
 
     tree() {
-        m_root = nullptr;
+        init_header();
     }
 
     tree(const tree & x) {
-        m_root = nullptr;
-        copy_nodes(x.m_root, m_root, nullptr);
+        init_header();
+        copy_nodes(x.m_header.left);
+    }
+
+    tree(tree && x) {
+        init_header();
+        set_root(x.m_header.left);
+        x.m_header.left = nullptr;
     }
 
     ~tree() {
@@ -88,32 +121,35 @@ public:
 
     friend
     void swap(tree & x, tree & y) {
-        using namespace std;
-        swap(x.m_root, y.m_root);
+        node_base * root = x.m_header.left;
+        x.set_root(y.m_header.left);
+        y.set_root(root);
     }
 
     /************************************************************************/
-    /************ ITERADOR LIVIANO QUE RECORRE AL ÁRBOL EN ORDEN ************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
     /************************************************************************/
 
     class iterator {
     private:
-        node * m_current;
+        node_base * m_current;
+
+        friend class tree;
 
     public:
         using value_type = T;
         using pointer = value_type *;
         using reference = value_type &;
         using difference_type = std::size_t;
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
 
-        iterator(node * current = nullptr) {
+        iterator(node_base * current = nullptr) {
             m_current = current;
         }
 
         reference operator*() {
-            // Precondición: m_current != nullptr
-            return m_current->value;
+            // Precondición: m_current != end()
+            return value_of(m_current);
         }
 
         pointer operator->() {
@@ -130,16 +166,17 @@ public:
             return !(x == y);
         }
 
+        // Al subir desde el máximo se llega a la cabecera, que es end()
         iterator & operator++() {
-            // Precondición: m_current != nullptr
+            // Precondición: m_current != end()
             if (m_current->right != nullptr) {
                 m_current = m_current->right->find_minimum();
             } else {
-                node * prev;
+                node_base * prev;
                 do {
                     prev = m_current;
                     m_current = m_current->parent;
-                } while (m_current != nullptr and m_current->right == prev);
+                } while (m_current->right == prev);
             }
             return *this;
         }
@@ -149,16 +186,46 @@ public:
             operator++();
             return tmp;
         }
+
+        // Desde end() baja al máximo, porque la raíz es el hijo izquierdo
+        // de la cabecera.
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
     };
 
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
     iterator begin() {
-        if (empty())
-            return end();
-        return iterator(m_root->find_minimum());
+        return iterator(m_header.find_minimum());
     }
 
     iterator end() {
-        return iterator(nullptr);
+        return iterator(&m_header);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
     }
 
     /************************************************************************/
@@ -166,7 +233,7 @@ public:
     /************************************************************************/
 
     bool empty() {
-        return m_root == nullptr;
+        return m_header.left == nullptr;
     }
 
     friend
@@ -188,11 +255,11 @@ public:
     }
 
     iterator find(const T & value) {
-        node * current = m_root;
+        node_base * current = m_header.left;
         while (current != nullptr) {
-            if (value < current->value) {
+            if (value < value_of(current)) {
                 current = current->left;
-            } else if (value > current->value) {
+            } else if (value > value_of(current)) {
                 current = current->right;
             } else {
                 return iterator(current);
@@ -206,19 +273,41 @@ public:
     }
 
     iterator minimum() {
-        if (m_root == nullptr)
-            return end();
-        return iterator(m_root->find_minimum());
+        return begin();
     }
 
     iterator maximum() {
-        if (m_root == nullptr)
+        if (empty())
             return end();
-        return iterator(m_root->find_maximum());
+        return iterator(m_header.left->find_maximum());
+    }
+
+    // Los recorridos reciben la función como parámetro de plantilla en lugar
+    // de un std::function: aceptan cualquier objeto invocable (una función,
+    // una lambda, etc.) y el compilador puede expandirlo en línea en vez de
+    // hacer una llamada indirecta por nodo. Los demás árboles del repositorio
+    // siguen el mismo criterio.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
     }
 
-    void each(std::function<void(const T &)> func) {
-        do_each(m_root, func);
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](const node_base * n) { func(value_of(n)); return true; });
     }
 
     /************************************************************************/
@@ -226,20 +315,180 @@ public:
     /************************************************************************/
 
     iterator insert(const T & value) {
-        return do_insert(m_root, nullptr, value);
+        node_base * parent;
+        node_base ** ptr = find_link(value, parent);
+        if (*ptr != nullptr) {
+            return iterator(*ptr);
+        }
+        node_base * inserted = new node(value, parent, 1);
+        *ptr = inserted;
+        rebalance_from(parent);
+        return iterator(inserted);
     }
 
     std::pair<bool, iterator> erase(const T & value) {
-        auto result = do_erase(m_root, value);
-        if (result.first && !empty()) {
-            m_root->update_height();
+        node_base * current = m_header.left;
+        while (current != nullptr) {
+            if (value < value_of(current)) {
+                current = current->left;
+            } else if (value > value_of(current)) {
+                current = current->right;
+            } else {
+                iterator next = ++iterator(current);
+                erase_node(current);
+                return { true, next };
+            }
         }
-        return result;
+        return { false, end() };
     }
 
     void clear() {
-        do_clear(m_root);
-        m_root = nullptr;
+        do_clear(m_header.left);
+        m_header.left = nullptr;
+    }
+
+    /************************************************************************/
+    /********** NODOS SUELTOS: EXTRAER, REINSERTAR Y MEZCLAR ÁRBOLES ********/
+    /************************************************************************/
+
+    // Un node_handle es dueño de un nodo que se sacó del árbol con extract.
+    // Permite cambiar el valor y volver a insertar el nodo (en éste o en otro
+    // árbol) sin liberar ni pedir memoria. Si se destruye sin reinsertarlo,
+    // libera el nodo.
+    class node_handle {
+    private:
+        node * m_node;
+
+        friend class tree;
+
+        explicit node_handle(node * a_node) {
+            m_node = a_node;
+        }
+
+    public:
+        node_handle() {
+            m_node = nullptr;
+        }
+
+        node_handle(node_handle && x) {
+            m_node = x.m_node;
+            x.m_node = nullptr;
+        }
+
+        node_handle & operator=(node_handle && x) {
+            if (this != &x) {
+                delete m_node;
+                m_node = x.m_node;
+                x.m_node = nullptr;
+            }
+            return *this;
+        }
+
+        ~node_handle() {
+            delete m_node;
+        }
+
+        bool empty() const {
+            return m_node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return !empty();
+        }
+
+        T & value() {
+            // Precondición: !empty()
+            return m_node->value;
+        }
+    };
+
+    // Devuelve un node_handle vacío si value no está en el árbol
+    node_handle extract(const T & value) {
+        iterator position = find(value);
+        if (position == end()) {
+            return node_handle();
+        }
+        return extract(position);
+    }
+
+    node_handle extract(iterator position) {
+        // Precondición: position != end()
+        unlink_node(position.m_current);
+        return node_handle(static_cast<node *>(position.m_current));
+    }
+
+    // Si el valor ya estaba, el nodo queda en handle y devuelve la posición
+    // del que ya estaba junto con false.
+    std::pair<iterator, bool> insert(node_handle && handle) {
+        if (handle.empty()) {
+            return { end(), false };
+        }
+        auto result = insert_node(handle.m_node);
+        if (result.second) {
+            handle.m_node = nullptr;
+        }
+        return result;
+    }
+
+    // Pasa a este árbol los nodos de other cuyos valores no están en éste
+    // (los demás quedan en other) sin liberar ni pedir memoria.
+    void merge(tree & other) {
+        if (&other == this) {
+            return;
+        }
+        node_base * pending = other.m_header.left;
+        other.m_header.left = nullptr;
+        while (pending != nullptr) {
+            node_base * n = detach_preorder_first(pending);
+            if (!insert_node(n).second) {
+                other.insert_node(n);
+            }
+        }
+    }
+
+    /************************************************************************/
+    /************ OPERACIONES DE CONJUNTOS BASADAS EN JOIN Y SPLIT ***********/
+    /************************************************************************/
+
+    // Agrega al final de este árbol todos los valores de x, dejando a x vacío.
+    // Precondición: todos los valores de x son mayores a los de este árbol.
+    void join(tree & x) {
+        set_root(do_join(m_header.left, x.m_header.left));
+        x.m_header.left = nullptr;
+    }
+
+    // Deja en este árbol los valores menores o iguales a value y devuelve un
+    // nuevo árbol con los mayores. Ambos quedan balanceados en O(log n).
+    tree split(const T & value) {
+        tree greater;
+        node_base * less;
+        node_base * greater_root;
+        node_base * found = do_split(m_header.left, value, less, greater_root);
+        if (found != nullptr) {
+            less = do_join(less, found, nullptr);
+        }
+        set_root(less);
+        greater.set_root(greater_root);
+        return greater;
+    }
+
+    // Las siguientes operaciones consumen los nodos de x y realizan
+    // O(m log(n/m + 1)) trabajo (m es el tamaño del árbol más chico),
+    // repartiendo en paralelo los subárboles grandes entre los núcleos.
+
+    void set_union(tree x) {
+        set_root(do_union(m_header.left, x.m_header.left, parallel_depth()));
+        x.m_header.left = nullptr;
+    }
+
+    void set_intersection(tree x) {
+        set_root(do_intersection(m_header.left, x.m_header.left, parallel_depth()));
+        x.m_header.left = nullptr;
+    }
+
+    void set_difference(tree x) {
+        set_root(do_difference(m_header.left, x.m_header.left, parallel_depth()));
+        x.m_header.left = nullptr;
     }
 
 private:
@@ -248,43 +497,195 @@ private:
     /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
     /************************************************************************/
 
-    void copy_nodes(const node * other_node, node * & this_node, node * parent) {
-        if (other_node != nullptr) {
-            this_node = new node { other_node->value, nullptr, nullptr, parent, other_node->height };
-            copy_nodes(other_node->left, this_node->left, this_node);
-            copy_nodes(other_node->right, this_node->right, this_node);
+    // Los recorridos usan una pila de tamaño fijo en lugar de recursión: la
+    // altura de un árbol AVL con n nodos es menor a 1.45 * log2(n + 2), así
+    // que max_height niveles alcanzan para cualquier árbol que entre en
+    // memoria. visit recibe cada nodo y devuelve false para interrumpir el
+    // recorrido.
+
+    static const int max_height = 64;
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        while (current != nullptr || size > 0) {
+            while (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            }
+            current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        if (m_header.left != nullptr) {
+            pending[size++] = m_header.left;
+        }
+        while (size > 0) {
+            node_base * current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending[size++] = current->right;
+            }
+            if (current->left != nullptr) {
+                pending[size++] = current->left;
+            }
         }
+        return true;
     }
 
-    void do_each(node * current, std::function<void(const T &)> func) {
-        if (current != nullptr) {
-            do_each(current->left, func);
-            func(current->value);
-            do_each(current->right, func);
+    template <typename F>
+    bool visit_postorder(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        node_base * last = nullptr;
+        while (current != nullptr || size > 0) {
+            if (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            } else {
+                node_base * top = pending[size - 1];
+                if (top->right != nullptr && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    --size;
+                }
+            }
         }
+        return true;
     }
 
-    iterator do_insert(node * & current, node * parent, const T & value) {
-        if (current == nullptr) {
-            current = new node { value, nullptr, nullptr, parent, 1 };
-            return iterator(current);
+    // Copia los nodos de other sin recursión ni pila: avanza en pre-orden
+    // sobre ambos árboles a la vez, subiendo por los enlaces a los padres.
+    void copy_nodes(const node_base * other) {
+        if (other == nullptr) {
+            return;
+        }
+        const node_base * other_root = other;
+        set_root(new node(value_of(other), nullptr, other->height));
+        node_base * current = m_header.left;
+        while (true) {
+            if (other->left != nullptr && current->left == nullptr) {
+                other = other->left;
+                current->left = new node(value_of(other), current, other->height);
+                current = current->left;
+            } else if (other->right != nullptr && current->right == nullptr) {
+                other = other->right;
+                current->right = new node(value_of(other), current, other->height);
+                current = current->right;
+            } else if (other != other_root) {
+                other = other->parent;
+                current = current->parent;
+            } else {
+                break;
+            }
         }
+    }
 
-        if (value == current->value) {
-            return iterator(current);
+    // Devuelve el enlace donde está (o debería estar) value y deja en parent
+    // al nodo del que cuelga ese enlace.
+    node_base ** find_link(const T & value, node_base * & parent) {
+        node_base ** ptr = &m_header.left;
+        parent = &m_header;
+        while (*ptr != nullptr) {
+            if (value < value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->left;
+            } else if (value > value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->right;
+            } else {
+                break;
+            }
         }
+        return ptr;
+    }
 
-        iterator result;
-        if (value < current->value) {
-            result = do_insert(current->left, current, value);
+    // Saca la raíz de pending, un árbol de nodos sueltos que se recorre en
+    // preorden, y deja en pending el resto con el mismo preorden: el
+    // subárbol derecho se cuelga del último nodo en preorden del izquierdo.
+    // Así merge no necesita una pila para recordar los subárboles derechos.
+    static node_base * detach_preorder_first(node_base * & pending) {
+        node_base * first = pending;
+        if (first->left == nullptr) {
+            pending = first->right;
         } else {
-            result = do_insert(current->right, current, value);
+            pending = first->left;
+            if (first->right != nullptr) {
+                node_base * last = pending;
+                while (last->left != nullptr || last->right != nullptr) {
+                    last = last->right != nullptr ? last->right : last->left;
+                }
+                last->right = first->right;
+            }
         }
-        balance_tree(current);
-        return result;
+        return first;
+    }
+
+    // Engancha un nodo suelto como hoja, salvo que su valor ya esté
+    std::pair<iterator, bool> insert_node(node_base * n) {
+        node_base * parent;
+        node_base ** ptr = find_link(value_of(n), parent);
+        if (*ptr != nullptr) {
+            return { iterator(*ptr), false };
+        }
+        n->left = n->right = nullptr;
+        n->parent = parent;
+        n->height = 1;
+        *ptr = n;
+        rebalance_from(parent);
+        return { iterator(n), true };
+    }
+
+    void init_header() {
+        m_header.left = m_header.right = m_header.parent = nullptr;
+        m_header.height = 0;
+    }
+
+    void set_root(node_base * root) {
+        m_header.left = root;
+        assign_parent(m_header.left, &m_header);
     }
 
-    void balance_tree(node * & root) {
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de la
+    // cabecera)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    // Sube desde current hasta la raíz actualizando las alturas y rotando
+    // donde haga falta. Se detiene en cuanto un subárbol conserva la altura
+    // que tenía, porque entonces nada cambia más arriba.
+    void rebalance_from(node_base * current) {
+        while (current != &m_header) {
+            int old_height = current->height;
+            node_base * & link = link_to(current);
+            balance_tree(link);
+            if (link->height == old_height) {
+                break;
+            }
+            current = link->parent;
+        }
+    }
+
+    void balance_tree(node_base * & root) {
         int bf = balance_factor(root);
         if (bf == 2) {
             if (balance_factor(root->left) == -1) {
@@ -301,7 +702,7 @@ private:
         }
     }
 
-    int balance_factor(const node * a_node) {
+    int balance_factor(const node_base * a_node) {
         int result = 0;
         if (a_node != nullptr) {
             if (a_node->left != nullptr) {
@@ -314,14 +715,14 @@ private:
         return result;
     }
 
-    void assign_parent(node * & n, node * p) {
+    void assign_parent(node_base * & n, node_base * p) {
         if (n != nullptr) {
             n->parent = p;
         }
     }
 
-    void rotate_left(node * & root) {
-        node * right_tree = root->right;
+    void rotate_left(node_base * & root) {
+        node_base * right_tree = root->right;
         root->right = right_tree->left;
         assign_parent(root->right, root);
         right_tree->left = root;
@@ -332,8 +733,8 @@ private:
         root->update_height();
     }
 
-    void rotate_right(node * & root) {
-        node * left_tree = root->left;
+    void rotate_right(node_base * & root) {
+        node_base * left_tree = root->left;
         root->left = left_tree->right;
         assign_parent(root->left, root);
         left_tree->right = root;
@@ -344,82 +745,255 @@ private:
         root->update_height();
     }
 
-    std::pair<bool, iterator> do_erase(node * & current, const T & value) {
-        if (current == nullptr) {
-            return { false, end() };
+    void erase_node(node_base * n) {
+        unlink_node(n);
+        delete static_cast<node *>(n);
+    }
+
+    // Desengancha a n del árbol (sin liberarlo) y rebalancea
+    void unlink_node(node_base * n) {
+        node_base * rebalance_start;
+        if (n->left != nullptr && n->right != nullptr) {
+            // Pone en el lugar de n a su predecesor (el máximo del subárbol
+            // izquierdo), desenganchándolo antes de su posición original.
+            node_base * max = n->left->find_maximum();
+            rebalance_start = max->parent == n ? max : max->parent;
+            link_to(max) = max->left;
+            assign_parent(max->left, max->parent);
+            max->left = n->left;
+            max->right = n->right;
+            assign_parent(max->left, max);
+            assign_parent(max->right, max);
+            max->parent = n->parent;
+            max->height = n->height;
+            link_to(n) = max;
+        } else {
+            node_base * child = n->left != nullptr ? n->left : n->right;
+            rebalance_start = n->parent;
+            link_to(n) = child;
+            assign_parent(child, n->parent);
         }
+        rebalance_from(rebalance_start);
+    }
 
-        if (value == current->value) {
-            iterator next = ++iterator(current);
-            erase_node(current);
-            return { true, next };
+    // Borra los nodos sin recursión ni pila: baja hasta una hoja, la borra y
+    // vuelve a su padre, que eventualmente se convierte también en hoja.
+    void do_clear(node_base * current) {
+        assign_parent(current, nullptr);
+        while (current != nullptr) {
+            if (current->left != nullptr) {
+                current = current->left;
+            } else if (current->right != nullptr) {
+                current = current->right;
+            } else {
+                node_base * parent = current->parent;
+                if (parent != nullptr) {
+                    if (parent->left == current) {
+                        parent->left = nullptr;
+                    } else {
+                        parent->right = nullptr;
+                    }
+                }
+                delete static_cast<node *>(current);
+                current = parent;
+            }
         }
+    }
 
-        std::pair<bool, iterator> result;
-        if (value < current->value) {
-            result = do_erase(current->left, value);
-        } else {
-            result = do_erase(current->right, value);
+    /************************************************************************/
+    /********* MÉTODOS AUXILIARES PARA LAS OPERACIONES DE CONJUNTOS *********/
+    /************************************************************************/
+
+    // Los siguientes métodos trabajan sobre subárboles sueltos: el puntero al
+    // padre de la raíz que devuelven queda sin definir y lo asigna quien llama.
+
+    static int height(const node_base * a_node) {
+        return a_node == nullptr ? 0 : a_node->height;
+    }
+
+    // Une left, middle y right (en ese orden) en un único árbol balanceado,
+    // bajando por el borde del más alto hasta encontrar un subárbol de altura
+    // similar al otro. Toma O(|height(left) - height(right)|).
+    node_base * do_join(node_base * left, node_base * middle, node_base * right) {
+        if (height(left) > height(right) + 1) {
+            left->right = do_join(left->right, middle, right);
+            assign_parent(left->right, left);
+            balance_tree(left);
+            return left;
         }
-        if (result.first) {
-            balance_tree(current);
+        if (height(right) > height(left) + 1) {
+            right->left = do_join(left, middle, right->left);
+            assign_parent(right->left, right);
+            balance_tree(right);
+            return right;
         }
-        return result;
+        middle->left = left;
+        middle->right = right;
+        assign_parent(middle->left, middle);
+        assign_parent(middle->right, middle);
+        middle->update_height();
+        return middle;
     }
 
-    void erase_node(node * & n) {
-        node * removed = n;
-        if (n->left == nullptr) {
-            n = n->right;
-        } else if (n->right == nullptr) {
-            n = n->left;
-        } else {
-            move_maximum_to(n, n->left);
-            balance_tree(n);
+    node_base * do_join(node_base * left, node_base * right) {
+        if (left == nullptr) {
+            return right;
         }
-        assign_parent(n, removed->parent);
-        delete removed;
+        node_base * maximum;
+        left = detach_maximum(left, maximum);
+        return do_join(left, maximum, right);
     }
 
-    void move_maximum_to(node * & root, node * & current) {
-        if (current->right == nullptr) {
-            replace_node(root, current);
+    node_base * detach_maximum(node_base * root, node_base * & maximum) {
+        if (root->right == nullptr) {
+            maximum = root;
+            return root->left;
+        }
+        root->right = detach_maximum(root->right, maximum);
+        assign_parent(root->right, root);
+        balance_tree(root);
+        return root;
+    }
+
+    // Reparte los nodos de root entre less y greater. Devuelve el nodo que
+    // contenía a value (desenganchado del resto) o nullptr si no estaba.
+    node_base * do_split(node_base * root, const T & value, node_base * & less, node_base * & greater) {
+        if (root == nullptr) {
+            less = greater = nullptr;
+            return nullptr;
+        }
+
+        node_base * left = root->left;
+        node_base * right = root->right;
+        node_base * found;
+        if (value < value_of(root)) {
+            found = do_split(left, value, less, greater);
+            greater = do_join(greater, root, right);
+        } else if (value > value_of(root)) {
+            found = do_split(right, value, less, greater);
+            less = do_join(left, root, less);
         } else {
-            move_maximum_to(root, current->right);
-            current->update_height();
+            root->left = root->right = nullptr;
+            less = left;
+            greater = right;
+            found = root;
         }
+        return found;
     }
 
-    void replace_node(node * & original, node * & replacement) {
-        // Engancha al nodo "y" para que esté en el lugar del nodo "x",
-        // al que borrará luego de haber hecho el cambio (x <- y).
-        node * r = replacement;
-        assign_parent(replacement->left, replacement->parent);
-        replacement = replacement->left;
-        r->left = original->left;
-        r->right = original->right;
-        assign_parent(r->left, r);
-        assign_parent(r->right, r);
-        r->parent = original->parent;
-        original = r;
+    node_base * do_union(node_base * a, node_base * b, int depth) {
+        if (a == nullptr) {
+            return b;
+        }
+        if (b == nullptr) {
+            return a;
+        }
+
+        bool parallel = depth > 0 && std::min(a->height, b->height) >= parallel_min_height;
+        node_base * a_less;
+        node_base * a_greater;
+        delete static_cast<node *>(do_split(a, value_of(b), a_less, a_greater));
+
+        node_base * less;
+        node_base * greater;
+        fork_join(parallel,
+                  [&] { less = do_union(a_less, b->left, depth - 1); },
+                  [&] { greater = do_union(a_greater, b->right, depth - 1); });
+        return do_join(less, b, greater);
     }
 
-    void do_clear(node * & current) {
-        if (current != nullptr) {
-            do_clear(current->left);
-            do_clear(current->right);
-            delete current;
+    node_base * do_intersection(node_base * a, node_base * b, int depth) {
+        if (a == nullptr || b == nullptr) {
+            do_clear(a);
+            do_clear(b);
+            return nullptr;
+        }
+
+        bool parallel = depth > 0 && std::min(a->height, b->height) >= parallel_min_height;
+        node_base * a_less;
+        node_base * a_greater;
+        node_base * found = do_split(a, value_of(b), a_less, a_greater);
+
+        node_base * less;
+        node_base * greater;
+        fork_join(parallel,
+                  [&] { less = do_intersection(a_less, b->left, depth - 1); },
+                  [&] { greater = do_intersection(a_greater, b->right, depth - 1); });
+        if (found != nullptr) {
+            delete static_cast<node *>(found);
+            return do_join(less, b, greater);
+        }
+        delete static_cast<node *>(b);
+        return do_join(less, greater);
+    }
+
+    node_base * do_difference(node_base * a, node_base * b, int depth) {
+        if (a == nullptr || b == nullptr) {
+            do_clear(b);
+            return a;
+        }
+
+        bool parallel = depth > 0 && std::min(a->height, b->height) >= parallel_min_height;
+        node_base * a_less;
+        node_base * a_greater;
+        delete static_cast<node *>(do_split(a, value_of(b), a_less, a_greater));
+
+        node_base * less;
+        node_base * greater;
+        fork_join(parallel,
+                  [&] { less = do_difference(a_less, b->left, depth - 1); },
+                  [&] { greater = do_difference(a_greater, b->right, depth - 1); });
+        delete static_cast<node *>(b);
+        return do_join(less, greater);
+    }
+
+    // Por debajo de esta altura (unos cientos de nodos) no conviene crear
+    // tareas: el costo de lanzarlas supera al trabajo que se reparte.
+    static const int parallel_min_height = 12;
+
+    // Cantidad de niveles de la recursión en los que se crean tareas nuevas:
+    // alcanza para ocupar todos los núcleos con algo de margen para las
+    // tareas que terminan antes.
+    static int parallel_depth() {
+        unsigned cores = std::thread::hardware_concurrency();
+        int depth = 2;
+        while (cores > 1) {
+            cores /= 2;
+            ++depth;
+        }
+        return depth;
+    }
+
+    // Ejecuta first en una tarea aparte y second en el hilo actual, esperando
+    // a que ambas terminen. Si no hay que (o no se puede) lanzar la tarea,
+    // las ejecuta una detrás de la otra.
+    template <typename F1, typename F2>
+    static void fork_join(bool parallel, F1 first, F2 second) {
+        if (parallel) {
+            std::future<void> task;
+            try {
+                task = std::async(std::launch::async, first);
+            } catch (const std::system_error &) {
+                parallel = false;
+            }
+            if (parallel) {
+                second();
+                task.get();
+                return;
+            }
         }
+        first();
+        second();
     }
 
     /************************************************************************/
     /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
     /************************************************************************/
 
-    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
 
     // Calcula la posición de los nodos para poder mostrarlos en pantalla
-    void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
         if (current != nullptr) {
             calculate_nodes_placement(current->left, x, h+1, placements);
             placements.emplace_back(h, x++, current);
@@ -433,7 +1007,7 @@ public:
     std::string str() const {
         int count = 0;
         nodes_placement placements;
-        calculate_nodes_placement(m_root, count, 0, placements);
+        calculate_nodes_placement(m_header.left, count, 0, placements);
 
         const int node_value_size = 3;
         std::vector<std::string> lines;
@@ -441,7 +1015,7 @@ public:
         for (const auto & placement: placements) {
             int level;
             int pos;
-            const node * the_node;
+            const node_base * the_node;
             std::tie(level, pos, the_node) = placement;
 
             while (int(lines.size()) <= 2 * level) {
@@ -451,7 +1025,7 @@ public:
             std::ostringstream s;
             int i = 2 * level;
             s << std::setw(pos * node_value_size - lines[i].size()) << "";
-            s << std::setw(node_value_size) << the_node->value;
+            s << std::setw(node_value_size) << value_of(the_node);
             lines[i] += s.str();
 
             if (prev_level != -1) {
@@ -74,6 +74,11 @@ int main() {
 
     cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
     cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+    cout << ":: Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << *p << " ";
+    }
+    cout << endl;
 
     cout << "  t1 = " << t1 << endl;
 
@@ -132,4 +137,45 @@ int main() {
         letras.insert(c);
     }
     cout << "  Letras en '" << texto << "': " << letras << endl;
+
+    cout << endl << ":: Operaciones de conjuntos entre t4 (pares) y t5 (múltiplos de 3):" << endl;
+    tree<int> t4, t5;
+    for (int x = 0; x < 20; ++x) {
+        t4.insert(2 * x);
+        t5.insert(3 * x);
+    }
+    cout << "  t4 = " << t4 << endl;
+    cout << "  t5 = " << t5 << endl;
+
+    tree<int> unido = t4;
+    unido.set_union(t5);
+    cout << ":: t4 ∪ t5 = " << unido << endl;
+
+    tree<int> interseccion = t4;
+    interseccion.set_intersection(t5);
+    cout << ":: t4 ∩ t5 = " << interseccion << endl;
+
+    tree<int> diferencia = t4;
+    diferencia.set_difference(t5);
+    cout << ":: t4 - t5 = " << diferencia << endl;
+
+    cout << ":: Partiendo a t4 en 17:" << endl;
+    auto mayores = t4.split(17);
+    cout << "  t4 = " << t4 << endl;
+    cout << "  mayores = " << mayores << endl;
+
+    cout << ":: Volviendo a unir t4 con mayores:" << endl;
+    t4.join(mayores);
+    cout << "  t4 = " << t4 << " - ¿mayores está vacio? " << mayores.empty() << endl;
+
+    cout << ":: Cambiando el 12 de t4 por un 13 sin pedir memoria:" << endl;
+    auto nodo = t4.extract(12);
+    nodo.value() = 13;
+    t4.insert(move(nodo));
+    cout << "  t4 = " << t4 << endl;
+
+    cout << ":: Mezclando t5 con t4:" << endl;
+    t4.merge(t5);
+    cout << "  t4 = " << t4 << endl;
+    cout << "  t5 = " << t5 << " (los valores que ya estaban en t4 quedan en t5)" << endl;
 }
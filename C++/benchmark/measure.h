@@ -0,0 +1,17 @@
+#ifndef MEASURE_H
+#define MEASURE_H
+
+#include <chrono>  // Para std::chrono::steady_clock
+
+// Devuelve cuántos segundos tarda en ejecutarse func. Lo usan los programas
+// de ejemplo para comparar las estructuras entre sí; cada medición conviene
+// hacerla con optimizaciones (-O2) y sin sanitizers.
+template <typename F>
+double measure(F func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+#endif // MEASURE_H
@@ -0,0 +1,923 @@
+#ifndef BTREE_MAP_H
+#define BTREE_MAP_H
+
+#include <algorithm>    // Para std::copy, std::copy_backward, std::move y std::move_backward
+#include <cstddef>      // Para std::size_t
+#include <cstdint>      // Para std::int32_t y std::uintptr_t
+#include <cstring>      // Para std::memcpy
+#include <functional>   // Para std::less
+#include <iterator>     // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <new>          // Para ::operator new y ::operator delete
+#include <type_traits>  // Para std::integral_constant, std::is_arithmetic y std::is_same
+#include <utility>      // Para std::pair, std::swap, std::forward y std::move
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // Para las comparaciones de a 4 enteros de 32 bits
+#endif
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/************************************************************************************/
+/*********** Árbol B+ funcionando como mapa asociativo con hojas enlazadas **********/
+/************************************************************************************/
+
+// Cada nodo guarda muchas claves contiguas (tantas como entren en 256 bytes,
+// es decir cuatro líneas de caché), así que una búsqueda visita log_B(n)
+// nodos en lugar de los log_2(n) del árbol AVL. Los nodos internos sólo
+// guardan claves separadoras; los pares clave-valor están todos en las
+// hojas, que además están enlazadas entre sí para recorrerlas en orden sin
+// volver a subir por el árbol.
+//
+// Dentro de las hojas, las claves y los valores están en arreglos separados
+// para que buscar una clave no tenga que pasar por encima de los valores.
+// Por eso el iterador no devuelve un std::pair<const K, V> & sino un par de
+// referencias a la clave y al valor. K y V deben poder construirse por
+// defecto, como en dynamic_array.
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class btree_map {
+public:
+    using value_type = std::pair<const K, V>;
+
+private:
+    static const int node_bytes = 256;
+    static const int capacity = sizeof(K) * 8 <= node_bytes ? int(node_bytes / sizeof(K)) : 8;
+    static const int min_size = capacity / 2;
+
+    // Todo nodo salvo la raíz tiene al menos min_size + 1 >= 5 hijos, así
+    // que ningún árbol que entre en memoria tiene más de max_height niveles.
+    static const int max_height = 32;
+
+    static const std::size_t cache_line = 64;
+
+    // Las claves de cada nodo empiezan al principio de una línea de caché,
+    // así que las node_bytes que se recorren al buscar ocupan exactamente
+    // node_bytes / 64 líneas. Antes de C++17 new no respeta alineaciones
+    // mayores a la de std::max_align_t, por eso los nodos se piden con su
+    // propio operator new, que guarda el puntero original justo antes del
+    // nodo para poder liberarlo (como heap_allocator en heap.h).
+    struct node {
+        int size;   // Cantidad de claves
+
+        static void * operator new(std::size_t bytes) {
+            char * raw = static_cast<char *>(::operator new(bytes + sizeof(void *) + cache_line));
+            std::uintptr_t start = std::uintptr_t(raw + sizeof(void *));
+            start = (start + cache_line - 1) & ~std::uintptr_t(cache_line - 1);
+            char * aligned = reinterpret_cast<char *>(start);
+            std::memcpy(aligned - sizeof(void *), &raw, sizeof(void *));
+            return aligned;
+        }
+
+        static void operator delete(void * aligned) {
+            void * raw;
+            std::memcpy(&raw, static_cast<char *>(aligned) - sizeof(void *), sizeof(void *));
+            ::operator delete(raw);
+        }
+    };
+
+    struct leaf : node {
+        alignas(cache_line) K keys[capacity];
+        V values[capacity];
+        leaf * prev;    // Hojas vecinas, para recorrerlas en ambos sentidos
+        leaf * next;
+    };
+
+    // Las claves de children[i] son menores a keys[i] y las de children[i+1]
+    // son mayores o iguales.
+    struct inner : node {
+        alignas(cache_line) K keys[capacity];
+        node * children[capacity + 1];
+    };
+
+    // Las claves aritméticas ordenadas con std::less se buscan dentro de cada
+    // nodo contándolas de corrido, sin saltos que el procesador tenga que
+    // predecir y de a varias por instrucción (ver count_before).
+    using linear_search = std::integral_constant<bool,
+        std::is_arithmetic<K>::value &&
+        (std::is_same<Compare, std::less<K>>::value || std::is_same<Compare, std::less<>>::value)>;
+
+    node * m_root;
+    int m_height;   // Cantidad de niveles de nodos internos
+    std::size_t m_size;
+    Compare m_cmp;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    btree_map() {
+        m_root = nullptr;
+        m_height = 0;
+        m_size = 0;
+    }
+
+    explicit btree_map(const Compare & cmp) : m_cmp(cmp) {
+        m_root = nullptr;
+        m_height = 0;
+        m_size = 0;
+    }
+
+    btree_map(const btree_map & x) : m_cmp(x.m_cmp) {
+        leaf * last = nullptr;
+        m_root = x.m_root == nullptr ? nullptr : copy_nodes(x.m_root, x.m_height, last);
+        m_height = x.m_height;
+        m_size = x.m_size;
+    }
+
+    btree_map(btree_map && x) : m_cmp(x.m_cmp) {
+        m_root = x.m_root;
+        m_height = x.m_height;
+        m_size = x.m_size;
+        x.m_root = nullptr;
+        x.m_height = 0;
+        x.m_size = 0;
+    }
+
+    ~btree_map() {
+        clear();
+    }
+
+    btree_map & operator=(btree_map x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(btree_map & x, btree_map & y) {
+        using namespace std;
+        swap(x.m_root, y.m_root);
+        swap(x.m_height, y.m_height);
+        swap(x.m_size, y.m_size);
+        swap(x.m_cmp, y.m_cmp);
+    }
+
+    /************************************************************************/
+    /********* ITERADOR QUE RECORRE EN ORDEN LAS HOJAS ENLAZADAS ************/
+    /************************************************************************/
+
+    // end() no tiene hoja; para retroceder desde ahí el iterador recuerda su
+    // mapa y baja hasta la última hoja.
+    class iterator {
+    private:
+        btree_map * m_map;
+        leaf * m_leaf;
+        int m_position;
+
+    public:
+        using value_type = btree_map::value_type;
+        using reference = std::pair<const K &, V &>;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        // Como no hay ningún par guardado al que apuntar, operator-> devuelve
+        // un objeto que contiene el par de referencias.
+        class pointer {
+        private:
+            reference m_reference;
+
+        public:
+            pointer(reference r) : m_reference(r) {
+            }
+
+            reference * operator->() {
+                return &m_reference;
+            }
+        };
+
+        iterator(btree_map * map = nullptr, leaf * a_leaf = nullptr, int position = 0) {
+            m_map = map;
+            m_leaf = a_leaf;
+            m_position = position;
+        }
+
+        reference operator*() {
+            // Precondición: m_leaf != nullptr
+            return { m_leaf->keys[m_position], m_leaf->values[m_position] };
+        }
+
+        pointer operator->() {
+            return pointer(operator*());
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_leaf == y.m_leaf && x.m_position == y.m_position;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: m_leaf != nullptr
+            if (++m_position == m_leaf->size) {
+                m_leaf = m_leaf->next;
+                m_position = 0;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        iterator & operator--() {
+            // Precondición: *this != m_map->begin()
+            if (m_leaf == nullptr) {
+                m_leaf = m_map->last_leaf();
+                m_position = m_leaf->size;
+            } else if (m_position == 0) {
+                m_leaf = m_leaf->prev;
+                m_position = m_leaf->size;
+            }
+            --m_position;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        if (empty())
+            return end();
+        node * current = m_root;
+        for (int level = 0; level < m_height; ++level) {
+            current = static_cast<inner *>(current)->children[0];
+        }
+        return iterator(this, static_cast<leaf *>(current), 0);
+    }
+
+    iterator end() {
+        return iterator(this);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_root == nullptr;
+    }
+
+    std::size_t size() {
+        return m_size;
+    }
+
+    friend
+    bool operator==(btree_map & x, btree_map & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(btree_map & x, btree_map & y) {
+        return !(x == y);
+    }
+
+    iterator find(const K & key) {
+        return do_find(key);
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const Key & key) {
+        return do_find(key);
+    }
+
+    bool contains(const K & key) {
+        return do_find(key) != end();
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const Key & key) {
+        return do_find(key) != end();
+    }
+
+    // Devuelve el primer elemento cuya clave no es menor a key
+    iterator lower_bound(const K & key) {
+        return find_bound(key, false);
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const Key & key) {
+        return find_bound(key, false);
+    }
+
+    // Devuelve el primer elemento cuya clave es mayor a key
+    iterator upper_bound(const K & key) {
+        return find_bound(key, true);
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const Key & key) {
+        return find_bound(key, true);
+    }
+
+    iterator minimum() {
+        return begin();
+    }
+
+    iterator maximum() {
+        if (empty())
+            return end();
+        leaf * l = last_leaf();
+        return iterator(this, l, l->size - 1);
+    }
+
+    // Los recorridos siguen las hojas enlazadas, así que no necesitan pila.
+
+    template <typename F>
+    void each(F func) {
+        for (auto p = begin(); p != end(); ++p) {
+            func(p->first, p->second);
+        }
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        for (auto p = begin(); p != end(); ++p) {
+            if (!func(p->first, p->second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    // Si la clave ya estaba, insert reemplaza el valor asociado.
+
+    iterator insert(const K & key, const V & value) {
+        return insert_or_assign(key, value).first;
+    }
+
+    iterator insert(K && key, V && value) {
+        return insert_or_assign(std::move(key), std::move(value)).first;
+    }
+
+    // Devuelven además si la clave fue agregada (true) o si ya estaba (false).
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K & key, M && value) {
+        auto result = do_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(K && key, M && value) {
+        auto result = do_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    // Si la clave ya estaba, try_emplace no hace nada (ni siquiera consume
+    // los argumentos); si no, construye el valor con args.
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K & key, Args &&... args) {
+        return do_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K && key, Args &&... args) {
+        return do_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Devuelve el valor asociado a key, agregándolo (construido por defecto)
+    // si la clave no estaba.
+
+    V & operator[](const K & key) {
+        return try_emplace(key).first->second;
+    }
+
+    V & operator[](K && key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    std::pair<bool, iterator> erase(const K & key) {
+        if (empty()) {
+            return { false, end() };
+        }
+        inner * path[max_height];
+        int slots[max_height];
+        leaf * l = find_leaf(key, path, slots);
+        int position = lower_position(l->keys, l->size, key);
+        if (position == l->size || m_cmp(key, l->keys[position])) {
+            return { false, end() };
+        }
+
+        std::move(l->keys + position + 1, l->keys + l->size, l->keys + position);
+        std::move(l->values + position + 1, l->values + l->size, l->values + position);
+        --l->size;
+        --m_size;
+        // Libera lo que tuviera el último lugar, que quedó sin usar
+        l->keys[l->size] = K();
+        l->values[l->size] = V();
+
+        // El siguiente elemento es el que quedó en position, aunque al
+        // rebalancear la hoja puede cambiar de lugar.
+        leaf * next_leaf = l;
+        int next_position = position;
+        if (m_height == 0) {
+            if (l->size == 0) {
+                delete l;
+                m_root = nullptr;
+                return { true, end() };
+            }
+        } else if (l->size < min_size) {
+            inner * parent = path[m_height - 1];
+            int slot = slots[m_height - 1];
+            if (slot > 0) {
+                leaf * sibling = static_cast<leaf *>(parent->children[slot - 1]);
+                if (sibling->size > min_size) {
+                    // Toma prestado el último elemento del hermano izquierdo
+                    std::move_backward(l->keys, l->keys + l->size, l->keys + l->size + 1);
+                    std::move_backward(l->values, l->values + l->size, l->values + l->size + 1);
+                    --sibling->size;
+                    l->keys[0] = std::move(sibling->keys[sibling->size]);
+                    l->values[0] = std::move(sibling->values[sibling->size]);
+                    ++l->size;
+                    parent->keys[slot - 1] = l->keys[0];
+                    ++next_position;
+                } else {
+                    // Pasa todos sus elementos al hermano izquierdo
+                    std::move(l->keys, l->keys + l->size, sibling->keys + sibling->size);
+                    std::move(l->values, l->values + l->size, sibling->values + sibling->size);
+                    next_leaf = sibling;
+                    next_position += sibling->size;
+                    sibling->size += l->size;
+                    sibling->next = l->next;
+                    if (l->next != nullptr) {
+                        l->next->prev = sibling;
+                    }
+                    delete l;
+                    erase_child(parent, slot - 1);
+                }
+            } else {
+                leaf * sibling = static_cast<leaf *>(parent->children[slot + 1]);
+                if (sibling->size > min_size) {
+                    // Toma prestado el primer elemento del hermano derecho
+                    l->keys[l->size] = std::move(sibling->keys[0]);
+                    l->values[l->size] = std::move(sibling->values[0]);
+                    ++l->size;
+                    std::move(sibling->keys + 1, sibling->keys + sibling->size, sibling->keys);
+                    std::move(sibling->values + 1, sibling->values + sibling->size, sibling->values);
+                    --sibling->size;
+                    parent->keys[slot] = sibling->keys[0];
+                } else {
+                    // Se queda con todos los elementos del hermano derecho
+                    std::move(sibling->keys, sibling->keys + sibling->size, l->keys + l->size);
+                    std::move(sibling->values, sibling->values + sibling->size, l->values + l->size);
+                    l->size += sibling->size;
+                    l->next = sibling->next;
+                    if (sibling->next != nullptr) {
+                        sibling->next->prev = l;
+                    }
+                    delete sibling;
+                    erase_child(parent, slot);
+                }
+            }
+            rebalance_inner_nodes(path, slots);
+        }
+        return { true, make_iterator(next_leaf, next_position) };
+    }
+
+    void clear() {
+        if (m_root != nullptr) {
+            do_clear(m_root, m_height);
+        }
+        m_root = nullptr;
+        m_height = 0;
+        m_size = 0;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Devuelve un iterador a la posición indicada, pasando a la hoja
+    // siguiente si ésta es la última posición de la hoja.
+    iterator make_iterator(leaf * l, int position) {
+        if (position == l->size) {
+            return iterator(this, l->next, 0);
+        }
+        return iterator(this, l, position);
+    }
+
+    // Baja desde la raíz hasta la hoja donde está (o debería estar) key,
+    // guardando en path los nodos internos visitados y en slots el índice
+    // del hijo por el que siguió en cada uno. Precondición: !empty()
+    template <typename Key>
+    leaf * find_leaf(const Key & key, inner ** path, int * slots) {
+        node * current = m_root;
+        for (int level = 0; level < m_height; ++level) {
+            inner * n = static_cast<inner *>(current);
+            int slot = upper_position(n->keys, n->size, key);
+            path[level] = n;
+            slots[level] = slot;
+            current = n->children[slot];
+        }
+        return static_cast<leaf *>(current);
+    }
+
+    template <typename Key>
+    leaf * find_leaf(const Key & key) {
+        node * current = m_root;
+        for (int level = 0; level < m_height; ++level) {
+            inner * n = static_cast<inner *>(current);
+            current = n->children[upper_position(n->keys, n->size, key)];
+        }
+        return static_cast<leaf *>(current);
+    }
+
+    template <typename Key>
+    iterator do_find(const Key & key) {
+        if (empty()) {
+            return end();
+        }
+        leaf * l = find_leaf(key);
+        int position = lower_position(l->keys, l->size, key);
+        if (position == l->size || m_cmp(key, l->keys[position])) {
+            return end();
+        }
+        return iterator(this, l, position);
+    }
+
+    template <typename Key>
+    iterator find_bound(const Key & key, bool strict) {
+        if (empty()) {
+            return end();
+        }
+        leaf * l = find_leaf(key);
+        int position = strict ? upper_position(l->keys, l->size, key) : lower_position(l->keys, l->size, key);
+        return make_iterator(l, position);
+    }
+
+    // Posición de la primera de las n claves que no es menor a key
+    template <typename Key>
+    int lower_position(const K * keys, int n, const Key & key) {
+        return search(keys, n, key, false, use_linear_search<Key>());
+    }
+
+    // Posición de la primera de las n claves que es mayor a key
+    template <typename Key>
+    int upper_position(const K * keys, int n, const Key & key) {
+        return search(keys, n, key, true, use_linear_search<Key>());
+    }
+
+    template <typename Key>
+    using use_linear_search = std::integral_constant<bool, linear_search::value && std::is_same<Key, K>::value>;
+
+    template <typename Key>
+    int search(const K * keys, int n, const Key & key, bool strict, std::false_type) {
+        int low = 0;
+        int high = n;
+        while (low < high) {
+            int middle = (low + high) / 2;
+            bool before = strict ? !m_cmp(key, keys[middle]) : m_cmp(keys[middle], key);
+            if (before) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    int search(const K * keys, int n, const K & key, bool strict, std::true_type) {
+        return count_before(keys, n, key, strict);
+    }
+
+    // Cuenta las claves menores a key (o menores o iguales si strict es
+    // true). Es O(n) en lugar de O(log n), pero no tiene saltos condicionales
+    // y el compilador puede vectorizarlo.
+    template <typename T>
+    static int count_before(const T * keys, int n, T key, bool strict) {
+        int count = 0;
+        if (strict) {
+            for (int i = 0; i < n; ++i) {
+                count += !(key < keys[i]);
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                count += keys[i] < key;
+            }
+        }
+        return count;
+    }
+
+#ifdef __SSE2__
+    // Con enteros de 32 bits compara 4 claves por instrucción
+    static int count_before(const std::int32_t * keys, int n, std::int32_t key, bool strict) {
+        __m128i pivot = _mm_set1_epi32(key);
+        int count = 0;
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+            __m128i before = strict ? _mm_cmpgt_epi32(pivot, block) : _mm_cmplt_epi32(block, pivot);
+            if (strict) {
+                before = _mm_or_si128(before, _mm_cmpeq_epi32(block, pivot));
+            }
+            count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(before)));
+        }
+        for (; i < n; ++i) {
+            count += strict ? keys[i] <= key : keys[i] < key;
+        }
+        return count;
+    }
+#endif
+
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> do_emplace(Key && key, Args &&... args) {
+        if (empty()) {
+            m_root = new_leaf();
+        }
+        inner * path[max_height];
+        int slots[max_height];
+        leaf * l = find_leaf(key, path, slots);
+        int position = lower_position(l->keys, l->size, key);
+        if (position < l->size && !m_cmp(key, l->keys[position])) {
+            return { iterator(this, l, position), false };
+        }
+
+        if (l->size == capacity) {
+            // Parte la hoja por la mitad y agrega la nueva hoja al padre
+            leaf * right = new_leaf();
+            std::move(l->keys + min_size, l->keys + capacity, right->keys);
+            std::move(l->values + min_size, l->values + capacity, right->values);
+            right->size = capacity - min_size;
+            l->size = min_size;
+            right->prev = l;
+            right->next = l->next;
+            if (l->next != nullptr) {
+                l->next->prev = right;
+            }
+            l->next = right;
+            insert_child(path, slots, right->keys[0], right);
+            if (position > l->size) {
+                position -= l->size;
+                l = right;
+            }
+        }
+
+        std::move_backward(l->keys + position, l->keys + l->size, l->keys + l->size + 1);
+        std::move_backward(l->values + position, l->values + l->size, l->values + l->size + 1);
+        l->keys[position] = K(std::forward<Key>(key));
+        l->values[position] = V(std::forward<Args>(args)...);
+        ++l->size;
+        ++m_size;
+        return { iterator(this, l, position), true };
+    }
+
+    // Agrega child a la derecha del último nodo del camino, con separator
+    // como clave separadora. Los nodos llenos se parten y suben su clave del
+    // medio al padre; si se parte la raíz, el árbol crece un nivel.
+    void insert_child(inner ** path, const int * slots, K separator, node * child) {
+        for (int level = m_height - 1; level >= 0; --level) {
+            inner * n = path[level];
+            int slot = slots[level];
+            if (n->size < capacity) {
+                std::move_backward(n->keys + slot, n->keys + n->size, n->keys + n->size + 1);
+                std::copy_backward(n->children + slot + 1, n->children + n->size + 1, n->children + n->size + 2);
+                n->keys[slot] = std::move(separator);
+                n->children[slot + 1] = child;
+                ++n->size;
+                return;
+            }
+
+            // Arma la secuencia completa con la nueva clave y la reparte
+            // en partes iguales, subiendo la clave del medio.
+            K keys[capacity + 1];
+            node * children[capacity + 2];
+            std::move(n->keys, n->keys + slot, keys);
+            keys[slot] = std::move(separator);
+            std::move(n->keys + slot, n->keys + capacity, keys + slot + 1);
+            std::copy(n->children, n->children + slot + 1, children);
+            children[slot + 1] = child;
+            std::copy(n->children + slot + 1, n->children + capacity + 1, children + slot + 2);
+
+            inner * right = new inner;
+            std::move(keys, keys + min_size, n->keys);
+            std::copy(children, children + min_size + 1, n->children);
+            n->size = min_size;
+            std::move(keys + min_size + 1, keys + capacity + 1, right->keys);
+            std::copy(children + min_size + 1, children + capacity + 2, right->children);
+            right->size = capacity - min_size;
+
+            separator = std::move(keys[min_size]);
+            child = right;
+        }
+
+        inner * root = new inner;
+        root->size = 1;
+        root->keys[0] = std::move(separator);
+        root->children[0] = m_root;
+        root->children[1] = child;
+        m_root = root;
+        ++m_height;
+    }
+
+    // Quita de n la clave i y el hijo que está a su derecha
+    void erase_child(inner * n, int i) {
+        std::move(n->keys + i + 1, n->keys + n->size, n->keys + i);
+        std::copy(n->children + i + 2, n->children + n->size + 1, n->children + i + 1);
+        --n->size;
+    }
+
+    // Sube por el camino de nodos internos que llevó a una hoja de la que se
+    // borró un elemento, pidiendo prestado a un hermano o fusionándose con él
+    // mientras queden nodos con menos de min_size claves.
+    void rebalance_inner_nodes(inner ** path, const int * slots) {
+        for (int level = m_height - 1; level > 0 && path[level]->size < min_size; --level) {
+            inner * n = path[level];
+            inner * parent = path[level - 1];
+            int slot = slots[level - 1];
+            if (slot > 0) {
+                inner * sibling = static_cast<inner *>(parent->children[slot - 1]);
+                if (sibling->size > min_size) {
+                    // Rota una clave desde el hermano izquierdo pasando por el padre
+                    std::move_backward(n->keys, n->keys + n->size, n->keys + n->size + 1);
+                    std::copy_backward(n->children, n->children + n->size + 1, n->children + n->size + 2);
+                    n->keys[0] = std::move(parent->keys[slot - 1]);
+                    n->children[0] = sibling->children[sibling->size];
+                    parent->keys[slot - 1] = std::move(sibling->keys[sibling->size - 1]);
+                    --sibling->size;
+                    ++n->size;
+                    return;
+                }
+                sibling->keys[sibling->size] = std::move(parent->keys[slot - 1]);
+                std::move(n->keys, n->keys + n->size, sibling->keys + sibling->size + 1);
+                std::copy(n->children, n->children + n->size + 1, sibling->children + sibling->size + 1);
+                sibling->size += n->size + 1;
+                delete n;
+                erase_child(parent, slot - 1);
+            } else {
+                inner * sibling = static_cast<inner *>(parent->children[slot + 1]);
+                if (sibling->size > min_size) {
+                    // Rota una clave desde el hermano derecho pasando por el padre
+                    n->keys[n->size] = std::move(parent->keys[slot]);
+                    n->children[n->size + 1] = sibling->children[0];
+                    parent->keys[slot] = std::move(sibling->keys[0]);
+                    std::move(sibling->keys + 1, sibling->keys + sibling->size, sibling->keys);
+                    std::copy(sibling->children + 1, sibling->children + sibling->size + 1, sibling->children);
+                    --sibling->size;
+                    ++n->size;
+                    return;
+                }
+                n->keys[n->size] = std::move(parent->keys[slot]);
+                std::move(sibling->keys, sibling->keys + sibling->size, n->keys + n->size + 1);
+                std::copy(sibling->children, sibling->children + sibling->size + 1, n->children + n->size + 1);
+                n->size += sibling->size + 1;
+                delete sibling;
+                erase_child(parent, slot);
+            }
+        }
+
+        // Una raíz interna sin claves tiene un único hijo, que pasa a ser la raíz
+        if (m_height > 0 && m_root->size == 0) {
+            inner * root = static_cast<inner *>(m_root);
+            m_root = root->children[0];
+            delete root;
+            --m_height;
+        }
+    }
+
+    // Precondición: !empty()
+    leaf * last_leaf() {
+        node * current = m_root;
+        for (int level = 0; level < m_height; ++level) {
+            inner * n = static_cast<inner *>(current);
+            current = n->children[n->size];
+        }
+        return static_cast<leaf *>(current);
+    }
+
+    leaf * new_leaf() {
+        leaf * l = new leaf;
+        l->size = 0;
+        l->prev = l->next = nullptr;
+        return l;
+    }
+
+    // Copia el subárbol con raíz en other, que tiene height niveles de nodos
+    // internos, enlazando cada hoja copiada con la anterior (last).
+    node * copy_nodes(const node * other, int height, leaf * & last) {
+        if (height == 0) {
+            const leaf * other_leaf = static_cast<const leaf *>(other);
+            leaf * l = new_leaf();
+            std::copy(other_leaf->keys, other_leaf->keys + other_leaf->size, l->keys);
+            std::copy(other_leaf->values, other_leaf->values + other_leaf->size, l->values);
+            l->size = other_leaf->size;
+            l->prev = last;
+            if (last != nullptr) {
+                last->next = l;
+            }
+            last = l;
+            return l;
+        }
+        const inner * other_inner = static_cast<const inner *>(other);
+        inner * n = new inner;
+        std::copy(other_inner->keys, other_inner->keys + other_inner->size, n->keys);
+        for (int i = 0; i <= other_inner->size; ++i) {
+            n->children[i] = copy_nodes(other_inner->children[i], height - 1, last);
+        }
+        n->size = other_inner->size;
+        return n;
+    }
+
+    // La recursión no es un problema: la altura de un árbol B es muy baja
+    void do_clear(node * current, int height) {
+        if (height == 0) {
+            delete static_cast<leaf *>(current);
+        } else {
+            inner * n = static_cast<inner *>(current);
+            for (int i = 0; i <= n->size; ++i) {
+                do_clear(n->children[i], height - 1);
+            }
+            delete n;
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+public:
+
+    // Éste método genera una representación del árbol usando caracteres
+    // ASCII, con un renglón por nivel y las claves de cada nodo entre [].
+    std::string str() const {
+        std::string result;
+        std::vector<const node *> level;
+        if (m_root != nullptr) {
+            level.push_back(m_root);
+        }
+        for (int height = m_height; !level.empty(); --height) {
+            std::ostringstream s;
+            std::vector<const node *> next_level;
+            for (const node * current : level) {
+                const K * keys;
+                if (height == 0) {
+                    keys = static_cast<const leaf *>(current)->keys;
+                } else {
+                    const inner * n = static_cast<const inner *>(current);
+                    keys = n->keys;
+                    next_level.insert(next_level.end(), n->children, n->children + n->size + 1);
+                }
+                s << "[";
+                for (int i = 0; i < current->size; ++i) {
+                    s << (i > 0 ? " " : "") << keys[i];
+                }
+                s << "] ";
+            }
+            result += s.str();
+            result += '\n';
+            level.swap(next_level);
+        }
+        return result;
+    }
+};
+
+#endif // BTREE_MAP_H
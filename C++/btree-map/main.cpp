@@ -0,0 +1,125 @@
+#include "btree_map.h"
+#include "../avl-as-map/avl_map.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename K, typename V, typename C>
+ostream & operator<<(ostream & out, btree_map<K, V, C> & t) {
+    out << "btree_map { ";
+    for (const auto & x : t) {
+        out << x.first << ":" << x.second << " ";
+    }
+    out << "}";
+    return out;
+}
+
+void show_key_value(const int & k, string & v) {
+    cout << k << ":" << v << ' ';
+}
+
+// Mide las operaciones básicas sobre un mapa de enteros (el árbol AVL o el
+// árbol B) y devuelve una suma de control para comparar los resultados.
+template <typename Map>
+long long benchmark(const string & name, const vector<int> & keys) {
+    Map m;
+    long long checksum = 0;
+    double insert_time = measure([&] {
+        for (int k : keys)
+            m.insert(k, k);
+    });
+    double find_time = measure([&] {
+        for (int k : keys)
+            checksum += m.find(k)->second;
+    });
+    double scan_time = measure([&] {
+        for (int i = 0; i < 10; ++i)
+            m.each([&](const int & k, int & v) { checksum += k ^ v; });
+    });
+    double erase_time = measure([&] {
+        for (int k : keys)
+            checksum += m.erase(k).first;
+    });
+    cout << "  " << name << ": insert " << insert_time << " s, find " << find_time
+         << " s, 10 recorridos " << scan_time << " s, erase " << erase_time << " s" << endl;
+    return checksum;
+}
+
+int main() {
+    btree_map<int, string> t1;
+
+    for (const auto & x: { 5, 3, 7, 1, 4, 2, 6, 0, 8 })
+        t1.insert(x, "[" + to_string(x) + "]");
+
+    cout << "t1 = " << t1 << endl;
+    cout << "Graficando t1:" << endl;
+    cout << t1.str();
+
+    cout << endl << "Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "t2 = " << t2 << endl;
+
+    cout << endl << "Haciendo más inserciones en t1:" << endl;
+    t1.insert(5, "a");
+    t1.insert(9, "b");
+    t1.insert(5, "c");
+
+    cout << "t1 = " << t1 << endl;
+    cout << "¿t1 == t2? " << boolalpha << (t1 == t2) << endl;
+
+    cout << "¿t1 contiene a 5? " << boolalpha << t1.contains(5) << endl;
+    cout << "¿t1 contiene a 42? " << boolalpha << t1.contains(42) << endl;
+
+    auto p = t1.find(7);
+    if (p != end(t1)) {
+        cout << "El valor asociado a " << p->first << " es: " << p->second << endl;
+        p->second = "z";
+    }
+
+    cout << "Borrando un 5 => " << t1.erase(5).first << endl;
+    cout << "Borrando un 42 => " << t1.erase(42).first << endl;
+    cout << "t1 = " << t1 << endl;
+
+    cout << "Mínimo de t1 => " << t1.minimum()->first << endl;
+    cout << "Máximo de t1 => " << t1.maximum()->first << endl;
+    cout << "Las tres claves más grandes de t1 => ";
+    int shown = 0;
+    for (auto p = t1.rbegin(); p != t1.rend() && shown < 3; ++p, ++shown) {
+        cout << (*p).first << " ";
+    }
+    cout << endl << endl;
+
+    cout << "Recorriendo t2 con each():" << endl;
+    cout << "t2 = btree_map { ";
+    t2.each(show_key_value);
+    cout << "}" << endl;
+
+    cout << endl << "Insertando en t3 claves de texto del 1 al 40 (8 claves por nodo):" << endl;
+    btree_map<string, int, less<>> t3;
+    for (int x = 1; x < 41; ++x)
+        t3[to_string(x)] = x;
+    cout << t3.str();
+
+    cout << "Primera clave no menor a \"35\" => " << t3.lower_bound("35")->first << endl;
+    cout << "Primera clave mayor a \"35\" => " << t3.upper_bound("35")->first << endl;
+
+    cout << "Borrando las claves pares:" << endl;
+    for (int x = 2; x < 41; x += 2)
+        t3.erase(to_string(x));
+    cout << t3.str();
+    cout << "Cantidad de elementos de t3 => " << t3.size() << endl;
+
+    cout << endl << "Comparando con el árbol AVL (1000000 claves enteras al azar):" << endl;
+    vector<int> keys(1000000);
+    mt19937 rng(42);
+    for (auto & k : keys)
+        k = int(rng());
+    long long avl = benchmark<tree<int, int>>("árbol AVL", keys);
+    long long btree = benchmark<btree_map<int, int>>("árbol B+ ", keys);
+    cout << "  ¿mismos resultados? " << boolalpha << (avl == btree) << endl;
+}
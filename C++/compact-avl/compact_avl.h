@@ -0,0 +1,700 @@
+#ifndef COMPACT_AVL_H
+#define COMPACT_AVL_H
+
+#include <cstddef>    // Para std::size_t
+#include <cstdint>    // Para std::uint32_t
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <utility>    // Para std::move, std::pair y std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/******* Árbol AVL compacto: nodos contiguos enlazados con índices de 32 bits *******/
+/************************************************************************************/
+
+// En lugar de pedir cada nodo por separado con new, todos los nodos viven en
+// un único vector y se enlazan con índices de 32 bits. Cada enlace reserva su
+// bit más alto para indicar si ese lado es el más alto del nodo, así que el
+// factor de balance no ocupa lugar extra. Tampoco hay enlace al padre: insert
+// y erase recuerdan el camino recorrido y el iterador lo guarda en una pila.
+//
+// Para T = int cada nodo ocupa 12 bytes en lugar de los 40 del árbol AVL con
+// punteros, y al estar todos juntos en memoria hay menos fallos de caché al
+// recorrer el árbol. Al borrar, el último nodo del vector se mueve al lugar
+// liberado para que el vector no tenga huecos.
+
+template <typename T>
+class compact_tree {
+    using index = std::uint32_t;
+
+    static const index taller_bit = index(1) << 31;
+    static const index index_mask = taller_bit - 1;
+    static const index nil = index_mask;
+
+    // Con menos de 2^31 nodos la altura de un árbol AVL es menor a 45
+    static const int max_height = 48;
+
+    struct node {
+        T value;
+        index link[2];  // [0] es el hijo izquierdo y [1] el derecho
+    };
+
+    std::vector<node> m_nodes;
+    index m_root;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    compact_tree() {
+        m_root = nil;
+    }
+
+    // Copiar sólo copia el vector de nodos: no hace falta recorrer el árbol
+    compact_tree(const compact_tree & x) {
+        m_nodes = x.m_nodes;
+        m_root = x.m_root;
+    }
+
+    compact_tree(compact_tree && x) {
+        m_nodes = std::move(x.m_nodes);
+        m_root = x.m_root;
+        x.m_nodes.clear();
+        x.m_root = nil;
+    }
+
+    compact_tree & operator=(compact_tree x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(compact_tree & x, compact_tree & y) {
+        using namespace std;
+        swap(x.m_nodes, y.m_nodes);
+        swap(x.m_root, y.m_root);
+    }
+
+    /************************************************************************/
+    /********** ITERADOR CON PILA QUE RECORRE AL ÁRBOL EN ORDEN *************/
+    /************************************************************************/
+
+    // Los valores no pueden modificarse a través del iterador porque eso
+    // podría romper el orden del árbol. El iterador se invalida si se modifica
+    // el árbol sobre el que se obtuvo.
+    class iterator {
+    private:
+        const compact_tree * m_tree;
+        index m_path[max_height];
+        int m_size;
+
+        friend class compact_tree;
+
+        void push_minimum(index current) {
+            while (current != nil) {
+                m_path[m_size++] = current;
+                current = m_tree->child(current, 0);
+            }
+        }
+
+        void push_maximum(index current) {
+            while (current != nil) {
+                m_path[m_size++] = current;
+                current = m_tree->child(current, 1);
+            }
+        }
+
+    public:
+        using value_type = T;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(const compact_tree * tree = nullptr) {
+            m_tree = tree;
+            m_size = 0;
+        }
+
+        reference operator*() {
+            // Precondición: m_size > 0
+            return m_tree->m_nodes[m_path[m_size - 1]].value;
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            if (x.m_size == 0 || y.m_size == 0) {
+                return x.m_size == y.m_size;
+            }
+            return x.m_path[x.m_size - 1] == y.m_path[y.m_size - 1];
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: m_size > 0
+            index right = m_tree->child(m_path[m_size - 1], 1);
+            if (right != nil) {
+                push_minimum(right);
+            } else {
+                index prev;
+                do {
+                    prev = m_path[--m_size];
+                } while (m_size > 0 && m_tree->child(m_path[m_size - 1], 1) == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        // end() tiene la pila vacía, así que retroceder desde ahí es bajar
+        // desde la raíz hasta el máximo
+        iterator & operator--() {
+            // Precondición: *this != m_tree->begin()
+            if (m_size == 0) {
+                push_maximum(m_tree->m_root);
+                return *this;
+            }
+            index left = m_tree->child(m_path[m_size - 1], 0);
+            if (left != nil) {
+                push_maximum(left);
+            } else {
+                index prev;
+                do {
+                    prev = m_path[--m_size];
+                } while (m_tree->child(m_path[m_size - 1], 0) == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() const {
+        iterator result(this);
+        result.push_minimum(m_root);
+        return result;
+    }
+
+    iterator end() const {
+        return iterator(this);
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() const {
+        return m_root == nil;
+    }
+
+    std::size_t size() const {
+        return m_nodes.size();
+    }
+
+    // Cantidad de bytes reservados para los nodos
+    std::size_t memory_usage() const {
+        return m_nodes.capacity() * sizeof(node);
+    }
+
+    friend
+    bool operator==(const compact_tree & x, const compact_tree & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(const compact_tree & x, const compact_tree & y) {
+        return !(x == y);
+    }
+
+    iterator find(const T & value) const {
+        iterator result(this);
+        index current = m_root;
+        while (current != nil) {
+            result.m_path[result.m_size++] = current;
+            if (value < m_nodes[current].value) {
+                current = child(current, 0);
+            } else if (value > m_nodes[current].value) {
+                current = child(current, 1);
+            } else {
+                return result;
+            }
+        }
+        return end();
+    }
+
+    // No usa find para no tener que armar el camino hasta el valor
+    bool contains(const T & value) const {
+        index current = m_root;
+        while (current != nil) {
+            if (value < m_nodes[current].value) {
+                current = child(current, 0);
+            } else if (value > m_nodes[current].value) {
+                current = child(current, 1);
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    iterator minimum() const {
+        return begin();
+    }
+
+    iterator maximum() const {
+        iterator result(this);
+        index current = m_root;
+        while (current != nil) {
+            result.m_path[result.m_size++] = current;
+            current = child(current, 1);
+        }
+        return result;
+    }
+
+    // Los recorridos le pasan a func los valores directamente desde el
+    // arreglo de nodos, sin armar iteradores.
+
+    template <typename F>
+    void each(F func) const {
+        visit_in_order([&](index n) { func(m_nodes[n].value); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) const {
+        return visit_in_order([&](index n) { return bool(func(m_nodes[n].value)); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) const {
+        visit_preorder([&](index n) { func(m_nodes[n].value); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) const {
+        visit_postorder([&](index n) { func(m_nodes[n].value); return true; });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    void reserve(std::size_t count) {
+        m_nodes.reserve(count);
+    }
+
+    // Precondición: size() < 2^31 - 1
+    iterator insert(const T & value) {
+        iterator result(this);
+        index * path = result.m_path;
+        int dirs[max_height];
+        int & size = result.m_size;
+
+        index current = m_root;
+        while (current != nil) {
+            path[size] = current;
+            if (value < m_nodes[current].value) {
+                dirs[size++] = 0;
+            } else if (value > m_nodes[current].value) {
+                dirs[size++] = 1;
+            } else {
+                ++size;
+                return result;
+            }
+            current = child(current, dirs[size - 1]);
+        }
+
+        index inserted = index(m_nodes.size());
+        m_nodes.push_back(node { value, { nil, nil } });
+        relink(path, dirs, size, inserted);
+
+        // Sube por el camino mientras el subárbol que creció haga crecer al
+        // de su padre. Una rotación deja al subárbol con la altura que tenía
+        // antes de insertar, así que después de rotar no hace falta seguir.
+        for (int k = size - 1; k >= 0; --k) {
+            index p = path[k];
+            int grown = dirs[k];
+            int heavy = taller_side(p);
+            if (heavy == -1) {
+                set_taller_side(p, grown);
+            } else if (heavy != grown) {
+                set_taller_side(p, -1);
+                break;
+            } else {
+                bool shrunk;
+                relink(path, dirs, k, rebalance(p, grown, shrunk));
+                // La rotación cambió el camino, así que se vuelve a buscar
+                return find(m_nodes[inserted].value);
+            }
+        }
+        path[size++] = inserted;
+        return result;
+    }
+
+    std::pair<bool, iterator> erase(const T & value) {
+        index path[max_height];
+        int dirs[max_height];
+        int size = 0;
+
+        index current = m_root;
+        while (current != nil && (value < m_nodes[current].value || value > m_nodes[current].value)) {
+            path[size] = current;
+            dirs[size] = value < m_nodes[current].value ? 0 : 1;
+            current = child(current, dirs[size++]);
+        }
+        if (current == nil) {
+            return { false, end() };
+        }
+
+        if (child(current, 0) != nil && child(current, 1) != nil) {
+            // Intercambia el valor con el de su predecesor (el máximo del
+            // subárbol izquierdo), que tiene a lo sumo un hijo, y borra a éste.
+            index removed = current;
+            path[size] = current;
+            dirs[size++] = 0;
+            current = child(current, 0);
+            while (child(current, 1) != nil) {
+                path[size] = current;
+                dirs[size++] = 1;
+                current = child(current, 1);
+            }
+            using std::swap;
+            swap(m_nodes[removed].value, m_nodes[current].value);
+        }
+        index only_child = child(current, 0) != nil ? child(current, 0) : child(current, 1);
+        relink(path, dirs, size, only_child);
+
+        // Sube por el camino mientras el subárbol que se achicó achique al de
+        // su padre. Una rotación puede o no achicar al subárbol rotado.
+        for (int k = size - 1; k >= 0; --k) {
+            index p = path[k];
+            int shrunk_side = dirs[k];
+            int heavy = taller_side(p);
+            if (heavy == -1) {
+                set_taller_side(p, 1 - shrunk_side);
+                break;
+            } else if (heavy == shrunk_side) {
+                set_taller_side(p, -1);
+            } else {
+                bool shrunk;
+                relink(path, dirs, k, rebalance(p, heavy, shrunk));
+                if (!shrunk) {
+                    break;
+                }
+            }
+        }
+
+        T removed_value = std::move(m_nodes[current].value);
+        release_node(current);
+        return { true, upper_bound(removed_value) };
+    }
+
+    void clear() {
+        m_nodes.clear();
+        m_root = nil;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    index child(index n, int side) const {
+        return m_nodes[n].link[side] & index_mask;
+    }
+
+    void set_child(index n, int side, index c) {
+        index & link = m_nodes[n].link[side];
+        link = (link & taller_bit) | c;
+    }
+
+    // Devuelve 0 si el subárbol izquierdo es más alto, 1 si lo es el derecho
+    // y -1 si ambos tienen la misma altura.
+    int taller_side(index n) const {
+        if (m_nodes[n].link[0] & taller_bit) {
+            return 0;
+        }
+        if (m_nodes[n].link[1] & taller_bit) {
+            return 1;
+        }
+        return -1;
+    }
+
+    void set_taller_side(index n, int side) {
+        for (int s = 0; s < 2; ++s) {
+            index & link = m_nodes[n].link[s];
+            link = (link & index_mask) | (s == side ? taller_bit : 0);
+        }
+    }
+
+    // Hace que el enlace que llevaba al nodo path[size] apunte a n
+    void relink(const index * path, const int * dirs, int size, index n) {
+        if (size == 0) {
+            m_root = n;
+        } else {
+            set_child(path[size - 1], dirs[size - 1], n);
+        }
+    }
+
+    // Rebalancea al subárbol con raíz en n, cuyo lado heavy es dos niveles
+    // más alto que el otro, y devuelve su nueva raíz. shrunk indica si el
+    // subárbol quedó más bajo que antes de rotar.
+    index rebalance(index n, int heavy, bool & shrunk) {
+        int light = 1 - heavy;
+        index c = child(n, heavy);
+        int child_heavy = taller_side(c);
+        if (child_heavy == light) {
+            index g = child(c, light);
+            int grandchild_heavy = taller_side(g);
+            set_child(c, light, child(g, heavy));
+            set_child(n, heavy, child(g, light));
+            set_child(g, heavy, c);
+            set_child(g, light, n);
+            set_taller_side(n, grandchild_heavy == heavy ? light : -1);
+            set_taller_side(c, grandchild_heavy == light ? heavy : -1);
+            set_taller_side(g, -1);
+            shrunk = true;
+            return g;
+        }
+        set_child(n, heavy, child(c, light));
+        set_child(c, light, n);
+        if (child_heavy == heavy) {
+            set_taller_side(n, -1);
+            set_taller_side(c, -1);
+            shrunk = true;
+        } else {
+            set_taller_side(n, heavy);
+            set_taller_side(c, light);
+            shrunk = false;
+        }
+        return c;
+    }
+
+    // Libera el lugar de un nodo ya desenganchado del árbol moviendo a él al
+    // último nodo del vector, cuyo enlace se busca a partir de su valor.
+    void release_node(index n) {
+        index last = index(m_nodes.size() - 1);
+        if (n != last) {
+            const T & value = m_nodes[last].value;
+            index parent = nil;
+            int side = 0;
+            index current = m_root;
+            while (current != last) {
+                parent = current;
+                side = value < m_nodes[current].value ? 0 : 1;
+                current = child(current, side);
+            }
+            m_nodes[n] = std::move(m_nodes[last]);
+            if (parent == nil) {
+                m_root = n;
+            } else {
+                set_child(parent, side, n);
+            }
+        }
+        m_nodes.pop_back();
+    }
+
+    iterator upper_bound(const T & value) const {
+        iterator result(this);
+        int size = 0;
+        index current = m_root;
+        while (current != nil) {
+            result.m_path[size++] = current;
+            if (value < m_nodes[current].value) {
+                result.m_size = size;
+                current = child(current, 0);
+            } else {
+                current = child(current, 1);
+            }
+        }
+        return result;
+    }
+
+    // Los recorridos usan una pila de tamaño fijo en lugar de recursión.
+    // visit recibe cada nodo y devuelve false para interrumpir el recorrido.
+
+    template <typename F>
+    bool visit_in_order(F visit) const {
+        index pending[max_height];
+        int size = 0;
+        index current = m_root;
+        while (current != nil || size > 0) {
+            while (current != nil) {
+                pending[size++] = current;
+                current = child(current, 0);
+            }
+            current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            current = child(current, 1);
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) const {
+        index pending[max_height];
+        int size = 0;
+        if (m_root != nil) {
+            pending[size++] = m_root;
+        }
+        while (size > 0) {
+            index current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            if (child(current, 1) != nil) {
+                pending[size++] = child(current, 1);
+            }
+            if (child(current, 0) != nil) {
+                pending[size++] = child(current, 0);
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) const {
+        index pending[max_height];
+        int size = 0;
+        index current = m_root;
+        index last = nil;
+        while (current != nil || size > 0) {
+            if (current != nil) {
+                pending[size++] = current;
+                current = child(current, 0);
+            } else {
+                index top = pending[size - 1];
+                index right = child(top, 1);
+                if (right != nil && right != last) {
+                    current = right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    --size;
+                }
+            }
+        }
+        return true;
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla
+    void calculate_nodes_placement(index current, int & x, int h, nodes_placement & placements) const {
+        if (current != nil) {
+            calculate_nodes_placement(child(current, 0), x, h+1, placements);
+            placements.emplace_back(h, x++, &m_nodes[current]);
+            calculate_nodes_placement(child(current, 1), x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_root, count, 0, placements);
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << the_node->value;
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // COMPACT_AVL_H
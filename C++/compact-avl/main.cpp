@@ -0,0 +1,111 @@
+#include "compact_avl.h"
+#include "../avl/avl.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+ostream & operator<<(ostream & out, const compact_tree<T> & t) {
+    out << "compact_tree { ";
+    for (const auto & x : t) {
+        out << x << " ";
+    }
+    out << "}" << endl << t.str();
+    return out;
+}
+
+void show_int(int v) {
+    cout << v << ' ';
+}
+
+int main() {
+    cout << ":: Creando t1 vacío." << endl;
+    compact_tree<int> t1;
+
+    cout << "  t1 = " << t1 << endl;
+
+    for (const auto & x: { 5, 3, 7, 1, 4, 2, 6, 0, 8 }) {
+        cout << ":: Insertando " << x << " en t1 " << endl;
+        t1.insert(x);
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << ":: Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "  t2 = " << t2 << endl;
+
+    cout << ":: Haciendo más inserciones en t1: 5, 9, 5" << endl;
+    t1.insert(5);
+    t1.insert(9);
+    t1.insert(5);
+
+    cout << "  t1 = " << t1 << endl;
+    cout << ":: ¿t1 == t2? " << boolalpha << (t1 == t2) << endl;
+    cout << ":: Cantidad de elementos de t1 => " << t1.size() << endl;
+
+    cout << ":: ¿t1 contiene a 5? " << boolalpha << t1.contains(5) << endl;
+    cout << ":: ¿t1 contiene a 42? " << boolalpha << t1.contains(42) << endl;
+
+    auto p = t1.find(7);
+    if (p != t1.end()) {
+        cout << "  Lo encontré! El valor es " << *p;
+        ++p;
+        cout << " y el siguiente es " << *p << endl;
+    }
+
+    cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
+    cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+
+    cout << ":: Recorriendo t1 al revés =>";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p)
+        cout << ' ' << *p;
+    cout << endl;
+
+    for (int x : {5, 42}) {
+        cout << ":: Borrando un " << x << " en t1 => " << t1.erase(x).first << endl;
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << ":: Recorriendo t1 con each():" << endl;
+    cout << "  t1 = compact_tree { ";
+    t1.each(show_int);
+    cout << "}" << endl;
+
+    for (auto q = t1.begin(); q != t1.end(); ) {
+        cout << ":: Borrando un " << *q << " en t1 => ";
+        auto result = t1.erase(*q);
+        cout << result.first << endl;
+        q = result.second;
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << endl << ":: Comparando con el árbol AVL con punteros (1000000 enteros al azar):" << endl;
+    const int n = 1000000;
+    vector<int> values(n);
+    mt19937 rng(42);
+    for (auto & x : values) {
+        x = int(rng() % (4 * n));
+    }
+
+    tree<int> pointers;
+    compact_tree<int> compact;
+    compact.reserve(n);
+    double pointers_insert = measure([&] { for (int x : values) pointers.insert(x); });
+    double compact_insert = measure([&] { for (int x : values) compact.insert(x); });
+
+    int found = 0;
+    double pointers_find = measure([&] { for (int x : values) found += pointers.contains(x + 1); });
+    double compact_find = measure([&] { for (int x : values) found -= compact.contains(x + 1); });
+
+    // En el árbol con punteros cada nodo tiene el valor, tres punteros y la
+    // altura, más lo que agrega el administrador de memoria en cada new.
+    cout << "  bytes por valor (compacto): " << compact.memory_usage() / compact.size() << endl;
+    cout << "  inserción: punteros " << pointers_insert << " s, compacto " << compact_insert << " s" << endl;
+    cout << "  búsqueda:  punteros " << pointers_find << " s, compacto " << compact_find << " s" << endl;
+    cout << "  ¿mismos resultados? " << boolalpha << (found == 0) << endl;
+}
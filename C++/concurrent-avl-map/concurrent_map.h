@@ -0,0 +1,638 @@
+#ifndef CONCURRENT_MAP_H
+#define CONCURRENT_MAP_H
+
+#include <algorithm>  // Para std::max
+#include <atomic>     // Para std::atomic
+#include <cstddef>    // Para std::size_t
+#include <cstdint>    // Para std::uint64_t
+#include <functional> // Para std::hash
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <mutex>      // Para std::mutex y std::lock_guard
+#include <thread>     // Para std::this_thread
+#include <utility>    // Para std::pair y std::move
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el mapa  ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/******** Mapa asociativo (árbol AVL) con lecturas concurrentes sin bloqueos ********/
+/************************************************************************************/
+
+// Los lectores nunca toman un lock ni escriben en memoria compartida con otros
+// lectores: recorren el árbol a partir de la raíz publicada en m_root. Los
+// escritores se turnan con un mutex y nunca modifican un nodo publicado: como
+// en persistent_map, crean copias de los nodos del camino modificado y al
+// final publican la nueva raíz de forma atómica.
+//
+// Los nodos reemplazados no pueden liberarse enseguida porque algún lector
+// podría estar recorriéndolos. Para saber cuándo es seguro, se usan épocas:
+// cada lectura anota en una de las ranuras de m_slots la época global vigente
+// al empezar, y cada escritura retira los nodos reemplazados con la época
+// vigente y después la incrementa. Un nodo retirado en la época e se libera
+// cuando ninguna ranura tiene anotada una época menor o igual a e, porque
+// entonces todas las lecturas en curso empezaron después de que dejó de ser
+// alcanzable desde la raíz.
+//
+// Las lecturas se hacen a través de un snapshot, que anota la época mientras
+// existe y ofrece find, contains, iteradores y each sobre una versión fija del
+// mapa. Mientras exista un snapshot no se libera ningún nodo retirado después
+// de crearlo, así que conviene que duren poco.
+
+template <typename K, typename V>
+class concurrent_map {
+public:
+    using value_type = std::pair<const K, V>;
+
+private:
+    struct node {
+        value_type data;
+        const node * left;
+        const node * right;
+        int height;
+        std::uint64_t version;  // Escritura en la que se creó
+
+        const node * find_minimum() const {
+            const node * minimum = this;
+            while (minimum->left != nullptr) {
+                minimum = minimum->left;
+            }
+            return minimum;
+        }
+    };
+
+    static const std::size_t cache_line = 64;
+
+    // Cada ranura ocupa una línea de caché entera (y empieza al principio de
+    // una) para que los lectores de distintos hilos no escriban en la misma
+    // línea.
+    struct alignas(cache_line) slot {
+        std::atomic<std::uint64_t> epoch;   // 0 si está libre
+    };
+
+    static const int max_readers = 128;
+
+    // m_root y m_epoch, que leen todos los hilos en cada acceso, van en una
+    // línea propia: así lo que escriben los lectores en sus ranuras no la
+    // invalida. Esto vale mientras el mapa no se cree con new, que antes de
+    // C++17 no respeta alineaciones mayores a la de std::max_align_t.
+    alignas(cache_line) std::atomic<const node *> m_root;
+    std::atomic<std::uint64_t> m_epoch;
+    mutable slot m_slots[max_readers];
+
+    // Sólo los usa quien tiene tomado m_writer
+    std::mutex m_writer;
+    std::uint64_t m_version;
+    std::vector<const node *> m_replaced;
+    std::vector<std::pair<std::uint64_t, const node *>> m_retired;
+
+public:
+
+    /************************************************************************/
+    /************************ CONSTRUCTOR Y DESTRUCTOR **********************/
+    /************************************************************************/
+
+    concurrent_map() {
+        m_root = nullptr;
+        m_epoch = 1;
+        m_version = 0;
+        for (auto & s : m_slots) {
+            s.epoch = 0;
+        }
+    }
+
+    concurrent_map(const concurrent_map &) = delete;
+    concurrent_map & operator=(const concurrent_map &) = delete;
+
+    // Precondición: no quedan snapshots ni escrituras en curso
+    ~concurrent_map() {
+        do_clear(m_root.load());
+        for (const auto & retired : m_retired) {
+            delete retired.second;
+        }
+    }
+
+    /************************************************************************/
+    /********** SNAPSHOT: VERSIÓN FIJA DEL MAPA PARA LEER SIN LOCKS *********/
+    /************************************************************************/
+
+    class iterator;
+
+    class snapshot {
+    private:
+        std::atomic<std::uint64_t> * m_slot;
+        const node * m_root;
+
+        friend class concurrent_map;
+
+        snapshot(std::atomic<std::uint64_t> * a_slot, const node * root) {
+            m_slot = a_slot;
+            m_root = root;
+        }
+
+    public:
+        snapshot(snapshot && x) {
+            m_slot = x.m_slot;
+            m_root = x.m_root;
+            x.m_slot = nullptr;
+        }
+
+        snapshot(const snapshot &) = delete;
+        snapshot & operator=(const snapshot &) = delete;
+
+        ~snapshot() {
+            if (m_slot != nullptr) {
+                m_slot->store(0, std::memory_order_release);
+            }
+        }
+
+        iterator begin() const {
+            iterator result(m_root);
+            result.push_minimum(m_root);
+            return result;
+        }
+
+        iterator end() const {
+            return iterator(m_root);
+        }
+
+        std::reverse_iterator<iterator> rbegin() const {
+            return std::reverse_iterator<iterator>(end());
+        }
+
+        std::reverse_iterator<iterator> rend() const {
+            return std::reverse_iterator<iterator>(begin());
+        }
+
+        bool empty() const {
+            return m_root == nullptr;
+        }
+
+        iterator find(const K & key) const {
+            iterator result(m_root);
+            const node * current = m_root;
+            while (current != nullptr) {
+                result.m_path.push_back(current);
+                if (key < current->data.first) {
+                    current = current->left;
+                } else if (key > current->data.first) {
+                    current = current->right;
+                } else {
+                    return result;
+                }
+            }
+            return end();
+        }
+
+        bool contains(const K & key) const {
+            const node * current = m_root;
+            while (current != nullptr) {
+                if (key < current->data.first) {
+                    current = current->left;
+                } else if (key > current->data.first) {
+                    current = current->right;
+                } else {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        iterator minimum() const {
+            return begin();
+        }
+
+        iterator maximum() const {
+            iterator result(m_root);
+            for (const node * current = m_root; current != nullptr; current = current->right) {
+                result.m_path.push_back(current);
+            }
+            return result;
+        }
+
+        template <typename F>
+        void each(F func) const {
+            for (auto p = begin(); p != end(); ++p) {
+                func(p->first, p->second);
+            }
+        }
+
+    private:
+
+        /********************************************************************/
+        /************ AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P ************/
+        /********************************************************************/
+
+        using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+
+        // Calcula la posición de los nodos para poder mostrarlos en pantalla
+        void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+            if (current != nullptr) {
+                calculate_nodes_placement(current->left, x, h+1, placements);
+                placements.emplace_back(h, x++, current);
+                calculate_nodes_placement(current->right, x, h+1, placements);
+            }
+        }
+
+    public:
+
+        // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+        std::string str() const {
+            int count = 0;
+            nodes_placement placements;
+            calculate_nodes_placement(m_root, count, 0, placements);
+
+            const int node_value_size = 3;
+            std::vector<std::string> lines;
+            int prev_level = -1;
+            for (const auto & placement: placements) {
+                int level;
+                int pos;
+                const node * the_node;
+                std::tie(level, pos, the_node) = placement;
+
+                while (int(lines.size()) <= 2 * level) {
+                    lines.emplace_back();
+                }
+
+                std::ostringstream s;
+                int i = 2 * level;
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size) << the_node->data.first;
+                lines[i] += s.str();
+
+                if (prev_level != -1) {
+                    char c;
+                    if (prev_level < level) {
+                        i = 2 * prev_level + 1;
+                        c = '\\';
+                    } else {
+                        i = 2 * level + 1;
+                        c = '/';
+                    }
+
+                    s.str("");
+                    s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                    s << std::setw(node_value_size / 2) << c;
+                    lines[i] += s.str();
+                }
+                prev_level = level;
+            }
+
+            std::string result;
+            for (const auto & line: lines) {
+                result += line;
+                result += '\n';
+            }
+            return result;
+        }
+    };
+
+    // Iterador con pila, como el de persistent_map. Es válido mientras exista
+    // el snapshot del que se obtuvo.
+    class iterator {
+    private:
+        // La raíz del snapshot, para poder retroceder desde end()
+        const node * m_root;
+        std::vector<const node *> m_path;
+
+        friend class snapshot;
+
+        void push_minimum(const node * current) {
+            while (current != nullptr) {
+                m_path.push_back(current);
+                current = current->left;
+            }
+        }
+
+        void push_maximum(const node * current) {
+            while (current != nullptr) {
+                m_path.push_back(current);
+                current = current->right;
+            }
+        }
+
+    public:
+        using value_type = concurrent_map::value_type;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(const node * root = nullptr) : m_root(root) {
+        }
+
+        reference operator*() {
+            // Precondición: !m_path.empty()
+            return m_path.back()->data;
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            if (x.m_path.empty() || y.m_path.empty()) {
+                return x.m_path.empty() && y.m_path.empty();
+            }
+            return x.m_path.back() == y.m_path.back();
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: !m_path.empty()
+            const node * current = m_path.back();
+            if (current->right != nullptr) {
+                push_minimum(current->right);
+            } else {
+                const node * prev;
+                do {
+                    prev = m_path.back();
+                    m_path.pop_back();
+                } while (!m_path.empty() && m_path.back()->right == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        iterator & operator--() {
+            // Precondición: *this != begin()
+            if (m_path.empty()) {
+                push_maximum(m_root);
+                return *this;
+            }
+            const node * current = m_path.back();
+            if (current->left != nullptr) {
+                push_maximum(current->left);
+            } else {
+                const node * prev;
+                do {
+                    prev = m_path.back();
+                    m_path.pop_back();
+                } while (m_path.back()->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    // Anota la época vigente en una ranura libre (empezando por una que
+    // depende del hilo, para que cada hilo suela usar siempre la misma) y
+    // recién después lee la raíz.
+    snapshot read() const {
+        std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (;;) {
+            for (int i = 0; i < max_readers; ++i) {
+                std::atomic<std::uint64_t> & epoch = m_slots[(start + i) % max_readers].epoch;
+                std::uint64_t expected = 0;
+                if (epoch.load(std::memory_order_relaxed) == 0 &&
+                    epoch.compare_exchange_strong(expected, m_epoch.load())) {
+                    return snapshot(&epoch, m_root.load());
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    bool contains(const K & key) const {
+        return read().contains(key);
+    }
+
+    /************************************************************************/
+    /********* MÉTODOS QUE MODIFICAN AL MAPA (DE A UN ESCRITOR A LA VEZ) ****/
+    /************************************************************************/
+
+    // Si la clave ya estaba, reemplaza el valor asociado y devuelve false
+    bool insert(const K & key, const V & value) {
+        std::lock_guard<std::mutex> lock(m_writer);
+        ++m_version;
+        bool added = false;
+        publish(do_insert(m_root.load(), key, value, added));
+        return added;
+    }
+
+    bool erase(const K & key) {
+        std::lock_guard<std::mutex> lock(m_writer);
+        ++m_version;
+        bool erased = false;
+        const node * root = m_root.load();
+        const node * new_root = do_erase(root, key, erased);
+        if (erased) {
+            publish(new_root);
+        }
+        return erased;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(m_writer);
+        ++m_version;
+        std::vector<const node *> pending;
+        if (m_root.load() != nullptr) {
+            pending.push_back(m_root.load());
+        }
+        while (!pending.empty()) {
+            const node * current = pending.back();
+            pending.pop_back();
+            if (current->left != nullptr) {
+                pending.push_back(current->left);
+            }
+            if (current->right != nullptr) {
+                pending.push_back(current->right);
+            }
+            m_replaced.push_back(current);
+        }
+        publish(nullptr);
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Publica la nueva raíz, retira los nodos reemplazados con la época
+    // vigente, pasa a la época siguiente y libera lo que ya nadie puede ver.
+    void publish(const node * root) {
+        m_root.store(root);
+        std::uint64_t epoch = m_epoch.load();
+        for (const node * replaced : m_replaced) {
+            m_retired.emplace_back(epoch, replaced);
+        }
+        m_replaced.clear();
+        m_epoch.store(epoch + 1);
+
+        std::uint64_t oldest = epoch + 1;
+        for (const auto & s : m_slots) {
+            std::uint64_t reading = s.epoch.load();
+            if (reading != 0 && reading < oldest) {
+                oldest = reading;
+            }
+        }
+        std::size_t freed = 0;
+        while (freed < m_retired.size() && m_retired[freed].first < oldest) {
+            delete m_retired[freed].second;
+            ++freed;
+        }
+        m_retired.erase(m_retired.begin(), m_retired.begin() + freed);
+    }
+
+    // Un nodo que ya no se usa se libera enseguida si se creó en esta misma
+    // escritura (ningún lector pudo verlo) y se retira si ya estaba publicado.
+    void discard(const node * n) {
+        if (n->version == m_version) {
+            delete n;
+        } else {
+            m_replaced.push_back(n);
+        }
+    }
+
+    static int height(const node * a_node) {
+        return a_node == nullptr ? 0 : a_node->height;
+    }
+
+    const node * make_node(const value_type & data, const node * left, const node * right) {
+        int h = 1 + std::max(height(left), height(right));
+        return new node { data, left, right, h, m_version };
+    }
+
+    // Crea un nodo nuevo con data y los subárboles left y right, rotando si
+    // hace falta. Las rotaciones crean nodos nuevos en lugar de modificar los
+    // existentes y descartan a los que reemplazan.
+    const node * balance_tree(const value_type & data, const node * left, const node * right) {
+        int left_height = height(left);
+        int right_height = height(right);
+        const node * result;
+        if (left_height > right_height + 1) {
+            if (height(left->left) >= height(left->right)) {
+                result = make_node(left->data, left->left, make_node(data, left->right, right));
+            } else {
+                const node * pivot = left->right;
+                result = make_node(pivot->data,
+                                   make_node(left->data, left->left, pivot->left),
+                                   make_node(data, pivot->right, right));
+                discard(pivot);
+            }
+            discard(left);
+        } else if (right_height > left_height + 1) {
+            if (height(right->right) >= height(right->left)) {
+                result = make_node(right->data, make_node(data, left, right->left), right->right);
+            } else {
+                const node * pivot = right->left;
+                result = make_node(pivot->data,
+                                   make_node(data, left, pivot->left),
+                                   make_node(right->data, pivot->right, right->right));
+                discard(pivot);
+            }
+            discard(right);
+        } else {
+            result = make_node(data, left, right);
+        }
+        return result;
+    }
+
+    // La recursión sólo llega a la altura del árbol, que es O(log n)
+    const node * do_insert(const node * current, const K & key, const V & value, bool & added) {
+        if (current == nullptr) {
+            added = true;
+            return make_node({ key, value }, nullptr, nullptr);
+        }
+
+        const node * result;
+        if (key < current->data.first) {
+            result = balance_tree(current->data, do_insert(current->left, key, value, added), current->right);
+        } else if (key > current->data.first) {
+            result = balance_tree(current->data, current->left, do_insert(current->right, key, value, added));
+        } else {
+            result = make_node({ key, value }, current->left, current->right);
+        }
+        discard(current);
+        return result;
+    }
+
+    const node * do_erase(const node * current, const K & key, bool & erased) {
+        if (current == nullptr) {
+            return current;
+        }
+
+        const node * result;
+        if (key < current->data.first) {
+            const node * left = do_erase(current->left, key, erased);
+            if (!erased) {
+                return current;
+            }
+            result = balance_tree(current->data, left, current->right);
+        } else if (key > current->data.first) {
+            const node * right = do_erase(current->right, key, erased);
+            if (!erased) {
+                return current;
+            }
+            result = balance_tree(current->data, current->left, right);
+        } else {
+            erased = true;
+            if (current->left == nullptr) {
+                result = current->right;
+            } else if (current->right == nullptr) {
+                result = current->left;
+            } else {
+                // El mínimo del subárbol derecho queda retirado, pero no se
+                // libera hasta publicar, así que su dato sigue siendo válido.
+                const node * minimum = current->right->find_minimum();
+                result = balance_tree(minimum->data, current->left, erase_minimum(current->right));
+            }
+        }
+        discard(current);
+        return result;
+    }
+
+    const node * erase_minimum(const node * current) {
+        if (current->left == nullptr) {
+            const node * result = current->right;
+            discard(current);
+            return result;
+        }
+        const node * result = balance_tree(current->data, erase_minimum(current->left), current->right);
+        discard(current);
+        return result;
+    }
+
+    void do_clear(const node * root) {
+        std::vector<const node *> pending;
+        if (root != nullptr) {
+            pending.push_back(root);
+        }
+        while (!pending.empty()) {
+            const node * current = pending.back();
+            pending.pop_back();
+            if (current->left != nullptr) {
+                pending.push_back(current->left);
+            }
+            if (current->right != nullptr) {
+                pending.push_back(current->right);
+            }
+            delete current;
+        }
+    }
+};
+
+#endif // CONCURRENT_MAP_H
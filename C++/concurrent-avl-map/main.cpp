@@ -0,0 +1,149 @@
+#include "concurrent_map.h"
+#include "../avl-as-map/avl_map.h"
+#include "../benchmark/measure.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+template <typename K, typename V>
+void show(const string & name, const concurrent_map<K, V> & m) {
+    cout << name << " = concurrent_map { ";
+    m.read().each([](const K & k, const V & v) { cout << k << ":" << v << " "; });
+    cout << "}" << endl;
+}
+
+// El árbol AVL de avl_map.h protegido con un lock de lectores y escritores,
+// para comparar con concurrent_map.
+class locked_avl {
+private:
+    mutable shared_timed_mutex m_lock;
+    mutable tree<int, int> m_tree;
+
+public:
+    bool contains(int key) const {
+        shared_lock<shared_timed_mutex> lock(m_lock);
+        return m_tree.contains(key);
+    }
+
+    void insert(int key, int value) {
+        unique_lock<shared_timed_mutex> lock(m_lock);
+        m_tree.insert(key, value);
+    }
+
+    void erase(int key) {
+        unique_lock<shared_timed_mutex> lock(m_lock);
+        m_tree.erase(key);
+    }
+};
+
+// Lanza readers hilos que hacen lookups búsquedas cada uno mientras otro hilo
+// inserta y borra claves sin parar. Devuelve millones de búsquedas por segundo.
+template <typename Map>
+double reader_throughput(Map & m, int n, int readers, int lookups) {
+    atomic<bool> done(false);
+    atomic<long> found(0);
+    thread writer([&] {
+        mt19937 rng(7);
+        while (!done) {
+            int key = int(rng() % (2 * n));
+            if (key % 2 == 0) {
+                m.insert(key, key);
+            } else {
+                m.erase(key - 1);
+            }
+        }
+    });
+
+    vector<thread> threads;
+    double elapsed = measure([&] {
+        for (int r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r] {
+                mt19937 rng(r);
+                long count = 0;
+                for (int i = 0; i < lookups; ++i) {
+                    count += m.contains(int(rng() % (2 * n)));
+                }
+                found += count;
+            });
+        }
+        for (auto & t : threads) {
+            t.join();
+        }
+    });
+    done = true;
+    writer.join();
+    return readers * double(lookups) / elapsed / 1e6;
+}
+
+int main() {
+    concurrent_map<int, string> m;
+
+    for (const auto & x: { 5, 3, 7, 1, 4, 2, 6, 0, 8 })
+        m.insert(x, "[" + to_string(x) + "]");
+
+    show("m", m);
+    cout << "Graficando m:" << endl;
+    cout << m.read().str();
+
+    cout << endl << "Tomando un snapshot s de m y haciendo más cambios en m:" << endl;
+    {
+        auto s = m.read();
+        m.insert(5, "a");
+        m.insert(9, "b");
+        cout << "Borrando un 3 => " << m.erase(3) << endl;
+        cout << "Borrando un 42 => " << m.erase(42) << endl;
+        show("m", m);
+        cout << "s = concurrent_map { ";
+        s.each([](const int & k, const string & v) { cout << k << ":" << v << " "; });
+        cout << "}" << endl;
+
+        cout << "¿s contiene a 3? " << boolalpha << s.contains(3) << endl;
+        cout << "¿m contiene a 3? " << boolalpha << m.contains(3) << endl;
+    }
+
+    {
+        auto s = m.read();
+        auto p = s.find(7);
+        if (p != s.end()) {
+            cout << "El valor asociado a " << p->first << " es: " << p->second << endl;
+        }
+        cout << "Mínimo de m => " << s.minimum()->first << endl;
+        cout << "Máximo de m => " << s.maximum()->first << endl;
+        cout << "Claves de m al revés =>";
+        for (auto q = s.rbegin(); q != s.rend(); ++q)
+            cout << ' ' << q->first;
+        cout << endl;
+    }
+
+    m.clear();
+    cout << "Después de clear(), ¿m está vacío? " << boolalpha << m.read().empty() << endl << endl;
+
+    const int n = 100000;
+    const int lookups = 1000000;
+    int max_readers = max(1, int(thread::hardware_concurrency()));
+    cout << "Búsquedas concurrentes con un escritor activo (" << n << " claves, "
+         << lookups << " búsquedas por lector), en millones de búsquedas por segundo:" << endl;
+
+    concurrent_map<int, int> lock_free;
+    locked_avl locked;
+    for (int key = 0; key < 2 * n; key += 2) {
+        lock_free.insert(key, key);
+        locked.insert(key, key);
+    }
+    for (int readers = 1; ; readers = min(2 * readers, max_readers)) {
+        double lock_free_rate = reader_throughput(lock_free, n, readers, lookups);
+        double locked_rate = reader_throughput(locked, n, readers, lookups);
+        cout << "  " << readers << " lectores: concurrent_map " << lock_free_rate
+             << ", árbol AVL con shared_timed_mutex " << locked_rate << endl;
+        if (readers == max_readers)
+            break;
+    }
+}
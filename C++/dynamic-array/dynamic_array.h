@@ -19,12 +19,12 @@ public:
         m_size = m_capacity = count;
     }
 
-    dynamic_array(dynamic_array & x) {
+    dynamic_array(const dynamic_array & x) {
         m_capacity = x.m_capacity;
         m_size = x.m_size;
         if (m_capacity > 0) {
             m_data = new T[m_capacity];
-            std::copy_n(x.begin(), x.size(), begin());
+            std::copy_n(x.m_data, x.m_size, m_data);
         } else {
             m_data = nullptr;
         }
@@ -277,7 +277,8 @@ public:
         }
         auto p = end();
         while(p != pos) {
-            *p-- = *p;
+            *p = *(p - 1);
+            --p;
         }
         *p = value;
         ++m_size;
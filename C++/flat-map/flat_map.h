@@ -0,0 +1,570 @@
+#ifndef FLAT_MAP_H
+#define FLAT_MAP_H
+
+#include <algorithm>  // Para std::stable_sort
+#include <cstddef>    // Para std::size_t
+#include <functional> // Para std::less
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <utility>    // Para std::pair, std::swap, std::forward y std::move
+#include <vector>     // Para std::vector
+
+#include "../dynamic-array/dynamic_array.h"
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el mapa  ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/********* Mapa asociativo implementado con arreglos ordenados de claves y valores **/
+/************************************************************************************/
+
+// Las claves están ordenadas en un dynamic_array y los valores en otro, en
+// la misma posición que su clave, así que buscar una clave sólo recorre las
+// claves y las encuentra juntas en memoria. Buscar es O(log n), pero insertar
+// o borrar un elemento es O(n) porque hay que correr a los que le siguen; por
+// eso conviene para mapas que se consultan mucho más de lo que se modifican,
+// y para cargar muchos elementos de una vez está insert(first, last).
+//
+// Ofrece las mismas operaciones que el árbol de avl_map.h. Como claves y
+// valores están separados, el iterador devuelve un par de referencias en
+// lugar de un std::pair<const K, V> &. Los iteradores se invalidan al
+// modificar el mapa.
+
+template <typename K, typename V, typename Compare = std::less<K>>
+class flat_map {
+public:
+    using value_type = std::pair<const K, V>;
+
+private:
+    dynamic_array<K> m_keys;
+    dynamic_array<V> m_values;
+    Compare m_cmp;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    flat_map() {
+    }
+
+    explicit flat_map(const Compare & cmp) : m_cmp(cmp) {
+    }
+
+    flat_map(const flat_map & x) : m_keys(x.m_keys), m_values(x.m_values), m_cmp(x.m_cmp) {
+    }
+
+    flat_map & operator=(flat_map x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(flat_map & x, flat_map & y) {
+        using namespace std;
+        swap(x.m_keys, y.m_keys);
+        swap(x.m_values, y.m_values);
+        swap(x.m_cmp, y.m_cmp);
+    }
+
+    /************************************************************************/
+    /************* ITERADOR QUE RECORRE LOS ELEMENTOS EN ORDEN **************/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        flat_map * m_map;
+        std::size_t m_position;
+
+    public:
+        using value_type = flat_map::value_type;
+        using reference = std::pair<const K &, V &>;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        // Como no hay ningún par guardado al que apuntar, operator-> devuelve
+        // un objeto que contiene el par de referencias.
+        class pointer {
+        private:
+            reference m_reference;
+
+        public:
+            pointer(reference r) : m_reference(r) {
+            }
+
+            reference * operator->() {
+                return &m_reference;
+            }
+        };
+
+        iterator(flat_map * map = nullptr, std::size_t position = 0) {
+            m_map = map;
+            m_position = position;
+        }
+
+        reference operator*() {
+            // Precondición: m_position < m_map->size()
+            return { m_map->m_keys[m_position], m_map->m_values[m_position] };
+        }
+
+        pointer operator->() {
+            return pointer(operator*());
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_position == y.m_position;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            ++m_position;
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        // La posición es un índice, así que retroceder (incluso desde end())
+        // es restarle uno
+        iterator & operator--() {
+            // Precondición: m_position > 0
+            --m_position;
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, size());
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******** MÉTODOS QUE PERMITEN CONSULTAR AL MAPA SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_keys.empty();
+    }
+
+    std::size_t size() {
+        return m_keys.size();
+    }
+
+    friend
+    bool operator==(flat_map & x, flat_map & y) {
+        if (x.size() != y.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            if (x.m_keys[i] != y.m_keys[i] || x.m_values[i] != y.m_values[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend
+    bool operator!=(flat_map & x, flat_map & y) {
+        return !(x == y);
+    }
+
+    iterator find(const K & key) {
+        return iterator(this, find_position(key));
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const Key & key) {
+        return iterator(this, find_position(key));
+    }
+
+    bool contains(const K & key) {
+        return find_position(key) != size();
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    bool contains(const Key & key) {
+        return find_position(key) != size();
+    }
+
+    // Devuelve el primer elemento cuya clave no es menor a key
+    iterator lower_bound(const K & key) {
+        return iterator(this, search(key, false));
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const Key & key) {
+        return iterator(this, search(key, false));
+    }
+
+    // Devuelve el primer elemento cuya clave es mayor a key
+    iterator upper_bound(const K & key) {
+        return iterator(this, search(key, true));
+    }
+
+    template <typename Key, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const Key & key) {
+        return iterator(this, search(key, true));
+    }
+
+    iterator minimum() {
+        return begin();
+    }
+
+    iterator maximum() {
+        if (empty())
+            return end();
+        return iterator(this, size() - 1);
+    }
+
+    // Los recorridos en preorden y postorden tratan al arreglo como un árbol
+    // balanceado cuya raíz es el elemento del medio.
+
+    template <typename F>
+    void each(F func) {
+        for (std::size_t i = 0; i < size(); ++i) {
+            const K & key = m_keys[i];
+            func(key, m_values[i]);
+        }
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el mapa.
+    template <typename F>
+    bool each_while(F func) {
+        for (std::size_t i = 0; i < size(); ++i) {
+            const K & key = m_keys[i];
+            if (!func(key, m_values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_implicit_tree([&](std::size_t i) { const K & key = m_keys[i]; func(key, m_values[i]); }, true);
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_implicit_tree([&](std::size_t i) { const K & key = m_keys[i]; func(key, m_values[i]); }, false);
+    }
+
+    /************************************************************************/
+    /******************** MÉTODOS QUE MODIFICAN AL MAPA *********************/
+    /************************************************************************/
+
+    void reserve(std::size_t count) {
+        m_keys.reserve(count);
+        m_values.reserve(count);
+    }
+
+    // Si la clave ya estaba, insert reemplaza el valor asociado.
+
+    iterator insert(const K & key, const V & value) {
+        return insert_or_assign(key, value).first;
+    }
+
+    iterator insert(K && key, V && value) {
+        return insert_or_assign(std::move(key), std::move(value)).first;
+    }
+
+    // Agrega los pares [first, last) de una vez: los ordena aparte y los
+    // intercala con los que ya estaban en una sola pasada desde el final,
+    // sin correr a los elementos una vez por cada par. Si una clave se repite
+    // queda el último valor, como si se hubieran insertado de a uno.
+    template <typename InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        std::vector<std::pair<K, V>> added;
+        for (; first != last; ++first) {
+            const auto & element = *first;
+            std::size_t position = find_position(element.first);
+            if (position != size()) {
+                m_values[position] = element.second;
+            } else {
+                added.emplace_back(element.first, element.second);
+            }
+        }
+        auto less_key = [this](const std::pair<K, V> & x, const std::pair<K, V> & y) {
+            return m_cmp(x.first, y.first);
+        };
+        std::stable_sort(added.begin(), added.end(), less_key);
+
+        // Entre las claves repetidas queda la última de cada grupo
+        std::size_t unique = 0;
+        for (std::size_t i = 0; i < added.size(); ++i) {
+            if (i + 1 < added.size() && !less_key(added[i], added[i + 1])) {
+                continue;
+            }
+            if (unique != i) {
+                added[unique] = std::move(added[i]);
+            }
+            ++unique;
+        }
+
+        std::size_t old_size = size();
+        m_keys.resize(old_size + unique);
+        m_values.resize(old_size + unique);
+        std::size_t i = old_size;
+        std::size_t j = unique;
+        std::size_t k = old_size + unique;
+        while (j > 0) {
+            --k;
+            if (i > 0 && m_cmp(added[j - 1].first, m_keys[i - 1])) {
+                --i;
+                m_keys[k] = std::move(m_keys[i]);
+                m_values[k] = std::move(m_values[i]);
+            } else {
+                --j;
+                m_keys[k] = std::move(added[j].first);
+                m_values[k] = std::move(added[j].second);
+            }
+        }
+    }
+
+    // Devuelven además si la clave fue agregada (true) o si ya estaba (false).
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K & key, M && value) {
+        auto result = do_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(K && key, M && value) {
+        auto result = do_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    // Si la clave ya estaba, try_emplace no hace nada (ni siquiera consume
+    // los argumentos); si no, construye el valor con args.
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K & key, Args &&... args) {
+        return do_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K && key, Args &&... args) {
+        return do_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Devuelve el valor asociado a key, agregándolo (construido por defecto)
+    // si la clave no estaba.
+
+    V & operator[](const K & key) {
+        return try_emplace(key).first->second;
+    }
+
+    V & operator[](K && key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    std::pair<bool, iterator> erase(const K & key) {
+        std::size_t position = find_position(key);
+        if (position == size()) {
+            return { false, end() };
+        }
+        m_keys.erase(m_keys.begin() + position);
+        m_values.erase(m_values.begin() + position);
+        return { true, iterator(this, position) };
+    }
+
+    void clear() {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Búsqueda binaria sin saltos condicionales que dependan de las claves:
+    // en cada paso descarta la mitad del rango eligiendo su comienzo con una
+    // asignación condicional. Devuelve la posición de la primera clave que
+    // no es menor a key (o que es mayor a key si strict es true).
+    template <typename Key>
+    std::size_t search(const Key & key, bool strict) {
+        std::size_t length = size();
+        if (length == 0) {
+            return 0;
+        }
+        std::size_t base = 0;
+        while (length > 1) {
+            std::size_t half = length / 2;
+            const K & middle = m_keys[base + half - 1];
+            bool before = strict ? !m_cmp(key, middle) : m_cmp(middle, key);
+            base = before ? base + half : base;
+            length -= half;
+        }
+        const K & last = m_keys[base];
+        return base + (strict ? !m_cmp(key, last) : m_cmp(last, key));
+    }
+
+    // Devuelve size() si la clave no está
+    template <typename Key>
+    std::size_t find_position(const Key & key) {
+        std::size_t position = search(key, false);
+        if (position == size() || m_cmp(key, m_keys[position])) {
+            return size();
+        }
+        return position;
+    }
+
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> do_emplace(Key && key, Args &&... args) {
+        std::size_t position = search(key, false);
+        if (position < size() && !m_cmp(key, m_keys[position])) {
+            return { iterator(this, position), false };
+        }
+        m_keys.insert(m_keys.begin() + position, K(std::forward<Key>(key)));
+        m_values.insert(m_values.begin() + position, V(std::forward<Args>(args)...));
+        return { iterator(this, position), true };
+    }
+
+    // Recorre el árbol implícito con una pila explícita de rangos [lo, hi),
+    // cuya raíz es el elemento del medio.
+    template <typename F>
+    void visit_implicit_tree(F visit, bool preorder) {
+        struct range {
+            std::size_t lo;
+            std::size_t hi;
+            bool expanded;
+        };
+        std::vector<range> pending;
+        pending.push_back({ 0, size(), false });
+        while (!pending.empty()) {
+            range current = pending.back();
+            pending.pop_back();
+            if (current.lo >= current.hi) {
+                continue;
+            }
+            std::size_t middle = current.lo + (current.hi - current.lo) / 2;
+            if (current.expanded) {
+                visit(middle);
+            } else if (preorder) {
+                visit(middle);
+                pending.push_back({ middle + 1, current.hi, false });
+                pending.push_back({ current.lo, middle, false });
+            } else {
+                pending.push_back({ middle, middle + 1, true });
+                pending.push_back({ middle + 1, current.hi, false });
+                pending.push_back({ current.lo, middle, false });
+            }
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, std::size_t>>;
+
+    // Calcula la posición de los elementos del árbol implícito en pantalla
+    void calculate_nodes_placement(std::size_t lo, std::size_t hi, int & x, int h, nodes_placement & placements) {
+        if (lo < hi) {
+            std::size_t middle = lo + (hi - lo) / 2;
+            calculate_nodes_placement(lo, middle, x, h+1, placements);
+            placements.emplace_back(h, x++, middle);
+            calculate_nodes_placement(middle + 1, hi, x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol implícito
+    // usando caracteres ASCII
+    std::string str() {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(0, size(), count, 0, placements);
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            std::size_t the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << m_keys[the_node];
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // FLAT_MAP_H
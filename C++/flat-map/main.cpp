@@ -0,0 +1,113 @@
+#include "flat_map.h"
+#include "../avl-as-map/avl_map.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+template <typename K, typename V, typename C>
+ostream & operator<<(ostream & out, flat_map<K, V, C> & t) {
+    out << "flat_map { ";
+    for (const auto & x : t) {
+        out << x.first << ":" << x.second << " ";
+    }
+    out << "}";
+    return out;
+}
+
+void show_key_value(const int & k, string & v) {
+    cout << k << ":" << v << ' ';
+}
+
+int main() {
+    flat_map<int, string> t1;
+
+    for (const auto & x: { 5, 3, 7, 1, 4, 2, 6, 0, 8 })
+        t1.insert(x, "[" + to_string(x) + "]");
+
+    cout << "t1 = " << t1 << endl;
+    cout << "Graficando t1 como árbol implícito:" << endl;
+    cout << t1.str();
+
+    cout << endl << "Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "t2 = " << t2 << endl;
+
+    cout << endl << "Haciendo más inserciones en t1:" << endl;
+    t1.insert(5, "a");
+    t1.insert(9, "b");
+    t1.insert(5, "c");
+    cout << "t1 = " << t1 << endl;
+    cout << "¿t1 == t2? " << boolalpha << (t1 == t2) << endl;
+
+    cout << "¿t1 contiene a 5? " << boolalpha << t1.contains(5) << endl;
+    cout << "¿t1 contiene a 42? " << boolalpha << t1.contains(42) << endl;
+
+    auto p = t1.find(7);
+    if (p != end(t1)) {
+        cout << "El valor asociado a " << p->first << " es: " << p->second << endl;
+        p->second = "z";
+    }
+
+    cout << "Borrando un 5 => " << t1.erase(5).first << endl;
+    cout << "Borrando un 42 => " << t1.erase(42).first << endl;
+    cout << "t1 = " << t1 << endl;
+
+    cout << "Mínimo de t1 => " << t1.minimum()->first << endl;
+    cout << "Máximo de t1 => " << t1.maximum()->first << endl;
+    cout << "Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << (*p).first << ":" << (*p).second << " ";
+    }
+    cout << endl << endl;
+
+    cout << "Recorriendo t2 con each():" << endl;
+    cout << "t2 = flat_map { ";
+    t2.each(show_key_value);
+    cout << "}" << endl << endl;
+
+    cout << "Agregando de una vez los pares 10:d, 3:e, 12:f y 10:g a t1:" << endl;
+    vector<pair<int, string>> pares = { { 10, "d" }, { 3, "e" }, { 12, "f" }, { 10, "g" } };
+    t1.insert(pares.begin(), pares.end());
+    cout << "t1 = " << t1 << endl << endl;
+
+    cout << "Comparando con el árbol AVL (200000 claves enteras al azar, 2000000 búsquedas):" << endl;
+    const int n = 200000;
+    mt19937 rng(42);
+    vector<pair<int, int>> elements(n);
+    for (auto & e : elements) {
+        e.first = int(rng() % (4 * n));
+        e.second = e.first;
+    }
+
+    tree<int, int> avl;
+    flat_map<int, int> flat;
+    double avl_build = measure([&] {
+        for (const auto & e : elements)
+            avl.insert(e.first, e.second);
+    });
+    double flat_build = measure([&] {
+        flat.insert(elements.begin(), elements.end());
+    });
+
+    vector<int> queries(10 * n);
+    for (auto & q : queries)
+        q = int(rng() % (4 * n));
+    int found = 0;
+    double avl_find = measure([&] {
+        for (int q : queries)
+            found += avl.contains(q);
+    });
+    double flat_find = measure([&] {
+        for (int q : queries)
+            found -= flat.contains(q);
+    });
+    cout << "  construcción: árbol AVL " << avl_build << " s, flat_map (insert en bloque) " << flat_build << " s" << endl;
+    cout << "  búsquedas:    árbol AVL " << avl_find << " s, flat_map " << flat_find << " s" << endl;
+    cout << "  ¿mismos resultados? " << boolalpha << (found == 0) << endl;
+}
@@ -11,6 +11,10 @@
 #include <unordered_set>
 #include <utility>
 
+#include "../priority_queue/bucket_queue.h"
+#include "../priority_queue/indexed_priority_queue.h"
+#include "../priority_queue/radix_heap.h"
+
 template <typename Graph>
 void dfs_from(Graph & g,
                 std::function<void(typename Graph::vertex_value_type &)> func,
@@ -128,8 +132,66 @@ std::pair<bool, std::vector<typename Graph::vertex_id_type>> topological_sort(Gr
 }
 
 
-template <typename Graph>
-auto shortest_path(Graph & g, typename Graph::vertex_id_type start)
+// Vértices alcanzados pero todavía no visitados de shortest_path, en una
+// cola indexada por vértice: el más cercano se obtiene en O(log n) y al
+// encontrar un camino más corto a uno de ellos se actualiza su distancia en
+// la cola en lugar de agregarlo de nuevo
+template <typename Id, typename Dist>
+class indexed_pending_vertices {
+public:
+    indexed_pending_vertices(std::size_t count) : m_queue(count) {
+    }
+
+    bool empty() {
+        return m_queue.empty();
+    }
+
+    Id pop() {
+        Id v = m_queue.top().second;
+        m_queue.pop();
+        return v;
+    }
+
+    void update(Id v, const Dist & dist) {
+        if (m_queue.contains(v))
+            m_queue.decrease_key(v, dist);
+        else
+            m_queue.push(v, dist);
+    }
+
+private:
+    indexed_priority_queue<Dist> m_queue;
+};
+
+// Lo mismo con una cola monótona (radix_heap o bucket_queue), que no permite
+// cambiar prioridades: cada camino más corto agrega el vértice de nuevo y
+// shortest_path descarta los que salen ya visitados
+template <template <typename, typename> class Queue, typename Id, typename Dist>
+class monotone_pending_vertices {
+public:
+    monotone_pending_vertices(std::size_t) {
+    }
+
+    bool empty() {
+        return m_queue.empty();
+    }
+
+    Id pop() {
+        Id v = m_queue.top().second;
+        m_queue.pop();
+        return v;
+    }
+
+    void update(Id v, const Dist & dist) {
+        m_queue.push(dist, v);
+    }
+
+private:
+    Queue<Dist, Id> m_queue;
+};
+
+template <typename Graph, typename Pending>
+auto shortest_path_with(Graph & g, typename Graph::vertex_id_type start)
 {
     using id_t = typename Graph::vertex_id_type;
     using dist_t = typename Graph::edge_value_type;
@@ -149,29 +211,24 @@ auto shortest_path(Graph & g, typename Graph::vertex_id_type start)
     }
     data.resize(g.size(), { max_dist, false, start });
 
+    Pending pending(g.size());
     data[start].dist = 0;
-    for (auto & v : g.adjacents(start))
-        data[v].dist = g.edge(start, v);
-
-    while (true) {
-        dist_t min_dist = max_dist;
-        id_t min_v;
-        for (auto & v : g.vertices()) {
-            if (!data[v].visited && data[v].dist < min_dist) {
-                min_dist = data[v].dist;
-                min_v = v;
-            }
-        }
+    pending.update(start, 0);
 
-        if (min_dist == max_dist)
-            break;
+    while (!pending.empty()) {
+        id_t min_v = pending.pop();
+        if (data[min_v].visited)
+            continue;
 
         data[min_v].visited = true;
         for (auto & v : g.adjacents(min_v)) {
+            if (data[v].visited)
+                continue;
             auto dt = data[min_v].dist + g.edge(min_v, v);
             if (dt < data[v].dist) {
                 data[v].dist = dt;
                 data[v].prev = min_v;
+                pending.update(v, dt);
             }
         }
     }
@@ -193,4 +250,21 @@ auto shortest_path(Graph & g, typename Graph::vertex_id_type start)
     return result;
 }
 
+template <typename Graph>
+auto shortest_path(Graph & g, typename Graph::vertex_id_type start)
+{
+    using pending_t = indexed_pending_vertices<typename Graph::vertex_id_type, typename Graph::edge_value_type>;
+    return shortest_path_with<Graph, pending_t>(g, start);
+}
+
+// Con pesos enteros sin signo se puede elegir una cola monótona en lugar de
+// la cola indexada: shortest_path<radix_heap>(g, start) o
+// shortest_path<bucket_queue>(g, start), que conviene si los pesos son chicos
+template <template <typename, typename> class Queue, typename Graph>
+auto shortest_path(Graph & g, typename Graph::vertex_id_type start)
+{
+    using pending_t = monotone_pending_vertices<Queue, typename Graph::vertex_id_type, typename Graph::edge_value_type>;
+    return shortest_path_with<Graph, pending_t>(g, start);
+}
+
 #endif // GRAPH_ALGORITHMS_H
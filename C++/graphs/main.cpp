@@ -1,8 +1,10 @@
 #include <iostream>
 #include <fstream>
+#include <random>
 #include "adjacency_matrix.h"
 #include "adjacency_list.h"
 #include "graph_algorithms.h"
+#include "../benchmark/measure.h"
 
 using namespace std;
 
@@ -80,6 +82,29 @@ void recorridos(Graph & g) {
 }
 
 
+// Grafo ralo al azar de n vértices con edges aristas salientes por vértice
+// de pesos entre 1 y max_weight
+void crear_grafo_ralo(graph<int, unsigned> & g, int n, int edges, unsigned max_weight) {
+    mt19937 rng(42);
+    for (int v = 0; v < n; ++v)
+        g.add_vertex(v);
+    for (int v = 0; v < n; ++v)
+        for (int i = 0; i < edges; ++i)
+            g.add_edge(v, rng() % n, 1 + rng() % max_weight);
+}
+
+// Mide cuánto tarda shortest_path con una de las colas posibles
+template <typename F>
+void medir_caminos(const string & cola, F func) {
+    long long total = 0;
+    double time = measure([&] {
+        auto caminos = func();
+        for (auto & c : caminos)
+            total += c.second.empty() ? 0 : c.first;
+    });
+    cout << "  " << cola << ": " << time << " s (suma de distancias " << total << ")" << endl;
+}
+
 template <typename Graph>
 void caminos_mas_cortos(Graph & g, typename Graph::vertex_id_type start) {
     auto caminos = shortest_path(g, start);
@@ -195,4 +220,15 @@ int main() {
     cout << "Antes:   g3 = "; mostrar(g3);
     g3 = g5;
     cout << "Después: g3 = "; mostrar(g3);
+
+    const int n = 200000;
+    for (unsigned max_weight : { 1000u, 10u }) {
+        cout << "\n:: Caminos más cortos en un grafo ralo de " << n << " vértices, " << 4 * n
+             << " aristas y pesos entre 1 y " << max_weight << ":" << endl;
+        graph<int, unsigned> g6;
+        crear_grafo_ralo(g6, n, 4, max_weight);
+        medir_caminos("cola indexada", [&] { return shortest_path(g6, 0); });
+        medir_caminos("radix_heap   ", [&] { return shortest_path<radix_heap>(g6, 0); });
+        medir_caminos("bucket_queue ", [&] { return shortest_path<bucket_queue>(g6, 0); });
+    }
 }
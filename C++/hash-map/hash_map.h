@@ -0,0 +1,686 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <cstddef>      // Para std::size_t
+#include <cstdint>      // Para std::uint64_t
+#include <cstring>      // Para std::memcpy y std::memset
+#include <functional>   // Para std::hash y std::equal_to
+#include <iterator>     // Para std::forward_iterator_tag
+#include <new>          // Para operator new y operator delete
+#include <tuple>        // Para std::forward_as_tuple
+#include <utility>      // Para std::pair, std::swap, std::forward, std::move y std::piecewise_construct
+
+#ifdef __SSE2__
+#include <emmintrin.h>  // Para comparar los 16 bytes de control de un grupo a la vez
+#endif
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el mapa ****/
+/************************************************************************************/
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+/************************************************************************************/
+/***** Mapa asociativo sin orden con direccionamiento abierto (estilo Swiss table) ***/
+/************************************************************************************/
+
+// Los pares se guardan directamente en un arreglo de casilleros (sin nodos
+// ni listas) y cada casillero tiene además un byte de control en un arreglo
+// aparte: si está ocupado, el byte guarda 7 bits del hash de su clave (h2);
+// si no, indica si está vacío o borrado. El resto del hash (h1) elige el
+// grupo de 16 casilleros donde empieza la búsqueda.
+//
+// Para buscar una clave se cargan los 16 bytes de control de un grupo y con
+// una sola comparación SSE2 se obtiene qué casilleros tienen el mismo h2:
+// sólo con ésos (en promedio bastante menos de uno cuando la clave no está)
+// se compara la clave. Si el grupo tiene algún casillero vacío la búsqueda
+// termina; si no, sigue con otro grupo. Sin SSE2 se hace lo mismo byte a
+// byte.
+//
+// A diferencia de avl_map, find, insert y erase cuestan O(1) esperado pero
+// los elementos no quedan ordenados, e insertar puede mover a todos los
+// pares de lugar (invalidando iteradores y referencias) cuando hay que
+// agrandar el arreglo.
+//
+// Si Hash y KeyEqual son transparentes (definen is_transparent), find,
+// contains y erase aceptan cualquier tipo que ambos sepan manejar, sin
+// construir una clave.
+
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class hash_map {
+public:
+    using value_type = std::pair<const K, V>;
+    using size_t = std::size_t;
+
+private:
+    using ctrl_t = signed char;
+
+    // Los casilleros ocupados tienen un h2 entre 0 y 127, así que los bytes
+    // de control negativos son los casilleros libres. sentinel marca el fin
+    // del arreglo para los iteradores.
+    static const ctrl_t empty_slot = -128;
+    static const ctrl_t deleted_slot = -2;
+    static const ctrl_t sentinel = -1;
+    static const size_t group_size = 16;
+
+    // Los 16 bytes de control de un grupo. Cada match devuelve una máscara
+    // con un bit por casillero que cumple la condición.
+    class group {
+    public:
+        explicit group(const ctrl_t * ctrl) {
+#ifdef __SSE2__
+            m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+            std::memcpy(m_ctrl, ctrl, group_size);
+#endif
+        }
+
+        unsigned match(ctrl_t h2) const {
+#ifdef __SSE2__
+            return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl)));
+#else
+            unsigned mask = 0;
+            for (size_t i = 0; i < group_size; ++i) {
+                mask |= unsigned(m_ctrl[i] == h2) << i;
+            }
+            return mask;
+#endif
+        }
+
+        unsigned match_empty() const {
+            return match(empty_slot);
+        }
+
+        unsigned match_free() const {
+#ifdef __SSE2__
+            return unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(sentinel), m_ctrl)));
+#else
+            unsigned mask = 0;
+            for (size_t i = 0; i < group_size; ++i) {
+                mask |= unsigned(m_ctrl[i] < sentinel) << i;
+            }
+            return mask;
+#endif
+        }
+
+    private:
+#ifdef __SSE2__
+        __m128i m_ctrl;
+#else
+        ctrl_t m_ctrl[group_size];
+#endif
+    };
+
+    // Posición del bit encendido más bajo de una máscara no nula
+    static size_t lowest_bit(unsigned mask) {
+#ifdef __GNUC__
+        return size_t(__builtin_ctz(mask));
+#else
+        size_t i = 0;
+        while ((mask & 1) == 0) {
+            mask >>= 1;
+            ++i;
+        }
+        return i;
+#endif
+    }
+
+    // La clave del casillero no es constante para que rehash pueda moverla;
+    // los iteradores sólo la dan como referencia constante.
+    using slot_type = std::pair<K, V>;
+
+    ctrl_t * m_ctrl;         // m_capacity bytes de control más el centinela
+    slot_type * m_slots;     // m_capacity casilleros, construidos sólo los ocupados
+    size_t m_capacity;       // 0 o una potencia de 2 múltiplo de group_size
+    size_t m_size;
+    size_t m_growth_left;    // Casilleros vacíos que se pueden ocupar antes de agrandar
+    float m_max_load_factor;
+    Hash m_hash;
+    KeyEqual m_equal;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    hash_map() {
+        init_empty();
+    }
+
+    explicit hash_map(const Hash & hash, const KeyEqual & equal = KeyEqual()) : m_hash(hash), m_equal(equal) {
+        init_empty();
+    }
+
+    // Copia los casilleros en las mismas posiciones, sin volver a calcular
+    // ningún hash
+    hash_map(const hash_map & x) : m_hash(x.m_hash), m_equal(x.m_equal) {
+        init_empty();
+        m_max_load_factor = x.m_max_load_factor;
+        if (x.m_size > 0) {
+            allocate(x.m_capacity);
+            std::memcpy(m_ctrl, x.m_ctrl, m_capacity + 1);
+            for (size_t i = 0; i < m_capacity; ++i) {
+                if (m_ctrl[i] >= 0) {
+                    new (m_slots + i) slot_type(x.m_slots[i]);
+                }
+            }
+            m_size = x.m_size;
+            m_growth_left = x.m_growth_left;
+        }
+    }
+
+    hash_map(hash_map && x) : m_hash(x.m_hash), m_equal(x.m_equal) {
+        init_empty();
+        swap(*this, x);
+    }
+
+    ~hash_map() {
+        destroy();
+    }
+
+    hash_map & operator=(hash_map x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(hash_map & x, hash_map & y) {
+        using std::swap;
+        swap(x.m_ctrl, y.m_ctrl);
+        swap(x.m_slots, y.m_slots);
+        swap(x.m_capacity, y.m_capacity);
+        swap(x.m_size, y.m_size);
+        swap(x.m_growth_left, y.m_growth_left);
+        swap(x.m_max_load_factor, y.m_max_load_factor);
+        swap(x.m_hash, y.m_hash);
+        swap(x.m_equal, y.m_equal);
+    }
+
+    /************************************************************************/
+    /********** ITERADOR QUE RECORRE LOS CASILLEROS OCUPADOS ****************/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        ctrl_t * m_ctrl;
+        slot_type * m_slot;
+
+        friend class hash_map;
+
+        // Avanza hasta un casillero ocupado o hasta el centinela
+        void skip_free() {
+            while (*m_ctrl < sentinel) {
+                ++m_ctrl;
+                ++m_slot;
+            }
+        }
+
+    public:
+        using value_type = hash_map::value_type;
+        using reference = std::pair<const K &, V &>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        // Como en flat_map, operator-> devuelve un objeto con el par de
+        // referencias, porque el casillero no es un value_type
+        class pointer {
+        private:
+            reference m_reference;
+
+        public:
+            pointer(reference r) : m_reference(r) {
+            }
+
+            reference * operator->() {
+                return &m_reference;
+            }
+        };
+
+        iterator(ctrl_t * ctrl = nullptr, slot_type * slot = nullptr) {
+            m_ctrl = ctrl;
+            m_slot = slot;
+        }
+
+        reference operator*() {
+            // Precondición: *this != end()
+            return { m_slot->first, m_slot->second };
+        }
+
+        pointer operator->() {
+            return pointer(operator*());
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_ctrl == y.m_ctrl;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: *this != end()
+            ++m_ctrl;
+            ++m_slot;
+            skip_free();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+    };
+
+    iterator begin() {
+        if (m_capacity == 0) {
+            return end();
+        }
+        iterator p(m_ctrl, m_slots);
+        p.skip_free();
+        return p;
+    }
+
+    iterator end() {
+        return iterator(m_ctrl + m_capacity, m_slots + m_capacity);
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL MAPA SIN MODIFICARLO *********/
+    /************************************************************************/
+
+    size_t size() const {
+        return m_size;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+    float load_factor() const {
+        return m_capacity == 0 ? 0.0f : float(m_size) / float(m_capacity);
+    }
+
+    float max_load_factor() const {
+        return m_max_load_factor;
+    }
+
+    // Los mapas son iguales si tienen los mismos pares, sin importar en qué
+    // casilleros estén
+    friend
+    bool operator==(hash_map & x, hash_map & y) {
+        if (x.size() != y.size()) {
+            return false;
+        }
+        for (const auto & element : x) {
+            auto p = y.find(element.first);
+            if (p == y.end() || !(p->second == element.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend
+    bool operator!=(hash_map & x, hash_map & y) {
+        return !(x == y);
+    }
+
+    iterator find(const K & key) {
+        return make_iterator(find_slot(key));
+    }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual,
+              typename = typename H::is_transparent, typename = typename E::is_transparent>
+    iterator find(const Key & key) {
+        return make_iterator(find_slot(key));
+    }
+
+    bool contains(const K & key) {
+        return find_slot(key) != m_capacity;
+    }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual,
+              typename = typename H::is_transparent, typename = typename E::is_transparent>
+    bool contains(const Key & key) {
+        return find_slot(key) != m_capacity;
+    }
+
+    // El orden de each es el de los casilleros, que no tiene nada que ver
+    // con el de las claves.
+    template <typename F>
+    void each(F func) {
+        for (const auto & element : *this) {
+            func(element.first, element.second);
+        }
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL MAPA **********************/
+    /************************************************************************/
+
+    iterator insert(const K & key, const V & value) {
+        return insert_or_assign(key, value).first;
+    }
+
+    iterator insert(K && key, V && value) {
+        return insert_or_assign(std::move(key), std::move(value)).first;
+    }
+
+    // Tanto insert_or_assign como try_emplace construyen el par directamente
+    // en su casillero. Devuelven además si la clave fue agregada (true) o si
+    // ya estaba (false).
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const K & key, M && value) {
+        auto result = do_emplace(key, std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(K && key, M && value) {
+        auto result = do_emplace(std::move(key), std::forward<M>(value));
+        if (!result.second) {
+            result.first->second = std::forward<M>(value);
+        }
+        return result;
+    }
+
+    // Si la clave ya estaba, try_emplace no hace nada (ni siquiera consume
+    // los argumentos); si no, construye el valor con args.
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const K & key, Args &&... args) {
+        return do_emplace(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(K && key, Args &&... args) {
+        return do_emplace(std::move(key), std::forward<Args>(args)...);
+    }
+
+    // Devuelve el valor asociado a key, agregándolo (construido por defecto)
+    // si la clave no estaba.
+
+    V & operator[](const K & key) {
+        return try_emplace(key).first->second;
+    }
+
+    V & operator[](K && key) {
+        return try_emplace(std::move(key)).first->second;
+    }
+
+    std::pair<bool, iterator> erase(const K & key) {
+        return erase_slot(find_slot(key));
+    }
+
+    template <typename Key, typename H = Hash, typename E = KeyEqual,
+              typename = typename H::is_transparent, typename = typename E::is_transparent>
+    std::pair<bool, iterator> erase(const Key & key) {
+        return erase_slot(find_slot(key));
+    }
+
+    void clear() {
+        destroy();
+        init_empty_keeping_load_factor();
+    }
+
+    // Agranda el arreglo para que entren count pares sin volver a agrandarlo
+    void reserve(size_t count) {
+        if (count > max_size_for(m_capacity)) {
+            rehash(capacity_for(count));
+        }
+    }
+
+    // Cambia la fracción máxima de casilleros ocupados (entre 0.5 y 0.9375,
+    // 0.875 por defecto): más alta ahorra memoria y más baja acorta las
+    // búsquedas de claves que no están. Si hace falta, agranda el arreglo.
+    void max_load_factor(float factor) {
+        m_max_load_factor = factor < 0.5f ? 0.5f : factor > 0.9375f ? 0.9375f : factor;
+        if (m_capacity > 0) {
+            if (m_size > max_size_for(m_capacity)) {
+                rehash(capacity_for(m_size));
+            } else {
+                rehash(m_capacity);
+            }
+        }
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    void init_empty() {
+        m_max_load_factor = 0.875f;
+        init_empty_keeping_load_factor();
+    }
+
+    void init_empty_keeping_load_factor() {
+        m_ctrl = nullptr;
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growth_left = 0;
+    }
+
+    // Muchas funciones de hash (como std::hash para enteros) devuelven la
+    // clave tal cual, con los bits bajos muy poco variados. Multiplicar por
+    // una constante impar y mezclar las dos mitades reparte todos los bits
+    // del hash en h1 y en h2.
+    template <typename Key>
+    std::uint64_t hash_of(const Key & key) const {
+        std::uint64_t h = std::uint64_t(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 32);
+    }
+
+    static ctrl_t h2(std::uint64_t hash) {
+        return ctrl_t(hash & 0x7F);
+    }
+
+    // Primer grupo a revisar, ya multiplicado por group_size
+    size_t h1(std::uint64_t hash) const {
+        return size_t(hash >> 7) & (m_capacity - 1) & ~(group_size - 1);
+    }
+
+    // Los grupos se recorren saltando 1, 2, 3... grupos (números
+    // triangulares), que con una cantidad de grupos potencia de 2 pasa por
+    // todos antes de repetir
+    size_t next_group(size_t position, size_t & step) const {
+        step += group_size;
+        return (position + step) & (m_capacity - 1);
+    }
+
+    size_t max_size_for(size_t capacity) const {
+        return size_t(double(capacity) * m_max_load_factor);
+    }
+
+    size_t capacity_for(size_t count) const {
+        size_t capacity = group_size;
+        while (max_size_for(capacity) < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    iterator make_iterator(size_t index) {
+        return iterator(m_ctrl + index, m_slots + index);
+    }
+
+    // Devuelve el casillero de key o m_capacity si no está
+    template <typename Key>
+    size_t find_slot(const Key & key) {
+        if (m_size == 0) {
+            return m_capacity;
+        }
+        return find_slot(key, hash_of(key));
+    }
+
+    template <typename Key>
+    size_t find_slot(const Key & key, std::uint64_t hash) {
+        size_t position = h1(hash);
+        size_t step = 0;
+        while (true) {
+            group g(m_ctrl + position);
+            for (unsigned mask = g.match(h2(hash)); mask != 0; mask &= mask - 1) {
+                size_t index = position + lowest_bit(mask);
+                if (m_equal(m_slots[index].first, key)) {
+                    return index;
+                }
+            }
+            if (g.match_empty() != 0) {
+                return m_capacity;
+            }
+            position = next_group(position, step);
+        }
+    }
+
+    // Primer casillero libre (vacío o borrado) en el recorrido de hash
+    size_t find_free_slot(std::uint64_t hash) const {
+        size_t position = h1(hash);
+        size_t step = 0;
+        while (true) {
+            unsigned mask = group(m_ctrl + position).match_free();
+            if (mask != 0) {
+                return position + lowest_bit(mask);
+            }
+            position = next_group(position, step);
+        }
+    }
+
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> do_emplace(Key && key, Args &&... args) {
+        std::uint64_t hash = hash_of(key);
+        if (m_capacity == 0) {
+            rehash(group_size);
+        } else {
+            size_t index = find_slot(key, hash);
+            if (index != m_capacity) {
+                return { make_iterator(index), false };
+            }
+        }
+        size_t index = find_free_slot(hash);
+        if (m_growth_left == 0 && m_ctrl[index] == empty_slot) {
+            // Si más de la mitad de lo ocupable son casilleros borrados,
+            // alcanza con reacomodar los pares en el mismo arreglo
+            rehash(m_size < max_size_for(m_capacity) / 2 ? m_capacity : 2 * m_capacity);
+            index = find_free_slot(hash);
+        }
+        new (m_slots + index) slot_type(std::piecewise_construct,
+                                         std::forward_as_tuple(std::forward<Key>(key)),
+                                         std::forward_as_tuple(std::forward<Args>(args)...));
+        if (m_ctrl[index] == empty_slot) {
+            --m_growth_left;
+        }
+        m_ctrl[index] = h2(hash);
+        ++m_size;
+        return { make_iterator(index), true };
+    }
+
+    // Un casillero borrado puede volver a estar vacío si su grupo ya tenía
+    // algún vacío: las búsquedas que pasan por este grupo terminan en él de
+    // todos modos, así que no se corta el recorrido de ninguna otra clave.
+    std::pair<bool, iterator> erase_slot(size_t index) {
+        if (index == m_capacity) {
+            return { false, end() };
+        }
+        m_slots[index].~slot_type();
+        size_t position = index & ~(group_size - 1);
+        if (group(m_ctrl + position).match_empty() != 0) {
+            m_ctrl[index] = empty_slot;
+            ++m_growth_left;
+        } else {
+            m_ctrl[index] = deleted_slot;
+        }
+        --m_size;
+        iterator next = make_iterator(index);
+        next.skip_free();
+        return { true, next };
+    }
+
+    void allocate(size_t capacity) {
+        m_capacity = capacity;
+        m_ctrl = new ctrl_t[capacity + 1];
+        std::memset(m_ctrl, empty_slot, capacity);
+        m_ctrl[capacity] = sentinel;
+        m_slots = static_cast<slot_type *>(::operator new(capacity * sizeof(slot_type)));
+        m_size = 0;
+        m_growth_left = max_size_for(capacity);
+    }
+
+    // Pasa todos los pares a un arreglo de capacity casilleros, moviéndolos
+    // sin compararlos (las claves ya son todas distintas)
+    void rehash(size_t capacity) {
+        ctrl_t * old_ctrl = m_ctrl;
+        slot_type * old_slots = m_slots;
+        size_t old_capacity = m_capacity;
+        allocate(capacity);
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (old_ctrl[i] >= 0) {
+                std::uint64_t hash = hash_of(old_slots[i].first);
+                size_t index = find_free_slot(hash);
+                new (m_slots + index) slot_type(std::move(old_slots[i]));
+                old_slots[i].~slot_type();
+                m_ctrl[index] = h2(hash);
+                ++m_size;
+                --m_growth_left;
+            }
+        }
+        delete[] old_ctrl;
+        ::operator delete(old_slots);
+    }
+
+    void destroy() {
+        for (size_t i = 0; i < m_capacity; ++i) {
+            if (m_ctrl[i] >= 0) {
+                m_slots[i].~slot_type();
+            }
+        }
+        delete[] m_ctrl;
+        ::operator delete(m_slots);
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+public:
+
+    // Éste método muestra los bytes de control, un grupo por renglón: ". "
+    // es un casillero vacío, "x " uno borrado y los ocupados muestran su h2
+    // en hexadecimal
+    std::string str() const {
+        std::ostringstream s;
+        for (size_t position = 0; position < m_capacity; position += group_size) {
+            s << "grupo " << std::setw(3) << position / group_size << ": ";
+            for (size_t i = position; i < position + group_size; ++i) {
+                if (m_ctrl[i] == empty_slot) {
+                    s << " . ";
+                } else if (m_ctrl[i] == deleted_slot) {
+                    s << " x ";
+                } else {
+                    s << std::hex << std::setw(2) << std::setfill('0') << int(m_ctrl[i])
+                      << std::dec << std::setfill(' ') << ' ';
+                }
+            }
+            s << '\n';
+        }
+        return s.str();
+    }
+};
+
+#endif // HASH_MAP_H
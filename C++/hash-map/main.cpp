@@ -0,0 +1,180 @@
+#include "hash_map.h"
+#include "../avl-as-map/avl_map.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+template <typename K, typename V, typename H, typename E>
+ostream & operator<<(ostream & out, hash_map<K, V, H, E> & t) {
+    out << "hash_map { ";
+    for (const auto & x : t) {
+        out << x.first << ":" << x.second << " ";
+    }
+    out << "}";
+    return out;
+}
+
+void show_key_value(const int & k, string & v) {
+    cout << k << ":" << v << ' ';
+}
+
+// Hash y comparación transparentes: permiten buscar claves string usando
+// directamente un const char * sin construir un string temporal
+struct string_hash {
+    using is_transparent = void;
+
+    size_t operator()(const string & s) const {
+        return hash<string>()(s);
+    }
+
+    size_t operator()(const char * s) const {
+        return hash<string>()(string(s));
+    }
+};
+
+struct string_equal {
+    using is_transparent = void;
+
+    bool operator()(const string & x, const string & y) const {
+        return x == y;
+    }
+
+    bool operator()(const string & x, const char * y) const {
+        return x == y;
+    }
+};
+
+// std::unordered_map con la misma interfaz que usa el benchmark
+template <typename K, typename V>
+struct std_map : unordered_map<K, V> {
+    void insert(const K & k, const V & v) {
+        (*this)[k] = v;
+    }
+
+    pair<bool, int> erase(const K & k) {
+        return { unordered_map<K, V>::erase(k) > 0, 0 };
+    }
+
+    bool contains(const K & k) {
+        return this->count(k) > 0;
+    }
+};
+
+// Mide las operaciones básicas sobre un mapa de enteros y devuelve una suma
+// de control para comparar los resultados
+template <typename Map>
+long long benchmark(const string & name, const vector<int> & keys, const vector<int> & missing) {
+    Map m;
+    long long checksum = 0;
+    double insert_time = measure([&] {
+        for (int k : keys)
+            m.insert(k, k);
+    });
+    double find_time = measure([&] {
+        for (int k : keys)
+            checksum += m.find(k)->second;
+    });
+    double miss_time = measure([&] {
+        for (int k : missing)
+            checksum += m.contains(k);
+    });
+    double erase_time = measure([&] {
+        for (int k : keys)
+            checksum += m.erase(k).first;
+    });
+    cout << "  " << name << ": insert " << insert_time << " s, find " << find_time
+         << " s, find (ausentes) " << miss_time << " s, erase " << erase_time << " s" << endl;
+    return checksum;
+}
+
+int main() {
+    hash_map<int, string> t1;
+
+    for (const auto & x: { 5, 3, 7, 1, 4, 2, 6, 0, 8 })
+        t1.insert(x, "[" + to_string(x) + "]");
+
+    cout << "t1 = " << t1 << endl;
+    cout << "Bytes de control de t1:" << endl;
+    cout << t1.str();
+
+    cout << endl << "Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "t2 = " << t2 << endl;
+
+    cout << endl << "Haciendo más inserciones en t1:" << endl;
+    t1.insert(5, "a");
+    t1.insert(9, "b");
+    t1.insert(5, "c");
+    cout << "¿Se agregó 10 con try_emplace? " << boolalpha << t1.try_emplace(10, 3, 'z').second << endl;
+    cout << "¿Se agregó 10 de nuevo? " << t1.try_emplace(10, "no").second << endl;
+
+    cout << "t1 = " << t1 << endl;
+    cout << "¿t1 == t2? " << (t1 == t2) << endl;
+
+    cout << "¿t1 contiene a 5? " << t1.contains(5) << endl;
+    cout << "¿t1 contiene a 42? " << t1.contains(42) << endl;
+
+    auto p = t1.find(7);
+    if (p != end(t1)) {
+        cout << "El valor asociado a " << p->first << " es: " << p->second << endl;
+        p->second = "z";
+    }
+
+    cout << "Borrando un 5 => " << t1.erase(5).first << endl;
+    cout << "Borrando un 42 => " << t1.erase(42).first << endl;
+    cout << "t1 = " << t1 << endl;
+
+    cout << endl << "Recorriendo t2 con each():" << endl;
+    cout << "t2 = hash_map { ";
+    t2.each(show_key_value);
+    cout << "}" << endl;
+
+    cout << endl << "Insertando en t3 claves de texto del 1 al 40 (16 casilleros por grupo):" << endl;
+    hash_map<string, int, string_hash, string_equal> t3;
+    for (int x = 1; x < 41; ++x)
+        t3[to_string(x)] = x;
+    cout << t3.str();
+    cout << "Capacidad " << t3.capacity() << ", factor de carga " << t3.load_factor() << endl;
+
+    const char * text = "35";
+    cout << "Buscando \"35\" como const char * (sin construir un string) => " << t3.find(text)->second << endl;
+
+    cout << "Borrando las claves pares (como cada grupo tiene algún vacío, no quedan casilleros borrados):" << endl;
+    for (int x = 2; x < 41; x += 2)
+        t3.erase(to_string(x).c_str());
+    cout << t3.str();
+    cout << "Cantidad de elementos de t3 => " << t3.size() << endl;
+
+    cout << "Bajando el factor de carga máximo a 0.5 (se reacomodan los pares):" << endl;
+    t3.max_load_factor(0.5f);
+    cout << t3.str();
+
+    cout << endl << "Comparando con el árbol AVL y con std::unordered_map (1000000 claves enteras al azar):" << endl;
+    vector<int> keys(1000000);
+    vector<int> missing(keys.size());
+    mt19937 rng(42);
+    for (auto & k : keys)
+        k = int(rng() >> 1);
+    for (auto & k : missing)
+        k = -int(rng() >> 1) - 1;
+
+    long long c1 = benchmark<tree<int, int>>("avl_map           ", keys, missing);
+    long long c2 = benchmark<std_map<int, int>>("std::unordered_map", keys, missing);
+    long long c3 = benchmark<hash_map<int, int>>("hash_map          ", keys, missing);
+    cout << "  ¿Mismos resultados? " << (c1 == c2 && c2 == c3) << endl;
+
+    hash_map<int, int> reserved;
+    double reserved_time = measure([&] {
+        reserved.reserve(keys.size());
+        for (int k : keys)
+            reserved.insert(k, k);
+    });
+    cout << "  hash_map con reserve(): insert " << reserved_time << " s (capacidad "
+         << reserved.capacity() << ", factor de carga " << reserved.load_factor() << ")" << endl;
+}
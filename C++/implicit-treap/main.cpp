@@ -0,0 +1,168 @@
+#include "sequence.h"
+#include "../dynamic-array/dynamic_array.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+ostream & operator<<(ostream & out, sequence<T> & s) {
+    out << "sequence { ";
+    for (const auto & x : s) {
+        out << x << " ";
+    }
+    out << "}" << endl << s.str();
+    return out;
+}
+
+void show_char(char c) {
+    cout << c;
+}
+
+// Una edición del benchmark: insertar o borrar en la posición index (las
+// inserciones y los borrados se alternan, así que el tamaño no cambia)
+struct edit {
+    bool insert;
+    size_t index;
+};
+
+vector<edit> make_edits(size_t n, size_t count, mt19937_64 & rng) {
+    vector<edit> edits(count);
+    for (size_t i = 0; i < count; ++i) {
+        edits[i].insert = i % 2 == 0;
+        edits[i].index = rng() % (n + 1);  // Antes de cada borrado el tamaño es n + 1
+    }
+    return edits;
+}
+
+long apply_edits(sequence<int> & s, const vector<edit> & edits, size_t first, size_t last) {
+    long sum = 0;
+    for (size_t i = first; i < last; ++i) {
+        if (edits[i].insert) {
+            s.insert_at(edits[i].index, int(i));
+        } else {
+            sum += s[edits[i].index];
+            s.erase_at(edits[i].index);
+        }
+    }
+    return sum;
+}
+
+long apply_edits(dynamic_array<int> & a, const vector<edit> & edits, size_t first, size_t last) {
+    long sum = 0;
+    for (size_t i = first; i < last; ++i) {
+        if (edits[i].insert) {
+            a.insert(a.begin() + edits[i].index, int(i));
+        } else {
+            sum += a[edits[i].index];
+            a.erase(a.begin() + edits[i].index);
+        }
+    }
+    return sum;
+}
+
+int main() {
+    cout << ":: Creando s1 con las letras de \"secuencias\":" << endl;
+    sequence<char> s1;
+    for (char c : string("secuencias")) {
+        s1.push_back(c);
+    }
+    cout << "  s1 = " << s1 << endl;
+
+    cout << ":: Insertando \" de \" en la posición 10 y \"treaps\" al final:" << endl;
+    string de = " de ";
+    for (size_t i = 0; i < de.size(); ++i) {
+        s1.insert_at(10 + i, de[i]);
+    }
+    for (char c : string("treaps")) {
+        s1.push_back(c);
+    }
+    cout << "  s1 = ";
+    s1.each(show_char);
+    cout << " - tamaño " << s1.size() << endl;
+    cout << ":: s1[0] = " << s1[0] << ", s1[14] = " << s1[14] << ", back() = " << s1.back() << endl;
+
+    cout << ":: Borrando la posición 0 y la última:" << endl;
+    s1.erase_at(0);
+    s1.pop_back();
+    cout << "  s1 = ";
+    s1.each(show_char);
+    cout << endl;
+
+    cout << ":: Invirtiendo las posiciones [3, 9) y luego toda la secuencia:" << endl;
+    s1.reverse(3, 9);
+    cout << "  s1 = ";
+    s1.each(show_char);
+    cout << endl;
+    s1.reverse();
+    cout << "  s1 = ";
+    s1.each(show_char);
+    cout << endl;
+    s1.reverse();
+
+    cout << ":: Partiendo s1 en la posición 8:" << endl;
+    auto s2 = s1.split_at(8);
+    cout << "  s1 = ";
+    s1.each(show_char);
+    cout << endl << "  s2 = ";
+    s2.each(show_char);
+    cout << endl;
+
+    cout << ":: Concatenando s2 y s1 (en ese orden):" << endl;
+    auto s3 = s2;
+    s3.concat(s1);
+    cout << "  s3 = ";
+    s3.each(show_char);
+    cout << " - ¿s1 quedó vacía? " << boolalpha << s1.empty() << endl << endl;
+
+    mt19937_64 rng(42);
+    const size_t edits_count = 1000000;
+    cout << ":: Comparando con dynamic_array: inserciones y borrados alternados en posiciones al azar" << endl;
+    for (size_t n : {100000, 1000000, 10000000}) {
+        size_t array_count = 2000000000 / n;
+        if (array_count > edits_count) {
+            array_count = edits_count;
+        }
+        vector<edit> edits = make_edits(n, edits_count, rng);
+
+        sequence<int> s(n, 1);
+        dynamic_array<int> a(n);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = 1;
+        }
+
+        long s_sum = 0;
+        long a_sum = 0;
+        double a_time = measure([&] { a_sum = apply_edits(a, edits, 0, array_count); });
+        double s_time = measure([&] { s_sum = apply_edits(s, edits, 0, array_count); });
+        bool same = s_sum == a_sum;
+        for (size_t i = 0; same && i < n; i += n / 1000) {
+            same = s[i] == a[i];
+        }
+        s_time += measure([&] { apply_edits(s, edits, array_count, edits_count); });
+
+        cout << "  n = " << n << ": treap " << s_time / edits_count * 1e6
+             << " µs por edición, dynamic_array " << a_time / array_count * 1e6
+             << " µs por edición (" << array_count << " ediciones) - ¿mismos resultados? " << same << endl;
+
+        const size_t cuts = 200000;
+        double cut_time = measure([&] {
+            for (size_t i = 0; i < cuts; ++i) {
+                auto rest = s.split_at(rng() % n);
+                s.concat(rest);
+            }
+        });
+        double reverse_time = measure([&] {
+            for (size_t i = 0; i < cuts; ++i) {
+                size_t first = rng() % n;
+                s.reverse(first, first + rng() % (n - first));
+            }
+        });
+        cout << "    split_at + concat " << cut_time / cuts * 1e6 << " µs, reverse de un rango "
+             << reverse_time / cuts * 1e6 << " µs" << endl;
+    }
+}
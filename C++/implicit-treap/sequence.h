@@ -0,0 +1,577 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <cstddef>    // Para std::size_t
+#include <cstdint>    // Para std::uint32_t
+#include <iterator>   // Para std::forward_iterator_tag
+#include <stack>      // Para std::stack
+#include <utility>    // Para std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/******* Secuencia implementada con un treap de claves implícitas (posiciones) ******/
+/************************************************************************************/
+
+// Es un árbol binario cuyo recorrido en orden da los elementos de la
+// secuencia: la "clave" de un nodo no se guarda, es su posición, que se
+// calcula con los tamaños de los subárboles. Cada nodo tiene además una
+// prioridad al azar y el árbol es un montículo de prioridades (treap), lo
+// que lo deja con altura O(log n) esperada sin importar el orden de las
+// operaciones.
+//
+// Así, insertar o borrar en cualquier posición, acceder por índice, partir
+// la secuencia en dos y concatenar dos secuencias cuestan O(log n), a
+// diferencia de dynamic_array, donde insertar o borrar en el medio mueve
+// O(n) elementos. Invertir un rango también cuesta O(log n): se marca la
+// raíz del rango y la marca se propaga a los hijos recién cuando se baja
+// por ella.
+
+template <typename T>
+class sequence {
+private:
+    struct node {
+        T value;
+        node * left;
+        node * right;
+        std::size_t size;
+        std::uint32_t priority;
+        bool reversed;  // Los hijos de este nodo (y todo debajo) están pendientes de invertir
+    };
+
+    node * m_root;
+    std::uint32_t m_seed;
+
+public:
+    using size_t = std::size_t;
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    // Crea una secuencia con count copias de value en O(count)
+    sequence(size_t count = 0, const T & value = T {}) {
+        m_root = nullptr;
+        m_seed = 2463534242u;
+        if (count > 0) {
+            build(count, value);
+        }
+    }
+
+    sequence(const sequence & x) {
+        m_root = copy_nodes(x.m_root);
+        m_seed = x.m_seed;
+    }
+
+    sequence(sequence && x) {
+        m_root = x.m_root;
+        m_seed = x.m_seed;
+        x.m_root = nullptr;
+    }
+
+    ~sequence() {
+        clear();
+    }
+
+    sequence & operator=(sequence x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(sequence & x, sequence & y) {
+        using std::swap;
+        swap(x.m_root, y.m_root);
+        swap(x.m_seed, y.m_seed);
+    }
+
+    friend
+    bool operator==(sequence & x, sequence & y) {
+        if (x.size() != y.size()) {
+            return false;
+        }
+        auto px = x.begin();
+        auto py = y.begin();
+        while (px != x.end()) { // Son del mismo tamaño, no necesito ver si py != y.end()
+            if (*px != *py) {
+                return false;
+            }
+            ++px;
+            ++py;
+        }
+        return true;
+    }
+
+    friend
+    bool operator!=(sequence & x, sequence & y) {
+        return !(x == y);
+    }
+
+    /************************************************************************/
+    /**** ITERADOR PESADO QUE RECORRE LA SECUENCIA DE PRINCIPIO A FIN *******/
+    /************************************************************************/
+
+    // Guarda en una pila los ancestros cuyos valores todavía no visitó. Al
+    // bajar por un nodo propaga su marca de inversión, así que recorrer la
+    // secuencia puede modificar (sin cambiar su contenido) al árbol.
+    class iterator {
+    private:
+        node * m_current;
+        std::stack<node *, std::vector<node *>> m_pending;
+
+        friend class sequence;
+
+        // Baja desde current por los hijos izquierdos hasta el primero
+        void descend_to_first(node * current) {
+            push_down(current);
+            while (current->left != nullptr) {
+                m_pending.push(current);
+                current = current->left;
+                push_down(current);
+            }
+            m_current = current;
+        }
+
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() {
+            m_current = nullptr;
+        }
+
+        reference operator*() {
+            // Precondición: m_current != nullptr
+            return m_current->value;
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: m_current != nullptr
+            if (m_current->right != nullptr) {
+                descend_to_first(m_current->right);
+            } else if (!m_pending.empty()) {
+                m_current = m_pending.top();
+                m_pending.pop();
+            } else {
+                m_current = nullptr;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+    };
+
+    iterator begin() {
+        iterator p;
+        if (m_root != nullptr) {
+            p.descend_to_first(m_root);
+        }
+        return p;
+    }
+
+    iterator end() {
+        return iterator();
+    }
+
+    /************************************************************************/
+    /***** MÉTODOS QUE PERMITEN CONSULTAR A LA SECUENCIA SIN MODIFICARLA ****/
+    /************************************************************************/
+
+    size_t size() const {
+        return size_of(m_root);
+    }
+
+    bool empty() const {
+        return m_root == nullptr;
+    }
+
+    // Baja desde la raíz eligiendo el hijo por los tamaños de los
+    // subárboles, en O(log n)
+    T & operator[](size_t index) {
+        // Precondición: index < size()
+        node * current = m_root;
+        while (true) {
+            push_down(current);
+            size_t left_size = size_of(current->left);
+            if (index < left_size) {
+                current = current->left;
+            } else if (index > left_size) {
+                index -= left_size + 1;
+                current = current->right;
+            } else {
+                return current->value;
+            }
+        }
+    }
+
+    T & front() {
+        // Precondición: !empty()
+        return operator[](0);
+    }
+
+    T & back() {
+        // Precondición: !empty()
+        return operator[](size() - 1);
+    }
+
+    template <typename F>
+    void each(F func) {
+        each(m_root, func);
+    }
+
+    /************************************************************************/
+    /****************** MÉTODOS QUE MODIFICAN A LA SECUENCIA ****************/
+    /************************************************************************/
+
+    // Inserta value de manera que quede en la posición index
+    void insert_at(size_t index, const T & value) {
+        // Precondición: index <= size()
+        node * new_node = new node {value, nullptr, nullptr, 1, next_priority(), false};
+        insert_node(m_root, index, new_node);
+    }
+
+    // Borra el elemento de la posición index
+    void erase_at(size_t index) {
+        // Precondición: index < size()
+        erase_node(m_root, index);
+    }
+
+    void push_back(const T & value) {
+        insert_at(size(), value);
+    }
+
+    void push_front(const T & value) {
+        insert_at(0, value);
+    }
+
+    void pop_back() {
+        // Precondición: !empty()
+        erase_at(size() - 1);
+    }
+
+    void pop_front() {
+        // Precondición: !empty()
+        erase_at(0);
+    }
+
+    // Deja en la secuencia los primeros index elementos y devuelve otra con
+    // el resto
+    sequence split_at(size_t index) {
+        // Precondición: index <= size()
+        sequence rest;
+        split(m_root, index, m_root, rest.m_root);
+        return rest;
+    }
+
+    // Agrega al final todos los elementos de x, dejándola vacía
+    void concat(sequence & x) {
+        m_root = merge(m_root, x.m_root);
+        x.m_root = nullptr;
+    }
+
+    // Invierte el orden de los elementos en las posiciones [first, last)
+    void reverse(size_t first, size_t last) {
+        // Precondición: first <= last && last <= size()
+        if (last - first < 2) {
+            return;
+        }
+        node * left;
+        node * middle;
+        node * right;
+        split(m_root, first, left, middle);
+        split(middle, last - first, middle, right);
+        middle->reversed = !middle->reversed;
+        m_root = merge(merge(left, middle), right);
+    }
+
+    void reverse() {
+        reverse(0, size());
+    }
+
+    void clear() {
+        delete_nodes(m_root);
+        m_root = nullptr;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    static size_t size_of(const node * current) {
+        return current == nullptr ? 0 : current->size;
+    }
+
+    static void update_size(node * current) {
+        current->size = size_of(current->left) + 1 + size_of(current->right);
+    }
+
+    // Aplica la inversión pendiente de current: intercambia sus hijos y les
+    // pasa la marca. Hay que llamarlo antes de mirar los hijos de un nodo.
+    static void push_down(node * current) {
+        if (current->reversed) {
+            std::swap(current->left, current->right);
+            if (current->left != nullptr) {
+                current->left->reversed = !current->left->reversed;
+            }
+            if (current->right != nullptr) {
+                current->right->reversed = !current->right->reversed;
+            }
+            current->reversed = false;
+        }
+    }
+
+    // Generador xorshift de 32 bits: alcanza para las prioridades y es
+    // mucho más barato que los de <random>
+    std::uint32_t next_priority() {
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+        return m_seed;
+    }
+
+    // Parte al árbol current en dos: en left quedan los primeros index
+    // elementos y en right el resto
+    static void split(node * current, size_t index, node *& left, node *& right) {
+        if (current == nullptr) {
+            left = right = nullptr;
+            return;
+        }
+        push_down(current);
+        if (size_of(current->left) < index) {
+            split(current->right, index - size_of(current->left) - 1, current->right, right);
+            left = current;
+        } else {
+            split(current->left, index, left, current->left);
+            right = current;
+        }
+        update_size(current);
+    }
+
+    // Une dos árboles dejando todos los elementos de left antes que los de
+    // right; queda arriba la raíz de mayor prioridad
+    static node * merge(node * left, node * right) {
+        if (left == nullptr) {
+            return right;
+        }
+        if (right == nullptr) {
+            return left;
+        }
+        if (left->priority > right->priority) {
+            push_down(left);
+            left->right = merge(left->right, right);
+            update_size(left);
+            return left;
+        } else {
+            push_down(right);
+            right->left = merge(left, right->left);
+            update_size(right);
+            return right;
+        }
+    }
+
+    // Baja por el camino de la posición index hasta encontrar un nodo de
+    // menor prioridad que new_node y pone ahí a new_node, partiendo a ese
+    // subárbol para colgar las dos mitades como sus hijos
+    static void insert_node(node *& current, size_t index, node * new_node) {
+        if (current == nullptr) {
+            current = new_node;
+        } else if (new_node->priority > current->priority) {
+            split(current, index, new_node->left, new_node->right);
+            update_size(new_node);
+            current = new_node;
+        } else {
+            push_down(current);
+            size_t left_size = size_of(current->left);
+            if (index <= left_size) {
+                insert_node(current->left, index, new_node);
+            } else {
+                insert_node(current->right, index - left_size - 1, new_node);
+            }
+            ++current->size;
+        }
+    }
+
+    // Busca la posición index y reemplaza a su nodo por la unión de sus hijos
+    static void erase_node(node *& current, size_t index) {
+        push_down(current);
+        size_t left_size = size_of(current->left);
+        if (index < left_size) {
+            erase_node(current->left, index);
+            --current->size;
+        } else if (index > left_size) {
+            erase_node(current->right, index - left_size - 1);
+            --current->size;
+        } else {
+            node * old = current;
+            current = merge(current->left, current->right);
+            delete old;
+        }
+    }
+
+    // Construye un treap con count copias de value en O(count): recorre la
+    // secuencia de izquierda a derecha manteniendo en una pila el camino
+    // derecho del árbol y, como en un árbol cartesiano, cada nodo nuevo se
+    // lleva como hijo izquierdo a los nodos del camino de menor prioridad
+    void build(size_t count, const T & value) {
+        std::vector<node *> right_path;
+        for (size_t i = 0; i < count; ++i) {
+            node * new_node = new node {value, nullptr, nullptr, 1, next_priority(), false};
+            node * last = nullptr;
+            while (!right_path.empty() && right_path.back()->priority < new_node->priority) {
+                last = right_path.back();
+                right_path.pop_back();
+            }
+            new_node->left = last;
+            if (!right_path.empty()) {
+                right_path.back()->right = new_node;
+            }
+            right_path.push_back(new_node);
+        }
+        m_root = right_path.front();
+        fix_sizes(m_root);  // Recién ahora están todos los hijos en su lugar
+    }
+
+    static size_t fix_sizes(node * current) {
+        if (current == nullptr) {
+            return 0;
+        }
+        current->size = fix_sizes(current->left) + 1 + fix_sizes(current->right);
+        return current->size;
+    }
+
+    static node * copy_nodes(const node * current) {
+        if (current == nullptr) {
+            return nullptr;
+        }
+        node * new_node = new node(*current);
+        new_node->left = copy_nodes(current->left);
+        new_node->right = copy_nodes(current->right);
+        return new_node;
+    }
+
+    static void delete_nodes(node * current) {
+        if (current != nullptr) {
+            delete_nodes(current->left);
+            delete_nodes(current->right);
+            delete current;
+        }
+    }
+
+    template <typename F>
+    static void each(node * current, F & func) {
+        if (current != nullptr) {
+            push_down(current);
+            each(current->left, func);
+            func(current->value);
+            each(current->right, func);
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla. No
+    // propaga las marcas de inversión: si hay una pendiente (reversed) recorre
+    // primero el subárbol derecho, como si ya se hubiesen intercambiado.
+    void calculate_nodes_placement(const node * current, bool reversed, int & x, int h,
+                                   nodes_placement & placements) const {
+        if (current != nullptr) {
+            reversed = reversed != current->reversed;
+            const node * first = reversed ? current->right : current->left;
+            const node * second = reversed ? current->left : current->right;
+            calculate_nodes_placement(first, reversed, x, h+1, placements);
+            placements.emplace_back(h, x++, current);
+            calculate_nodes_placement(second, reversed, x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_root, false, count, 0, placements);
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << the_node->value;
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // SEQUENCE_H
@@ -0,0 +1,766 @@
+#ifndef INTERVAL_TREE_H
+#define INTERVAL_TREE_H
+
+#include <algorithm>  // Para std::max
+#include <cstddef>    // Para std::size_t
+#include <iterator>   // Para std::bidirectional_iterator_tag, std::distance y std::reverse_iterator
+#include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/*************** Árbol de intervalos implementado sobre un árbol AVL ****************/
+/************************************************************************************/
+
+// Guarda intervalos cerrados [low, high] ordenados por low (y por high entre
+// los que empiezan en el mismo lugar). Es el árbol AVL de avl.h con un dato
+// más por nodo: max_high, el mayor extremo derecho de su subárbol, que se
+// recalcula junto con la altura cada vez que un nodo cambia de hijos.
+//
+// Con max_high una búsqueda puede descartar subárboles enteros: si
+// max_high < low ningún intervalo de ese subárbol llega hasta low, y si un
+// nodo empieza después de high, tampoco lo hacen los que le siguen en orden.
+// Así encontrar un intervalo que se solape con [low, high] cuesta O(log n) y
+// listar los k que se solapan cuesta O(log n + k) en los casos usuales
+// (O(min(n, k log n)) en el peor caso).
+
+template <typename T>
+class interval_tree {
+public:
+    struct interval {
+        T low;
+        T high;
+
+        friend
+        bool operator==(const interval & x, const interval & y) {
+            return !(x.low < y.low) && !(y.low < x.low) && !(x.high < y.high) && !(y.high < x.high);
+        }
+
+        friend
+        bool operator!=(const interval & x, const interval & y) {
+            return !(x == y);
+        }
+
+        // Orden lexicográfico: primero por low y después por high
+        friend
+        bool operator<(const interval & x, const interval & y) {
+            return x.low < y.low || (!(y.low < x.low) && x.high < y.high);
+        }
+
+        friend
+        bool operator>(const interval & x, const interval & y) {
+            return y < x;
+        }
+
+        bool overlaps(const T & a_low, const T & a_high) const {
+            return !(high < a_low) && !(a_high < low);
+        }
+    };
+
+private:
+    // La cabecera tiene sólo los enlaces, como en avl.h; el intervalo y
+    // max_high están en node.
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
+        int height;
+
+        node_base * find_minimum() {
+            node_base * minimum = this;
+            while (minimum->left != nullptr) {
+                minimum = minimum->left;
+            }
+            return minimum;
+        }
+
+        node_base * find_maximum() {
+            node_base * maximum = this;
+            while (maximum->right != nullptr) {
+                maximum = maximum->right;
+            }
+            return maximum;
+        }
+    };
+
+    struct node : node_base {
+        interval value;
+        T max_high;
+
+        node(const interval & a_value, node_base * a_parent, int a_height, const T & a_max_high)
+            : value(a_value), max_high(a_max_high) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+            this->height = a_height;
+        }
+    };
+
+    static interval & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const interval & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    static const T & max_high_of(const node_base * n) {
+        return static_cast<const node *>(n)->max_high;
+    }
+
+    // Recalcula la altura y el máximo extremo derecho de n a partir de sus
+    // hijos, que tienen que estar al día
+    static void update_height(node_base * n) {
+        node * current = static_cast<node *>(n);
+        int left_height = 0;
+        current->max_high = current->value.high;
+        if (n->left != nullptr) {
+            left_height = n->left->height;
+            if (current->max_high < max_high_of(n->left)) {
+                current->max_high = max_high_of(n->left);
+            }
+        }
+        int right_height = 0;
+        if (n->right != nullptr) {
+            right_height = n->right->height;
+            if (current->max_high < max_high_of(n->right)) {
+                current->max_high = max_high_of(n->right);
+            }
+        }
+        n->height = 1 + std::max(left_height, right_height);
+    }
+
+    // La raíz cuelga a la izquierda de m_header, que hace de padre de la raíz
+    // y de end() como en avl.h. Como la cabecera no tiene intervalo, T no
+    // necesita poder construirse por defecto.
+    node_base m_header;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    interval_tree() {
+        init_header();
+    }
+
+    // Carga masiva en O(n): [first, last) tiene que estar ordenado y sin
+    // intervalos repetidos. Arma directamente un árbol perfectamente
+    // balanceado, sin rotaciones.
+    template <typename InputIt>
+    interval_tree(InputIt first, InputIt last) {
+        init_header();
+        std::vector<interval> sorted(first, last);
+        set_root(build(sorted.data(), sorted.size()));
+    }
+
+    interval_tree(const interval_tree & x) {
+        init_header();
+        copy_nodes(x.m_header.left);
+    }
+
+    interval_tree(interval_tree && x) {
+        init_header();
+        set_root(x.m_header.left);
+        x.m_header.left = nullptr;
+    }
+
+    ~interval_tree() {
+        clear();
+    }
+
+    interval_tree & operator=(interval_tree x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(interval_tree & x, interval_tree & y) {
+        node_base * root = x.m_header.left;
+        x.set_root(y.m_header.left);
+        y.set_root(root);
+    }
+
+    /************************************************************************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
+    /************************************************************************/
+
+    // Los intervalos no se pueden modificar a través del iterador, porque
+    // eso rompería el orden y los máximos guardados en el árbol
+    class iterator {
+    private:
+        node_base * m_current;
+
+        friend class interval_tree;
+
+    public:
+        using value_type = interval;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(node_base * current = nullptr) {
+            m_current = current;
+        }
+
+        reference operator*() {
+            // Precondición: m_current != end()
+            return value_of(m_current);
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        // Al subir desde el máximo se llega a la cabecera, que es end()
+        iterator & operator++() {
+            // Precondición: m_current != end()
+            if (m_current->right != nullptr) {
+                m_current = m_current->right->find_minimum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->right == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        // Desde end() baja al máximo, porque la raíz es el hijo izquierdo
+        // de la cabecera.
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        return iterator(m_header.find_minimum());
+    }
+
+    iterator end() {
+        return iterator(&m_header);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_header.left == nullptr;
+    }
+
+    friend
+    bool operator==(interval_tree & x, interval_tree & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(interval_tree & x, interval_tree & y) {
+        return !(x == y);
+    }
+
+    iterator find(const T & low, const T & high) {
+        interval value { low, high };
+        node_base * current = m_header.left;
+        while (current != nullptr) {
+            if (value < value_of(current)) {
+                current = current->left;
+            } else if (value > value_of(current)) {
+                current = current->right;
+            } else {
+                return iterator(current);
+            }
+        }
+        return end();
+    }
+
+    bool contains(const T & low, const T & high) {
+        return find(low, high) != end();
+    }
+
+    // Devuelve algún intervalo que se solape con [low, high], o end() si no
+    // hay ninguno, en O(log n). Si el subárbol izquierdo llega hasta low y
+    // no tiene ninguno que se solape, tampoco lo tiene el derecho: todos sus
+    // intervalos empiezan después que el que llegaba hasta low, que a su vez
+    // empieza después de high.
+    iterator find_overlapping(const T & low, const T & high) {
+        node_base * current = m_header.left;
+        while (current != nullptr && !value_of(current).overlaps(low, high)) {
+            if (current->left != nullptr && !(max_high_of(current->left) < low)) {
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return current != nullptr ? iterator(current) : end();
+    }
+
+    bool overlaps(const T & low, const T & high) {
+        return find_overlapping(low, high) != end();
+    }
+
+    iterator minimum() {
+        return begin();
+    }
+
+    iterator maximum() {
+        if (empty())
+            return end();
+        return iterator(m_header.left->find_maximum());
+    }
+
+    // Llama a func con cada intervalo que se solapa con [low, high], en orden
+    template <typename F>
+    void each_overlapping(const T & low, const T & high, F func) {
+        visit_overlapping(low, high, [&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Consulta de apuñalamiento: llama a func con cada intervalo que
+    // contiene a point
+    template <typename F>
+    void each_containing(const T & point, F func) {
+        each_overlapping(point, point, func);
+    }
+
+    // each recorre todos los intervalos en orden; para quedarse sólo con los
+    // que se solapan con otro conviene each_overlapping, que poda subárboles.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    iterator insert(const T & low, const T & high) {
+        // Precondición: !(high < low)
+        interval value { low, high };
+        node_base * parent;
+        node_base ** ptr = find_link(value, parent);
+        if (*ptr != nullptr) {
+            return iterator(*ptr);
+        }
+        node_base * inserted = new node(value, parent, 1, high);
+        *ptr = inserted;
+        rebalance_from(parent);
+        return iterator(inserted);
+    }
+
+    std::pair<bool, iterator> erase(const T & low, const T & high) {
+        iterator p = find(low, high);
+        if (p == end()) {
+            return { false, end() };
+        }
+        iterator next = std::next(p);
+        erase_node(p.m_current);
+        return { true, next };
+    }
+
+    void clear() {
+        do_clear(m_header.left);
+        m_header.left = nullptr;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Los recorridos usan una pila de tamaño fijo en lugar de recursión,
+    // como en avl.h.
+
+    static const int max_height = 64;
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        while (current != nullptr || size > 0) {
+            while (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            }
+            current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    // Recorrido en orden que no baja a los subárboles con max_high < low y
+    // que termina en el primer nodo que empieza después de high
+    template <typename F>
+    bool visit_overlapping(const T & low, const T & high, F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        while (true) {
+            while (current != nullptr && !(max_high_of(current) < low)) {
+                pending[size++] = current;
+                current = current->left;
+            }
+            if (size == 0) {
+                return true;
+            }
+            current = pending[--size];
+            if (high < value_of(current).low) {
+                return true;
+            }
+            if (!(value_of(current).high < low) && !visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+    }
+
+    // Arma un árbol perfectamente balanceado con los count intervalos
+    // ordenados a partir de sorted. La recursión tiene profundidad log2(n).
+    node_base * build(const interval * sorted, std::size_t count) {
+        if (count == 0) {
+            return nullptr;
+        }
+        std::size_t middle = count / 2;
+        node_base * root = new node(sorted[middle], nullptr, 1, sorted[middle].high);
+        root->left = build(sorted, middle);
+        root->right = build(sorted + middle + 1, count - middle - 1);
+        assign_parent(root->left, root);
+        assign_parent(root->right, root);
+        update_height(root);
+        return root;
+    }
+
+    // Copia los nodos de other sin recursión ni pila: avanza en pre-orden
+    // sobre ambos árboles a la vez, subiendo por los enlaces a los padres.
+    void copy_nodes(const node_base * other) {
+        if (other == nullptr) {
+            return;
+        }
+        const node_base * other_root = other;
+        set_root(new node(value_of(other), nullptr, other->height, max_high_of(other)));
+        node_base * current = m_header.left;
+        while (true) {
+            if (other->left != nullptr && current->left == nullptr) {
+                other = other->left;
+                current->left = new node(value_of(other), current, other->height, max_high_of(other));
+                current = current->left;
+            } else if (other->right != nullptr && current->right == nullptr) {
+                other = other->right;
+                current->right = new node(value_of(other), current, other->height, max_high_of(other));
+                current = current->right;
+            } else if (other != other_root) {
+                other = other->parent;
+                current = current->parent;
+            } else {
+                break;
+            }
+        }
+    }
+
+    // Devuelve el enlace donde está (o debería estar) value y deja en parent
+    // al nodo del que cuelga ese enlace.
+    node_base ** find_link(const interval & value, node_base * & parent) {
+        node_base ** ptr = &m_header.left;
+        parent = &m_header;
+        while (*ptr != nullptr) {
+            if (value < value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->left;
+            } else if (value > value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->right;
+            } else {
+                break;
+            }
+        }
+        return ptr;
+    }
+
+    void init_header() {
+        m_header.left = m_header.right = m_header.parent = nullptr;
+        m_header.height = 0;
+    }
+
+    void set_root(node_base * root) {
+        m_header.left = root;
+        assign_parent(m_header.left, &m_header);
+    }
+
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de la
+    // cabecera)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    // Sube desde current hasta la raíz actualizando las alturas y los
+    // máximos y rotando donde haga falta. A diferencia de avl.h no se puede
+    // cortar cuando la altura de un subárbol no cambia: su max_high puede
+    // haber cambiado igual, y hay que llevarlo hasta la raíz.
+    void rebalance_from(node_base * current) {
+        while (current != &m_header) {
+            node_base * & link = link_to(current);
+            balance_tree(link);
+            current = link->parent;
+        }
+    }
+
+    void balance_tree(node_base * & root) {
+        int bf = balance_factor(root);
+        if (bf == 2) {
+            if (balance_factor(root->left) == -1) {
+                rotate_left(root->left);
+            }
+            rotate_right(root);
+        } else if (bf == -2) {
+            if (balance_factor(root->right) == 1) {
+                rotate_right(root->right);
+            }
+            rotate_left(root);
+        } else {
+            update_height(root);
+        }
+    }
+
+    int balance_factor(const node_base * a_node) {
+        int result = 0;
+        if (a_node != nullptr) {
+            if (a_node->left != nullptr) {
+                result = a_node->left->height;
+            }
+            if (a_node->right != nullptr) {
+                result -= a_node->right->height;
+            }
+        }
+        return result;
+    }
+
+    void assign_parent(node_base * & n, node_base * p) {
+        if (n != nullptr) {
+            n->parent = p;
+        }
+    }
+
+    // Las rotaciones sólo cambian los hijos de los dos nodos que giran, así
+    // que basta con recalcular sus máximos (primero el que queda abajo)
+    void rotate_left(node_base * & root) {
+        node_base * right_tree = root->right;
+        root->right = right_tree->left;
+        assign_parent(root->right, root);
+        right_tree->left = root;
+        right_tree->parent = root->parent;
+        root->parent = right_tree;
+        root = right_tree;
+        update_height(root->left);
+        update_height(root);
+    }
+
+    void rotate_right(node_base * & root) {
+        node_base * left_tree = root->left;
+        root->left = left_tree->right;
+        assign_parent(root->left, root);
+        left_tree->right = root;
+        left_tree->parent = root->parent;
+        root->parent = left_tree;
+        root = left_tree;
+        update_height(root->right);
+        update_height(root);
+    }
+
+    // Desengancha y libera a n y rebalancea
+    void erase_node(node_base * n) {
+        node_base * rebalance_start;
+        if (n->left != nullptr && n->right != nullptr) {
+            // Pone en el lugar de n a su predecesor (el máximo del subárbol
+            // izquierdo), desenganchándolo antes de su posición original.
+            // Su max_high se recalcula al pasar rebalance_from por él.
+            node_base * max = n->left->find_maximum();
+            rebalance_start = max->parent == n ? max : max->parent;
+            link_to(max) = max->left;
+            assign_parent(max->left, max->parent);
+            max->left = n->left;
+            max->right = n->right;
+            assign_parent(max->left, max);
+            assign_parent(max->right, max);
+            max->parent = n->parent;
+            max->height = n->height;
+            link_to(n) = max;
+        } else {
+            node_base * child = n->left != nullptr ? n->left : n->right;
+            rebalance_start = n->parent;
+            link_to(n) = child;
+            assign_parent(child, n->parent);
+        }
+        rebalance_from(rebalance_start);
+        delete static_cast<node *>(n);
+    }
+
+    // Borra los nodos sin recursión ni pila: baja hasta una hoja, la borra y
+    // vuelve a su padre, que eventualmente se convierte también en hoja.
+    void do_clear(node_base * current) {
+        assign_parent(current, nullptr);
+        while (current != nullptr) {
+            if (current->left != nullptr) {
+                current = current->left;
+            } else if (current->right != nullptr) {
+                current = current->right;
+            } else {
+                node_base * parent = current->parent;
+                if (parent != nullptr) {
+                    if (parent->left == current) {
+                        parent->left = nullptr;
+                    } else {
+                        parent->right = nullptr;
+                    }
+                }
+                delete static_cast<node *>(current);
+                current = parent;
+            }
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
+        if (current != nullptr) {
+            calculate_nodes_placement(current->left, x, h+1, placements);
+            placements.emplace_back(h, x++, current);
+            calculate_nodes_placement(current->right, x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando
+    // caracteres ASCII. Cada nodo se muestra como low,high:max_high.
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_header.left, count, 0, placements);
+
+        const int node_value_size = 9;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node_base * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            std::ostringstream label;
+            label << value_of(the_node).low << ',' << value_of(the_node).high << ':' << max_high_of(the_node);
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << label.str();
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // INTERVAL_TREE_H
@@ -0,0 +1,120 @@
+#include "interval_tree.h"
+#include "../benchmark/measure.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+ostream & operator<<(ostream & out, interval_tree<T> & t) {
+    out << "interval_tree { ";
+    for (const auto & x : t) {
+        out << "[" << x.low << ", " << x.high << "] ";
+    }
+    out << "}" << endl << t.str();
+    return out;
+}
+
+using intervals = vector<interval_tree<long>::interval>;
+
+// Busca linealmente los intervalos que contienen a point
+long count_containing(const intervals & all, long point) {
+    long count = 0;
+    for (const auto & x : all) {
+        count += x.low <= point && point <= x.high;
+    }
+    return count;
+}
+
+int main() {
+    cout << ":: Insertando intervalos en t1:" << endl;
+    interval_tree<int> t1;
+    for (auto x : {make_pair(15, 20), make_pair(10, 30), make_pair(17, 19), make_pair(5, 20),
+                   make_pair(12, 15), make_pair(30, 40), make_pair(1, 3), make_pair(25, 26)}) {
+        t1.insert(x.first, x.second);
+    }
+    cout << "  t1 = " << t1 << endl;
+
+    for (int point : {0, 14, 18, 27}) {
+        cout << ":: Intervalos de t1 que contienen a " << point << " => ";
+        t1.each_containing(point, [](const interval_tree<int>::interval & x) {
+            cout << "[" << x.low << ", " << x.high << "] ";
+        });
+        cout << endl;
+    }
+
+    cout << ":: Intervalos de t1 que se solapan con [21, 29] => ";
+    t1.each_overlapping(21, 29, [](const interval_tree<int>::interval & x) {
+        cout << "[" << x.low << ", " << x.high << "] ";
+    });
+    cout << endl;
+    auto p = t1.find_overlapping(41, 50);
+    cout << ":: ¿Alguno se solapa con [41, 50]? " << boolalpha << (p != t1.end()) << endl;
+
+    for (auto x : {make_pair(10, 30), make_pair(30, 40), make_pair(2, 3)}) {
+        cout << ":: Borrando [" << x.first << ", " << x.second << "] de t1 => "
+             << t1.erase(x.first, x.second).first << endl;
+    }
+    cout << "  t1 = " << t1 << endl;
+
+    cout << ":: Creando t2 en forma masiva a partir de intervalos ordenados:" << endl;
+    vector<interval_tree<int>::interval> sorted;
+    for (int x = 0; x < 10; ++x) {
+        sorted.push_back({ 3 * x, 3 * x + x % 4 });
+    }
+    interval_tree<int> t2(sorted.begin(), sorted.end());
+    cout << "  t2 = " << t2 << endl;
+
+    const int n = 1000000;
+    const int queries = 200000;
+    const int linear_queries = 200;
+    const long horizon = 1000000000;
+    cout << ":: " << n << " intervalos de tiempo al azar en [0, " << horizon << "), de hasta 20000 unidades:" << endl;
+    mt19937_64 rng(42);
+    intervals all(n);
+    for (auto & x : all) {
+        x.low = long(rng() % horizon);
+        x.high = x.low + long(rng() % 20000);
+    }
+    intervals unique = all;
+    sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    interval_tree<long> inserted;
+    double insert_time = measure([&] {
+        for (const auto & x : all) {
+            inserted.insert(x.low, x.high);
+        }
+    });
+    interval_tree<long> built;
+    double build_time = measure([&] { built = interval_tree<long>(unique.begin(), unique.end()); });
+    cout << "  insertando uno por uno: " << insert_time << " s, carga masiva de los intervalos ordenados: "
+         << build_time << " s - ¿mismo contenido? " << boolalpha << (inserted == built) << endl;
+
+    vector<long> points(queries);
+    for (auto & point : points) {
+        point = long(rng() % horizon);
+    }
+    long tree_count = 0;
+    double tree_time = measure([&] {
+        for (long point : points) {
+            built.each_containing(point, [&](const interval_tree<long>::interval &) { ++tree_count; });
+        }
+    });
+    long linear_count = 0;
+    long tree_check = 0;
+    double linear_time = measure([&] {
+        for (int i = 0; i < linear_queries; ++i) {
+            linear_count += count_containing(unique, points[i]);
+        }
+    });
+    for (int i = 0; i < linear_queries; ++i) {
+        built.each_containing(points[i], [&](const interval_tree<long>::interval &) { ++tree_check; });
+    }
+    cout << "  consulta de apuñalamiento: árbol " << tree_time / queries * 1e6 << " µs ("
+         << double(tree_count) / queries << " intervalos por consulta), búsqueda lineal "
+         << linear_time / linear_queries * 1e6 << " µs - ¿mismos resultados? " << (tree_check == linear_count) << endl;
+}
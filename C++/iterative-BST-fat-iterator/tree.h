@@ -2,10 +2,10 @@
 #define BINARY_SEARCH_TREE_H
 
 #include <cstddef>    // Para std::size_t
-#include <functional> // Para std::function
-#include <iterator>   // Para std::forward_iterator_tag
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
 #include <stack>      // Para std::stack
 #include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
 
 /************************************************************************************/
 /*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
@@ -16,7 +16,6 @@
 #include <sstream>
 #include <string>
 #include <tuple>
-#include <vector>
 
 /************************************************************************************/
 /*** Árbol Binario de Búsqueda implementado en forma iterativa con iterador pesado **/
@@ -25,23 +24,23 @@
 template <typename T>
 class tree {
 private:
-    struct node {
-        T value;
-        node * left;
-        node * right;
+    // Los enlaces de un nodo; node agrega el valor y m_root tiene sólo esto
+    struct node_base {
+        node_base * left;
+        node_base * right;
 
-        node * find_minimum() {
+        node_base * find_minimum() {
             // Pre-condición: this != nullptr
-            node * current = this;
+            node_base * current = this;
             while (current->left != nullptr) {
                 current = current->left;
             }
             return current;
         }
 
-        node * find_maximum() {
+        node_base * find_maximum() {
             // Pre-condición: this != nullptr
-            node * current = this;
+            node_base * current = this;
             while (current->right != nullptr) {
                 current = current->right;
             }
@@ -49,7 +48,28 @@ private:
         }
     };
 
-    node * m_root;
+    struct node : node_base {
+        T value;
+
+        explicit node(const T & a_value) : value(a_value) {
+            this->left = this->right = nullptr;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // m_root no guarda ningún valor: hace de nodo cabecera, del que cuelga
+    // la raíz por la izquierda. Queda en el fondo de la pila de ancestros de
+    // todos los iteradores y es la posición de end(), desde la que se puede
+    // retroceder al máximo. Como no tiene valor, T no necesita poder
+    // construirse por defecto.
+    node_base m_root;
 
 public:
 
@@ -58,13 +78,13 @@ public:
     /************************************************************************/
 
     tree() {
-        m_root = nullptr;
+        m_root.left = m_root.right = nullptr;
     }
 
     tree(tree & x) {
-        m_root = nullptr;
-        if (x.m_root != nullptr) {
-            copy_nodes(x.m_root);
+        m_root.left = m_root.right = nullptr;
+        if (x.m_root.left != nullptr) {
+            copy_nodes(x.m_root.left);
         }
     }
 
@@ -80,32 +100,54 @@ public:
     friend
     void swap(tree & x, tree & y) {
         using namespace std;
-        swap(x.m_root, y.m_root);
+        swap(x.m_root.left, y.m_root.left);
     }
 
     /************************************************************************/
-    /************* ITERADOR PESADO QUE RECORRE AL ÁRBOL EN ORDEN ************/
+    /****** ITERADOR PESADO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
     /************************************************************************/
 
+    // Como los nodos no tienen enlace al padre, el iterador guarda en una
+    // pila los ancestros del nodo actual, desde la cabecera.
     class iterator {
     private:
-        node * m_current;
-        std::stack<node *> m_parents;
+        node_base * m_current;
+        std::stack<node_base *> m_parents;
+
+        friend class tree;
+
+        // Baja desde current por los hijos izquierdos hasta el mínimo
+        void descend_to_minimum(node_base * current) {
+            while (current->left != nullptr) {
+                m_parents.push(current);
+                current = current->left;
+            }
+            m_current = current;
+        }
+
+        // Baja desde current por los hijos derechos hasta el máximo
+        void descend_to_maximum(node_base * current) {
+            while (current->right != nullptr) {
+                m_parents.push(current);
+                current = current->right;
+            }
+            m_current = current;
+        }
 
     public:
         using value_type = T;
         using pointer = T *;
         using reference = T &;
         using difference_type = std::size_t;
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
 
-        iterator(node * current = nullptr) {
-            m_current = find_minimum(current);
+        iterator() {
+            m_current = nullptr;
         }
 
         reference operator*() {
-            // Precondición: m_current != nullptr
-            return m_current->value;
+            // Precondición: m_current != end()
+            return value_of(m_current);
         }
 
         pointer operator->() {
@@ -122,16 +164,20 @@ public:
             return !(x == y);
         }
 
+        // Al subir desde el máximo se llega a la cabecera, que no tiene hijo
+        // derecho, y la pila queda vacía como la de end().
         iterator & operator++() {
-            // Precondición: m_current != nullptr
+            // Precondición: *this != end()
             if (m_current->right != nullptr) {
-                m_current = m_current->right->find_minimum();
+                m_parents.push(m_current);
+                descend_to_minimum(m_current->right);
             } else {
-                node * prev;
+                node_base * prev;
                 do {
                     prev = m_current;
-                    m_current = m_current->parent;
-                } while (m_current != nullptr and m_current->right == prev);
+                    m_current = m_parents.top();
+                    m_parents.pop();
+                } while (m_current->right == prev);
             }
             return *this;
         }
@@ -141,17 +187,48 @@ public:
             operator++();
             return tmp;
         }
+
+        iterator & operator--() {
+            // Precondición: *this != begin()
+            if (m_current->left != nullptr) {
+                m_parents.push(m_current);
+                descend_to_maximum(m_current->left);
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_parents.top();
+                    m_parents.pop();
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
     };
 
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
     iterator begin() {
-        if (empty()) {
-            return end();
-        }
-        return iterator(m_root->find_minimum());
+        return minimum();
     }
 
     iterator end() {
-        return iterator();
+        iterator result;
+        result.m_current = &m_root;
+        return result;
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
     }
 
     /************************************************************************/
@@ -159,7 +236,7 @@ public:
     /************************************************************************/
 
     bool empty() {
-        return m_root == nullptr;
+        return m_root.left == nullptr;
     }
 
     friend
@@ -181,14 +258,19 @@ public:
     }
 
     iterator find(const T & value) {
-        node * current = m_root;
+        iterator result;
+        result.m_parents.push(&m_root);
+        node_base * current = m_root.left;
         while (current != nullptr) {
-            if (value < current->value) {
+            if (value < value_of(current)) {
+                result.m_parents.push(current);
                 current = current->left;
-            } else if (value > current->value) {
+            } else if (value > value_of(current)) {
+                result.m_parents.push(current);
                 current = current->right;
             } else {
-                return iterator(current);
+                result.m_current = current;
+                return result;
             }
         }
         return end();
@@ -199,20 +281,44 @@ public:
     }
 
     iterator minimum() {
-        if (m_root == nullptr)
-            return end();
-        return iterator(m_root->find_minimum());
+        iterator result;
+        result.descend_to_minimum(&m_root);
+        return result;
     }
 
     iterator maximum() {
-        if (m_root == nullptr)
+        if (empty()) {
             return end();
-        return iterator(m_root->find_maximum());
+        }
+        iterator result;
+        result.m_parents.push(&m_root);
+        result.descend_to_maximum(m_root.left);
+        return result;
+    }
+
+    // Los recorridos no arman iteradores, así que no copian la pila que
+    // lleva cada uno.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
     }
 
-    void each(std::function<void(const T &)> func) {
-        for (const T & x : *this)
-            func(x);
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](const node_base * n) { func(value_of(n)); return true; });
     }
 
     /************************************************************************/
@@ -220,47 +326,41 @@ public:
     /************************************************************************/
 
     iterator insert(const T & value) {
-        node ** ptr = &m_root;
-        node * parent = nullptr;
-        while (*ptr != nullptr) {
-            parent = *ptr;
-            if (value < (*ptr)->value) {
-                ptr = &(*ptr)->left;
-            } else if (value > (*ptr)->value) {
-                ptr = &(*ptr)->right;
-            } else {
-                return iterator(*ptr);
-            }
+        iterator result;
+        node_base ** ptr = find_link(value, result);
+        if (*ptr == nullptr) {
+            *ptr = new node(value);
         }
-        *ptr = new node { value, nullptr, nullptr, parent };
-        return iterator(*ptr);
+        result.m_current = *ptr;
+        return result;
     }
 
+    // Borrar puede mover nodos de lugar, así que la pila del siguiente se
+    // vuelve a armar buscándolo desde la raíz.
     std::pair<bool, iterator> erase(const T & value) {
-        node ** ptr = &m_root;
-        while (*ptr != nullptr) {
-            if (value < (*ptr)->value) {
-                ptr = &(*ptr)->left;
-            } else if (value > (*ptr)->value) {
-                ptr = &(*ptr)->right;
-            } else {
-                iterator next = ++iterator(*ptr);
-                erase_node(*ptr);
-                return { true, next };
-            }
+        iterator position;
+        node_base ** ptr = find_link(value, position);
+        if (*ptr == nullptr) {
+            return { false, end() };
+        }
+        position.m_current = *ptr;
+        node_base * next = (++position).m_current;
+        erase_node(*ptr);
+        if (next == &m_root) {
+            return { true, end() };
         }
-        return { false, end() };
+        return { true, find(value_of(next)) };
     }
 
     void clear() {
-        if (m_root == nullptr) {
+        if (m_root.left == nullptr) {
             return;
         }
-        std::stack<node *> nodes;
-        nodes.push(m_root);
-        m_root = nullptr;
+        std::stack<node_base *> nodes;
+        nodes.push(m_root.left);
+        m_root.left = nullptr;
         while (!nodes.empty()) {
-            node * current = nodes.top();
+            node_base * current = nodes.top();
             nodes.pop();
             if (current->left != nullptr) {
                 nodes.push(current->left);
@@ -268,7 +368,111 @@ public:
             if (current->right != nullptr) {
                 nodes.push(current->right);
             }
-            delete current;
+            delete static_cast<node *>(current);
+        }
+    }
+
+    /************************************************************************/
+    /********** NODOS SUELTOS: EXTRAER, REINSERTAR Y MEZCLAR ÁRBOLES ********/
+    /************************************************************************/
+
+    // Un node_handle es dueño de un nodo sacado del árbol con extract, que
+    // puede volver a insertarse (en éste o en otro árbol, quizás con otro
+    // valor) sin liberar ni pedir memoria. Si se destruye sin reinsertarlo,
+    // libera el nodo.
+    class node_handle {
+    private:
+        node * m_node;
+
+        friend class tree;
+
+        explicit node_handle(node * a_node) {
+            m_node = a_node;
+        }
+
+    public:
+        node_handle() {
+            m_node = nullptr;
+        }
+
+        node_handle(node_handle && x) {
+            m_node = x.m_node;
+            x.m_node = nullptr;
+        }
+
+        node_handle & operator=(node_handle && x) {
+            if (this != &x) {
+                delete m_node;
+                m_node = x.m_node;
+                x.m_node = nullptr;
+            }
+            return *this;
+        }
+
+        ~node_handle() {
+            delete m_node;
+        }
+
+        bool empty() const {
+            return m_node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return !empty();
+        }
+
+        T & value() {
+            // Precondición: !empty()
+            return m_node->value;
+        }
+    };
+
+    // Devuelve un node_handle vacío si value no está en el árbol
+    node_handle extract(const T & value) {
+        iterator position;
+        node_base ** ptr = find_link(value, position);
+        if (*ptr == nullptr) {
+            return node_handle();
+        }
+        return node_handle(static_cast<node *>(unlink_node(*ptr)));
+    }
+
+    // El enlace al nodo está en el último ancestro guardado en el iterador
+    // (la cabecera, si es la raíz)
+    node_handle extract(iterator position) {
+        // Precondición: position != end()
+        node_base * n = position.m_current;
+        node_base * parent = position.m_parents.top();
+        return node_handle(static_cast<node *>(unlink_node(parent->left == n ? parent->left : parent->right)));
+    }
+
+    // Si el valor ya estaba, el nodo queda en handle y devuelve la posición
+    // del que ya estaba junto con false.
+    std::pair<iterator, bool> insert(node_handle && handle) {
+        if (handle.empty()) {
+            return { end(), false };
+        }
+        auto result = insert_node(handle.m_node);
+        if (result.second) {
+            handle.m_node = nullptr;
+        }
+        return result;
+    }
+
+    // Pasa a este árbol los nodos de other cuyos valores no están en éste
+    // (los demás quedan en other). Los nodos se enganchan en pre-orden, así
+    // que los que vuelven a other conservan la forma que tenían.
+    void merge(tree & other) {
+        if (&other == this) {
+            return;
+        }
+        node_base * pending = other.m_root.left;
+        other.m_root.left = nullptr;
+        while (pending != nullptr) {
+            node_base * n = detach_preorder_first(pending);
+            if (!insert_node(n).second) {
+                other.insert_node(n);
+            }
         }
     }
 
@@ -278,29 +482,156 @@ private:
     /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
     /************************************************************************/
 
-    void copy_nodes(node * root) {
+    // Los recorridos usan una pila explícita en lugar de recursión (que, a
+    // diferencia de los enlaces a los padres, visita cada nodo una sola vez).
+    // visit recibe cada nodo y devuelve false para interrumpir el recorrido.
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = m_root.left;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            }
+            current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) {
+        std::vector<node_base *> pending;
+        if (m_root.left != nullptr) {
+            pending.push_back(m_root.left);
+        }
+        while (!pending.empty()) {
+            node_base * current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending.push_back(current->right);
+            }
+            if (current->left != nullptr) {
+                pending.push_back(current->left);
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = m_root.left;
+        node_base * last = nullptr;
+        while (current != nullptr || !pending.empty()) {
+            if (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            } else {
+                node_base * top = pending.back();
+                if (top->right != nullptr && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    pending.pop_back();
+                }
+            }
+        }
+        return true;
+    }
+
+    void copy_nodes(node_base * root) {
         struct info {
-            node * from;
-            node * & to;
-            node * parent;
+            node_base * from;
+            node_base * & to;
         };
         std::stack<info> nodes;
-        nodes.push({ root, m_root, nullptr });
+        nodes.push({ root, m_root.left });
         while (!nodes.empty()) {
             auto data = nodes.top();
             nodes.pop();
-            data.to = new node { data.from->value, nullptr, nullptr, data.parent };
+            data.to = new node(value_of(data.from));
             if (data.from->left != nullptr) {
-                nodes.push({ data.from->left, data.to->left, data.to });
+                nodes.push({ data.from->left, data.to->left });
             }
             if (data.from->right != nullptr) {
-                nodes.push({ data.from->right, data.to->right, data.to });
+                nodes.push({ data.from->right, data.to->right });
+            }
+        }
+    }
+
+    // Devuelve el enlace donde está (o debería estar) value, dejando en la
+    // pila de path la cabecera y los nodos recorridos para llegar hasta él.
+    node_base ** find_link(const T & value, iterator & path) {
+        path.m_parents.push(&m_root);
+        node_base ** ptr = &m_root.left;
+        while (*ptr != nullptr) {
+            if (value < value_of(*ptr)) {
+                path.m_parents.push(*ptr);
+                ptr = &(*ptr)->left;
+            } else if (value > value_of(*ptr)) {
+                path.m_parents.push(*ptr);
+                ptr = &(*ptr)->right;
+            } else {
+                break;
             }
         }
+        return ptr;
     }
 
-    void erase_node(node * & n) {
-        node * removed = n;
+    // Saca la raíz de pending, un árbol de nodos sueltos que se recorre en
+    // preorden, y deja en pending el resto con el mismo preorden: el
+    // subárbol derecho se cuelga del último nodo en preorden del izquierdo.
+    // Así merge no necesita una pila para recordar los subárboles derechos.
+    static node_base * detach_preorder_first(node_base * & pending) {
+        node_base * first = pending;
+        if (first->left == nullptr) {
+            pending = first->right;
+        } else {
+            pending = first->left;
+            if (first->right != nullptr) {
+                node_base * last = pending;
+                while (last->left != nullptr || last->right != nullptr) {
+                    last = last->right != nullptr ? last->right : last->left;
+                }
+                last->right = first->right;
+            }
+        }
+        return first;
+    }
+
+    // Engancha un nodo suelto como hoja, salvo que su valor ya esté
+    std::pair<iterator, bool> insert_node(node_base * n) {
+        iterator result;
+        node_base ** ptr = find_link(value_of(n), result);
+        bool inserted = *ptr == nullptr;
+        if (inserted) {
+            n->left = n->right = nullptr;
+            *ptr = n;
+        }
+        result.m_current = *ptr;
+        return { result, inserted };
+    }
+
+    void erase_node(node_base * & n) {
+        delete static_cast<node *>(unlink_node(n));
+    }
+
+    // Desengancha (sin liberarlo) al nodo apuntado por el enlace n y lo devuelve
+    node_base * unlink_node(node_base * & n) {
+        node_base * removed = n;
         if (n->left == nullptr) {
             n = n->right;
         } else if (n->right == nullptr) {
@@ -308,39 +639,29 @@ private:
         } else {
             move_maximum_to(n);
         }
-        assign_parent(n, removed->parent);
-        delete removed;
+        return removed;
     }
 
-    void move_maximum_to(node * & root) {
-        node ** ptr = &root->left;
+    void move_maximum_to(node_base * & root) {
+        node_base ** ptr = &root->left;
         while ((*ptr)->right != nullptr) {
             ptr = &(*ptr)->right;
         }
-        node * max = *ptr;
-        assign_parent(max->left, max->parent);
+        node_base * max = *ptr;
         *ptr = max->left;
         max->left = root->left;
-        assign_parent(max->left, max);
         max->right = root->right;
-        assign_parent(max->right, max);
         root = max;
     }
 
-    void assign_parent(node * & n, node * parent) {
-        if (n != nullptr) {
-            n->parent = parent;
-        }
-    }
-
 
     /************************************************************************/
     /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
     /************************************************************************/
 
-    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
 
-    void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
         if (current != nullptr) {
             calculate_nodes_placement(current->left, x, h+1, placements);
             placements.emplace_back(h, x++, current);
@@ -354,7 +675,7 @@ public:
         // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
         int count = 0;
         nodes_placement placements;
-        calculate_nodes_placement(m_root, count, 0, placements);
+        calculate_nodes_placement(m_root.left, count, 0, placements);
 
         const int node_value_size = 3;
         std::vector<std::string> lines;
@@ -362,7 +683,7 @@ public:
         for (const auto & placement: placements) {
             int level;
             int pos;
-            const node * the_node;
+            const node_base * the_node;
             std::tie(level, pos, the_node) = placement;
 
             while (int(lines.size()) <= 2 * level) {
@@ -372,7 +693,7 @@ public:
             std::ostringstream s;
             int i = 2 * level;
             s << std::setw(pos * node_value_size - lines[i].size()) << "";
-            s << std::setw(node_value_size) << the_node->value;
+            s << std::setw(node_value_size) << value_of(the_node);
             lines[i] += s.str();
 
             if (prev_level != -1) {
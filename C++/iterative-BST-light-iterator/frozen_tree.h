@@ -0,0 +1,280 @@
+#ifndef FROZEN_TREE_H
+#define FROZEN_TREE_H
+
+#include <cstddef>    // Para std::size_t
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <utility>    // Para std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/********* Árbol de búsqueda inmutable guardado en un arreglo (orden Eytzinger) *****/
+/************************************************************************************/
+
+// Los valores se guardan en el orden en que se recorrería un árbol binario
+// completo por niveles: la raíz es el nodo 1 y los hijos del nodo k son los
+// nodos 2k y 2k+1 (el nodo k está en m_values[k - 1]). No hace falta guardar
+// enlaces, y los primeros niveles, que se visitan en todas las búsquedas,
+// quedan juntos al principio del arreglo y permanecen en la caché.
+//
+// La búsqueda no tiene saltos condicionales que dependan de los valores, así
+// que el procesador no pierde tiempo por predicciones fallidas y puede pedir
+// por adelantado (prefetch) la línea de caché de los nodos que visitará unos
+// niveles más abajo.
+
+template <typename T>
+class frozen_tree {
+private:
+    std::vector<T> m_values;
+
+    // Los descendientes de k que están log2(prefetch_stride) niveles más abajo
+    // ocupan prefetch_stride posiciones consecutivas (una línea de caché) a
+    // partir de k * prefetch_stride.
+    static const std::size_t prefetch_stride = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+public:
+
+    /************************************************************************/
+    /******************* CONSTRUCTORES, ASIGNACIÓN Y SWAP *******************/
+    /************************************************************************/
+
+    frozen_tree() {
+    }
+
+    // Precondición: sorted está ordenado y no tiene valores repetidos
+    explicit frozen_tree(const std::vector<T> & sorted) {
+        m_values = sorted;
+        fill(sorted);
+    }
+
+    friend
+    void swap(frozen_tree & x, frozen_tree & y) {
+        using namespace std;
+        swap(x.m_values, y.m_values);
+    }
+
+    /************************************************************************/
+    /*********** ITERADOR QUE RECORRE LOS VALORES EN ORDEN CRECIENTE ********/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        const frozen_tree * m_tree;
+        std::size_t m_current;  // 0 representa al final
+
+    public:
+        using value_type = T;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(const frozen_tree * tree = nullptr, std::size_t current = 0) {
+            m_tree = tree;
+            m_current = current;
+        }
+
+        reference operator*() {
+            // Precondición: m_current != 0
+            return m_tree->m_values[m_current - 1];
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        // El siguiente es el mínimo del hijo derecho o, si no tiene, el primer
+        // ancestro del que se llega bajando por la izquierda.
+        iterator & operator++() {
+            // Precondición: m_current != 0
+            std::size_t n = m_tree->m_values.size();
+            if (2 * m_current + 1 <= n) {
+                m_current = 2 * m_current + 1;
+                while (2 * m_current <= n) {
+                    m_current = 2 * m_current;
+                }
+            } else {
+                while (m_current % 2 == 1) {
+                    m_current /= 2;
+                }
+                m_current /= 2;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        // Simétrico a operator++: el máximo del hijo izquierdo o el primer
+        // ancestro del que se llega bajando por la derecha. Desde end() se
+        // va al máximo del árbol.
+        iterator & operator--() {
+            // Precondición: *this != m_tree->begin()
+            if (m_current == 0) {
+                *this = m_tree->maximum();
+                return *this;
+            }
+            std::size_t n = m_tree->m_values.size();
+            if (2 * m_current <= n) {
+                m_current = 2 * m_current;
+                while (2 * m_current + 1 <= n) {
+                    m_current = 2 * m_current + 1;
+                }
+            } else {
+                while (m_current % 2 == 0) {
+                    m_current /= 2;
+                }
+                m_current /= 2;
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() const {
+        if (empty())
+            return end();
+        return minimum();
+    }
+
+    iterator end() const {
+        return iterator(this, 0);
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL (NO SE PUEDE MODIFICAR) */
+    /************************************************************************/
+
+    bool empty() const {
+        return m_values.empty();
+    }
+
+    std::size_t size() const {
+        return m_values.size();
+    }
+
+    iterator find(const T & value) const {
+        std::size_t k = lower_bound_index(value);
+        if (k == 0 || value < m_values[k - 1]) {
+            return end();
+        }
+        return iterator(this, k);
+    }
+
+    bool contains(const T & value) const {
+        return find(value) != end();
+    }
+
+    // Devuelve el primer valor que no es menor a value
+    iterator lower_bound(const T & value) const {
+        return iterator(this, lower_bound_index(value));
+    }
+
+    iterator minimum() const {
+        if (empty())
+            return end();
+        std::size_t k = 1;
+        while (2 * k <= m_values.size()) {
+            k = 2 * k;
+        }
+        return iterator(this, k);
+    }
+
+    iterator maximum() const {
+        if (empty())
+            return end();
+        std::size_t k = 1;
+        while (2 * k + 1 <= m_values.size()) {
+            k = 2 * k + 1;
+        }
+        return iterator(this, k);
+    }
+
+    template <typename F>
+    void each(F func) const {
+        for (auto p = begin(); p != end(); ++p) {
+            func(*p);
+        }
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Reparte los valores ordenados recorriendo en orden el árbol implícito
+    // con una pila explícita, como los recorridos de tree.
+    void fill(const std::vector<T> & sorted) {
+        std::vector<std::size_t> pending;
+        std::size_t n = m_values.size();
+        std::size_t next = 0;
+        std::size_t k = 1;
+        while (k <= n || !pending.empty()) {
+            while (k <= n) {
+                pending.push_back(k);
+                k = 2 * k;
+            }
+            k = pending.back();
+            pending.pop_back();
+            m_values[k - 1] = sorted[next++];
+            k = 2 * k + 1;
+        }
+    }
+
+    // Baja siempre hasta pasar una hoja, yendo a la derecha cuando el valor
+    // del nodo es menor a value. El resultado es el último nodo en el que se
+    // fue a la izquierda, que se obtiene quitando de k los últimos bits 1
+    // (los giros a la derecha) y el 0 que los precede. Devuelve 0 si todos
+    // los valores son menores a value.
+    std::size_t lower_bound_index(const T & value) const {
+        const T * values = m_values.data();
+        std::size_t n = m_values.size();
+        std::size_t k = 1;
+        while (k <= n) {
+#ifdef __GNUC__
+            // El nodo j está en values[j - 1]. Pedir una dirección más allá
+            // del final no falla: prefetch es sólo una sugerencia.
+            __builtin_prefetch(values + k * prefetch_stride - 1);
+#endif
+            k = 2 * k + (values[k - 1] < value);
+        }
+#ifdef __GNUC__
+        return k >> __builtin_ffsll(~static_cast<long long>(k));
+#else
+        while (k % 2 == 1) {
+            k /= 2;
+        }
+        return k / 2;
+#endif
+    }
+};
+
+#endif // FROZEN_TREE_H
@@ -1,7 +1,12 @@
 #include "tree.h"
+#include "../benchmark/measure.h"
 
+#include <algorithm>
 #include <iostream>
+#include <random>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -81,6 +86,11 @@ int main() {
 
     cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
     cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+    cout << ":: Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << *p << " ";
+    }
+    cout << endl;
 
     cout << "  t1 = " << t1 << endl;
     for (int x : {8, 12, 4, 10, 42}) {
@@ -98,6 +108,22 @@ int main() {
         cout << "  t2 = " << t2 << endl;
     }
 
+    cout << ":: Cambiando el 3 de t2 por un 30 sin pedir memoria:" << endl;
+    auto nodo = t2.extract(3);
+    nodo.value() = 30;
+    t2.insert(move(nodo));
+    cout << "  t2 = " << t2 << endl;
+
+    cout << ":: Sacando el mínimo de t2 y volviéndolo a poner:" << endl;
+    t2.insert(t2.extract(t2.begin()));
+    cout << "  t2 = " << t2 << endl;
+
+    cout << ":: Mezclando una copia de t1 con t2:" << endl;
+    tree<int> otro = t1;
+    t2.merge(otro);
+    cout << "  t2 = " << t2 << endl;
+    cout << "  otro = " << otro << " (los valores que ya estaban en t2 quedan en otro)" << endl;
+
     cout << ":: Asignando t2 = t1:" << endl;
     t2 = t1;
     cout << "  t1 = " << t1 << " - ¿t1 está vacio? " << t1.empty() << endl;
@@ -124,4 +150,37 @@ int main() {
         letras.insert(c);
     }
     cout << "  Letras en '" << texto << "': " << letras << endl;
+
+    cout << ":: Congelando el árbol de letras => " << endl;
+    auto congeladas = letras.freeze();
+    cout << "  Letras congeladas: { ";
+    congeladas.each([](char c) { cout << c << ' '; });
+    cout << "}" << endl;
+    cout << "  ¿Contiene a 'U'? " << boolalpha << congeladas.contains('U') << endl;
+    cout << "  ¿Contiene a 'Z'? " << boolalpha << congeladas.contains('Z') << endl;
+    cout << "  Primera letra no menor a 'F' => " << *congeladas.lower_bound('F') << endl;
+
+    cout << endl << ":: Comparando búsquedas en el árbol y en su copia congelada (1000000 valores):" << endl;
+    const int n = 1000000;
+    mt19937 rng(42);
+    vector<int> values(n);
+    tree<int> t3;
+    for (auto & x : values) {
+        x = int(rng() % (2 * n));
+        t3.insert(x);
+    }
+    auto frozen = t3.freeze();
+    int found = 0;
+    double tree_time = measure([&] {
+        for (int x : values)
+            found += t3.contains(x + 1);
+    });
+    double frozen_time = measure([&] {
+        for (int x : values)
+            found -= frozen.contains(x + 1);
+    });
+    cout << "  árbol: " << tree_time << " s, congelado: " << frozen_time << " s" << endl;
+    cout << "  ¿mismos resultados? " << boolalpha << (found == 0) << endl;
+    cout << "  ¿recorrido al revés igual al del árbol? "
+         << equal(frozen.rbegin(), frozen.rend(), t3.rbegin()) << endl;
 }
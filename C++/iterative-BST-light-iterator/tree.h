@@ -2,10 +2,12 @@
 #define BINARY_SEARCH_TREE_H
 
 #include <cstddef>    // Para std::size_t
-#include <functional> // Para std::function
-#include <iterator>   // Para std::forward_iterator_tag
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
 #include <stack>      // Para std::stack
 #include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
+
+#include "frozen_tree.h"
 
 /************************************************************************************/
 /*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
@@ -16,7 +18,6 @@
 #include <sstream>
 #include <string>
 #include <tuple>
-#include <vector>
 
 /************************************************************************************/
 /** Árbol Binario de Búsqueda implementado en forma iterativa con iterador liviano **/
@@ -25,24 +26,24 @@
 template <typename T>
 class tree {
 private:
-    struct node {
-        T value;
-        node * left;
-        node * right;
-        node * parent;
+    // Los enlaces de un nodo; node agrega el valor y m_root tiene sólo esto
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
 
-        node * find_minimum() {
+        node_base * find_minimum() {
             // Pre-condición: this != nullptr
-            node * current = this;
+            node_base * current = this;
             while (current->left != nullptr) {
                 current = current->left;
             }
             return current;
         }
 
-        node * find_maximum() {
+        node_base * find_maximum() {
             // Pre-condición: this != nullptr
-            node * current = this;
+            node_base * current = this;
             while (current->right != nullptr) {
                 current = current->right;
             }
@@ -50,7 +51,26 @@ private:
         }
     };
 
-    node * m_root;
+    struct node : node_base {
+        T value;
+
+        node(const T & a_value, node_base * a_parent) : value(a_value) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // m_root no guarda ningún valor: hace de nodo cabecera, del que cuelga
+    // la raíz por la izquierda, y es la posición de end().
+    node_base m_root;
 
 public:
 
@@ -59,12 +79,12 @@ public:
     /************************************************************************/
 
     tree() {
-        m_root = nullptr;
+        m_root.left = m_root.right = m_root.parent = nullptr;
     }
 
     tree(tree & x) {
-        m_root = nullptr;
-        if (x.m_root != nullptr) {
+        m_root.left = m_root.right = m_root.parent = nullptr;
+        if (x.m_root.left != nullptr) {
             copy_nodes(x.m_root);
         }
     }
@@ -82,30 +102,34 @@ public:
     void swap(tree & x, tree & y) {
         using namespace std;
         swap(x.m_root, y.m_root);
+        x.assign_parent(x.m_root.left, &x.m_root);
+        y.assign_parent(y.m_root.left, &y.m_root);
     }
 
     /************************************************************************/
-    /************ ITERADOR LIVIANO QUE RECORRE AL ÁRBOL EN ORDEN ************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
     /************************************************************************/
 
     class iterator {
     private:
-        node * m_current;
+        node_base * m_current;
+
+        friend class tree;
 
     public:
         using value_type = T;
         using pointer = T *;
         using reference = T &;
         using difference_type = std::size_t;
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
 
-        iterator(node * current = nullptr) {
+        iterator(node_base * current = nullptr) {
             m_current = current;
         }
 
         reference operator*() {
-            // Precondición: m_current != nullptr
-            return m_current->value;
+            // Precondición: m_current != end()
+            return value_of(m_current);
         }
 
         pointer operator->() {
@@ -123,15 +147,15 @@ public:
         }
 
         iterator & operator++() {
-            // Precondición: m_current != nullptr
+            // Precondición: m_current != end()
             if (m_current->right != nullptr) {
                 m_current = m_current->right->find_minimum();
             } else {
-                node * prev;
+                node_base * prev;
                 do {
                     prev = m_current;
                     m_current = m_current->parent;
-                } while (m_current != nullptr and m_current->right == prev);
+                } while (m_current->right == prev);
             }
             return *this;
         }
@@ -141,17 +165,44 @@ public:
             operator++();
             return tmp;
         }
+
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
     };
 
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
     iterator begin() {
-        if (empty()) {
-            return end();
-        }
-        return iterator(m_root->find_minimum());
+        return iterator(m_root.find_minimum());
     }
 
     iterator end() {
-        return iterator();
+        return iterator(&m_root);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
     }
 
     /************************************************************************/
@@ -159,7 +210,7 @@ public:
     /************************************************************************/
 
     bool empty() {
-        return m_root == nullptr;
+        return m_root.left == nullptr;
     }
 
     friend
@@ -181,11 +232,11 @@ public:
     }
 
     iterator find(const T & value) {
-        node * current = m_root;
+        node_base * current = m_root.left;
         while (current != nullptr) {
-            if (value < current->value) {
+            if (value < value_of(current)) {
                 current = current->left;
-            } else if (value > current->value) {
+            } else if (value > value_of(current)) {
                 current = current->right;
             } else {
                 return iterator(current);
@@ -199,20 +250,49 @@ public:
     }
 
     iterator minimum() {
-        if (m_root == nullptr)
+        if (m_root.left == nullptr)
             return end();
-        return m_root->find_minimum();
+        return m_root.left->find_minimum();
     }
 
     iterator maximum() {
-        if (m_root == nullptr)
+        if (m_root.left == nullptr)
             return end();
-        return m_root->find_maximum();
+        return m_root.left->find_maximum();
+    }
+
+    // Los recorridos usan la pila de visit_in_order en lugar de subir por
+    // los enlaces a los padres como el iterador.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](const node_base * n) { func(value_of(n)); return true; });
     }
 
-    void each(std::function<void(const T &)> func) {
-        for (const T & x : *this)
-            func(x);
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Devuelve una copia inmutable del árbol guardada en un arreglo, en la
+    // que find y contains son bastante más rápidos. Conviene cuando el árbol
+    // se arma una vez y después sólo se consulta.
+    frozen_tree<T> freeze() {
+        std::vector<T> sorted;
+        visit_in_order([&](const node_base * n) { sorted.push_back(value_of(n)); return true; });
+        return frozen_tree<T>(sorted);
     }
 
     /************************************************************************/
@@ -220,28 +300,20 @@ public:
     /************************************************************************/
 
     iterator insert(const T & value) {
-        node ** ptr = &m_root;
-        node * parent = nullptr;
-        while (*ptr != nullptr) {
-            parent = *ptr;
-            if (value < (*ptr)->value) {
-                ptr = &(*ptr)->left;
-            } else if (value > (*ptr)->value) {
-                ptr = &(*ptr)->right;
-            } else {
-                return { *ptr };
-            }
+        node_base * parent;
+        node_base ** ptr = find_link(value, parent);
+        if (*ptr == nullptr) {
+            *ptr = new node(value, parent);
         }
-        *ptr = new node { value, nullptr, nullptr, parent };
-        return { *ptr };
+        return iterator { *ptr };
     }
 
     std::pair<bool, iterator> erase(const T & value) {
-        node ** ptr = &m_root;
+        node_base ** ptr = &m_root.left;
         while (*ptr != nullptr) {
-            if (value < (*ptr)->value) {
+            if (value < value_of(*ptr)) {
                 ptr = &(*ptr)->left;
-            } else if (value > (*ptr)->value) {
+            } else if (value > value_of(*ptr)) {
                 ptr = &(*ptr)->right;
             } else {
                 iterator next = ++iterator(*ptr);
@@ -253,14 +325,14 @@ public:
     }
 
     void clear() {
-        if (m_root == nullptr) {
+        if (m_root.left == nullptr) {
             return;
         }
-        std::stack<node *> nodes;
-        nodes.push(m_root);
-        m_root = nullptr;
+        std::stack<node_base *> nodes;
+        nodes.push(m_root.left);
+        m_root.left = nullptr;
         while (!nodes.empty()) {
-            node * current = nodes.top();
+            node_base * current = nodes.top();
             nodes.pop();
             if (current->left != nullptr) {
                 nodes.push(current->left);
@@ -268,7 +340,108 @@ public:
             if (current->right != nullptr) {
                 nodes.push(current->right);
             }
-            delete current;
+            delete static_cast<node *>(current);
+        }
+    }
+
+    /************************************************************************/
+    /********** NODOS SUELTOS: EXTRAER, REINSERTAR Y MEZCLAR ÁRBOLES ********/
+    /************************************************************************/
+
+    // Un node_handle es dueño de un nodo sacado del árbol con extract, que
+    // puede volver a insertarse (en éste o en otro árbol, quizás con otro
+    // valor) sin liberar ni pedir memoria. Si se destruye sin reinsertarlo,
+    // libera el nodo.
+    class node_handle {
+    private:
+        node * m_node;
+
+        friend class tree;
+
+        explicit node_handle(node * a_node) {
+            m_node = a_node;
+        }
+
+    public:
+        node_handle() {
+            m_node = nullptr;
+        }
+
+        node_handle(node_handle && x) {
+            m_node = x.m_node;
+            x.m_node = nullptr;
+        }
+
+        node_handle & operator=(node_handle && x) {
+            if (this != &x) {
+                delete m_node;
+                m_node = x.m_node;
+                x.m_node = nullptr;
+            }
+            return *this;
+        }
+
+        ~node_handle() {
+            delete m_node;
+        }
+
+        bool empty() const {
+            return m_node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return !empty();
+        }
+
+        T & value() {
+            // Precondición: !empty()
+            return m_node->value;
+        }
+    };
+
+    // Devuelve un node_handle vacío si value no está en el árbol
+    node_handle extract(const T & value) {
+        iterator position = find(value);
+        if (position == end()) {
+            return node_handle();
+        }
+        return extract(position);
+    }
+
+    node_handle extract(iterator position) {
+        // Precondición: position != end()
+        node_base * n = position.m_current;
+        unlink_node(link_to(n));
+        return node_handle(static_cast<node *>(n));
+    }
+
+    // Si el valor ya estaba, el nodo queda en handle y devuelve la posición
+    // del que ya estaba junto con false.
+    std::pair<iterator, bool> insert(node_handle && handle) {
+        if (handle.empty()) {
+            return { end(), false };
+        }
+        auto result = insert_node(handle.m_node);
+        if (result.second) {
+            handle.m_node = nullptr;
+        }
+        return result;
+    }
+
+    // Pasa a este árbol los nodos de other cuyos valores no están en éste
+    // (los demás quedan en other). Los nodos se enganchan en pre-orden, así
+    // que los que vuelven a other conservan la forma que tenían.
+    void merge(tree & other) {
+        if (&other == this) {
+            return;
+        }
+        node_base * pending = other.m_root.left;
+        other.m_root.left = nullptr;
+        while (pending != nullptr) {
+            node_base * n = detach_preorder_first(pending);
+            if (!insert_node(n).second) {
+                other.insert_node(n);
+            }
         }
     }
 
@@ -278,18 +451,88 @@ private:
     /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
     /************************************************************************/
 
-    void copy_nodes(node * root) {
+    // Los recorridos usan una pila explícita en lugar de recursión (que, a
+    // diferencia de los enlaces a los padres, visita cada nodo una sola vez).
+    // visit recibe cada nodo y devuelve false para interrumpir el recorrido.
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = m_root.left;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            }
+            current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) {
+        std::vector<node_base *> pending;
+        if (m_root.left != nullptr) {
+            pending.push_back(m_root.left);
+        }
+        while (!pending.empty()) {
+            node_base * current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending.push_back(current->right);
+            }
+            if (current->left != nullptr) {
+                pending.push_back(current->left);
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = m_root.left;
+        node_base * last = nullptr;
+        while (current != nullptr || !pending.empty()) {
+            if (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            } else {
+                node_base * top = pending.back();
+                if (top->right != nullptr && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    pending.pop_back();
+                }
+            }
+        }
+        return true;
+    }
+
+    void copy_nodes(node_base & root) {
         struct info {
-            node * from;
-            node * & to;
-            node * parent;
+            node_base * from;
+            node_base * & to;
+            node_base * parent;
         };
         std::stack<info> nodes;
-        nodes.push({ root, m_root, nullptr });
+        nodes.push({ root.left, m_root.left, &m_root });
         while (!nodes.empty()) {
             auto data = nodes.top();
             nodes.pop();
-            data.to = new node { data.from->value, nullptr, nullptr, data.parent };
+            data.to = new node(value_of(data.from), data.parent);
             if (data.from->left != nullptr) {
                 nodes.push({ data.from->left, data.to->left, data.to });
             }
@@ -299,8 +542,71 @@ private:
         }
     }
 
-    void erase_node(node * & n) {
-        node * removed = n;
+    // Devuelve el enlace donde está (o debería estar) value y deja en parent
+    // al nodo del que cuelga ese enlace.
+    node_base ** find_link(const T & value, node_base * & parent) {
+        node_base ** ptr = &m_root.left;
+        parent = &m_root;
+        while (*ptr != nullptr) {
+            if (value < value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->left;
+            } else if (value > value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->right;
+            } else {
+                break;
+            }
+        }
+        return ptr;
+    }
+
+    // Saca la raíz de pending, un árbol de nodos sueltos que se recorre en
+    // preorden, y deja en pending el resto con el mismo preorden: el
+    // subárbol derecho se cuelga del último nodo en preorden del izquierdo.
+    // Así merge no necesita una pila para recordar los subárboles derechos.
+    static node_base * detach_preorder_first(node_base * & pending) {
+        node_base * first = pending;
+        if (first->left == nullptr) {
+            pending = first->right;
+        } else {
+            pending = first->left;
+            if (first->right != nullptr) {
+                node_base * last = pending;
+                while (last->left != nullptr || last->right != nullptr) {
+                    last = last->right != nullptr ? last->right : last->left;
+                }
+                last->right = first->right;
+            }
+        }
+        return first;
+    }
+
+    // Engancha un nodo suelto como hoja, salvo que su valor ya esté
+    std::pair<iterator, bool> insert_node(node_base * n) {
+        node_base * parent;
+        node_base ** ptr = find_link(value_of(n), parent);
+        if (*ptr != nullptr) {
+            return { iterator(*ptr), false };
+        }
+        n->left = n->right = nullptr;
+        n->parent = parent;
+        *ptr = n;
+        return { iterator(n), true };
+    }
+
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de m_root)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    void erase_node(node_base * & n) {
+        delete static_cast<node *>(unlink_node(n));
+    }
+
+    // Desengancha (sin liberarlo) al nodo apuntado por el enlace n y lo devuelve
+    node_base * unlink_node(node_base * & n) {
+        node_base * removed = n;
         if (n->left == nullptr) {
             n = n->right;
         } else if (n->right == nullptr) {
@@ -309,15 +615,15 @@ private:
             move_maximum_to(n);
         }
         assign_parent(n, removed->parent);
-        delete removed;
+        return removed;
     }
 
-    void move_maximum_to(node * & root) {
-        node ** ptr = &root->left;
+    void move_maximum_to(node_base * & root) {
+        node_base ** ptr = &root->left;
         while ((*ptr)->right != nullptr) {
             ptr = &(*ptr)->right;
         }
-        node * max = *ptr;
+        node_base * max = *ptr;
         assign_parent(max->left, max->parent);
         *ptr = max->left;
         max->left = root->left;
@@ -327,7 +633,7 @@ private:
         root = max;
     }
 
-    void assign_parent(node * & n, node * parent) {
+    void assign_parent(node_base * & n, node_base * parent) {
         if (n != nullptr) {
             n->parent = parent;
         }
@@ -337,10 +643,10 @@ private:
     /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
     /************************************************************************/
 
-    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
 
     // Calcula la posición de los nodos para poder mostrarlos en pantalla
-    void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
         if (current != nullptr) {
             calculate_nodes_placement(current->left, x, h+1, placements);
             placements.emplace_back(h, x++, current);
@@ -354,7 +660,7 @@ public:
     std::string str() const {
         int count = 0;
         nodes_placement placements;
-        calculate_nodes_placement(m_root, count, 0, placements);
+        calculate_nodes_placement(m_root.left, count, 0, placements);
 
         const int node_value_size = 3;
         std::vector<std::string> lines;
@@ -362,7 +668,7 @@ public:
         for (const auto & placement: placements) {
             int level;
             int pos;
-            const node * the_node;
+            const node_base * the_node;
             std::tie(level, pos, the_node) = placement;
 
             while (int(lines.size()) <= 2 * level) {
@@ -372,7 +678,7 @@ public:
             std::ostringstream s;
             int i = 2 * level;
             s << std::setw(pos * node_value_size - lines[i].size()) << "";
-            s << std::setw(node_value_size) << the_node->value;
+            s << std::setw(node_value_size) << value_of(the_node);
             lines[i] += s.str();
 
             if (prev_level != -1) {
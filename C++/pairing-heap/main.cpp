@@ -0,0 +1,164 @@
+#include "pairing_heap.h"
+#include "rank_pairing_heap.h"
+#include "../priority_queue/priority_queue.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename P, typename T, typename C>
+ostream & operator<<(ostream & out, pairing_heap<P, T, C> & h) {
+    out << "pairing_heap { ";
+    h.each([&](const P & p, T & v) { out << p << ":" << v << " "; });
+    out << "}";
+    return out;
+}
+
+// Juntar dos priority_queue es volver a meter todos los elementos de una en
+// la otra
+void meld(priority_queue<int, int> & x, priority_queue<int, int> & y) {
+    while (!y.empty()) {
+        int priority = y.top().first;
+        x.push(priority, y.pop_top());
+    }
+}
+
+void meld(pairing_heap<int, int> & x, pairing_heap<int, int> & y) {
+    x.meld(y);
+}
+
+void meld(rank_pairing_heap<int, int> & x, rank_pairing_heap<int, int> & y) {
+    x.meld(y);
+}
+
+// Operaciones al azar sobre shards colas: push, pop y, cada tanto, juntar
+// dos colas. Devuelve una suma de control de los elementos sacados.
+template <typename Queue>
+long long mixed_workload(int shards, int operations, int meld_per_mille) {
+    vector<Queue> queues(shards);
+    mt19937 rng(42);
+    long long checksum = 0;
+    for (int i = 0; i < operations; ++i) {
+        auto & q = queues[rng() % shards];
+        unsigned op = rng() % 1000;
+        if (op < unsigned(meld_per_mille)) {
+            auto & other = queues[rng() % shards];
+            if (&other != &q) {
+                meld(q, other);
+            }
+        } else if (op < 600 || q.empty()) {
+            int priority = int(rng() % 1000000);
+            q.push(priority, i);
+        } else {
+            checksum += q.top().first;
+            q.pop();
+        }
+    }
+    return checksum;
+}
+
+// Como en Dijkstra: mete n elementos y después, antes de cada pop, baja la
+// prioridad de decreases elementos elegidos al azar que sigan en la cola
+template <typename Heap>
+long long decrease_workload(int n, int decreases) {
+    Heap h;
+    vector<typename Heap::handle> handles(n);
+    vector<bool> in_heap(n, true);
+    mt19937 rng(42);
+    for (int i = 0; i < n; ++i) {
+        handles[i] = h.push(int(rng() % 1000000000), i);
+    }
+    long long checksum = 0;
+    while (!h.empty()) {
+        for (int j = 0; j < decreases; ++j) {
+            int i = int(rng() % n);
+            if (in_heap[i]) {
+                h.decrease_key(handles[i], handles[i].priority() - int(rng() % 1000));
+            }
+        }
+        checksum += h.top().first;
+        in_heap[h.top().second] = false;
+        h.pop();
+    }
+    return checksum;
+}
+
+int main() {
+    pairing_heap<int, string> h1;
+    for (const auto & x : { 5, 3, 7, 1, 4, 2, 6, 0, 8 }) {
+        h1.push(x, "[" + to_string(x) + "]");
+    }
+    cout << "h1 = " << h1 << endl;
+    cout << "Sacando el tope de h1 => " << h1.pop_top() << endl;
+    cout << "h1 después de juntar a los hijos de a pares:" << endl << h1.str();
+
+    cout << endl << "Creando h2 y bajando la prioridad de un elemento:" << endl;
+    pairing_heap<int, string> h2;
+    h2.push(10, "diez");
+    auto twenty = h2.push(20, "veinte");
+    h2.emplace(30, 3, 't');
+    cout << "h2 = " << h2 << endl;
+    h2.decrease_key(twenty, -1);
+    cout << "Después de bajar \"veinte\" a -1, el tope es " << h2.top().first << ":" << h2.top().second << endl;
+
+    cout << endl << "Juntando h2 con h1 (h2 queda vacío):" << endl;
+    h1.meld(h2);
+    cout << "h1 = " << h1 << endl;
+    cout << "h2 = " << h2 << endl;
+    h1.decrease_key(twenty, -5);
+    cout << "El handle de \"veinte\" sigue valiendo en h1: " << twenty.priority() << ":" << twenty.value() << endl;
+    cout << h1.str();
+
+    cout << "Sacando todo de h1 => ";
+    while (!h1.empty()) {
+        cout << h1.top().first << ":" << h1.top().second << " ";
+        h1.pop();
+    }
+    cout << endl;
+
+    cout << endl << "Lo mismo con rank_pairing_heap (entre corchetes, el rango de cada nodo):" << endl;
+    rank_pairing_heap<int, string> r1;
+    vector<rank_pairing_heap<int, string>::handle> r1_handles;
+    for (const auto & x : { 5, 3, 7, 1, 4, 2, 6, 0, 8 }) {
+        r1_handles.push_back(r1.push(x, "[" + to_string(x) + "]"));
+    }
+    cout << "Sacando el tope de r1 => " << r1.pop_top() << endl;
+    cout << "r1 después de enlazar las raíces del mismo rango:" << endl << r1.str();
+    r1.decrease_key(r1_handles[6], -1);
+    cout << "Después de bajar el 6 a -1:" << endl << r1.str();
+    cout << "Sacando todo de r1 => ";
+    while (!r1.empty()) {
+        cout << r1.top().first << ":" << r1.top().second << " ";
+        r1.pop();
+    }
+    cout << endl;
+
+    const int operations = 2000000;
+    cout << endl << ":: " << operations << " operaciones al azar sobre 64 colas (60% push, 40% pop y juntando dos colas):" << endl;
+    for (int meld_per_mille : { 0, 1, 5 }) {
+        long long c1 = 0;
+        long long c2 = 0;
+        double binary_time = measure([&] { c1 = mixed_workload<priority_queue<int, int>>(64, operations, meld_per_mille); });
+        double pairing_time = measure([&] { c2 = mixed_workload<pairing_heap<int, int>>(64, operations, meld_per_mille); });
+        long long c3 = 0;
+        double rank_time = measure([&] { c3 = mixed_workload<rank_pairing_heap<int, int>>(64, operations, meld_per_mille); });
+        cout << "  meld cada " << meld_per_mille << " en 1000: priority_queue " << binary_time
+             << " s, pairing_heap " << pairing_time << " s, rank_pairing_heap " << rank_time
+             << " s - ¿mismos resultados? " << boolalpha << (c1 == c2 && c2 == c3) << endl;
+    }
+
+    const int n = 1000000;
+    cout << endl << ":: " << n << " elementos, bajando prioridades al azar antes de cada pop:" << endl;
+    for (int decreases : { 1, 4 }) {
+        long long c1 = 0;
+        long long c2 = 0;
+        double pairing_time = measure([&] { c1 = decrease_workload<pairing_heap<int, int>>(n, decreases); });
+        double rank_time = measure([&] { c2 = decrease_workload<rank_pairing_heap<int, int>>(n, decreases); });
+        cout << "  " << decreases << " decrease_key por pop: pairing_heap " << pairing_time
+             << " s, rank_pairing_heap " << rank_time << " s - ¿mismos resultados? " << (c1 == c2) << endl;
+    }
+}
@@ -0,0 +1,147 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>      // Para std::size_t
+#include <new>          // Para operator new y operator delete
+#include <type_traits>  // Para std::aligned_storage
+#include <utility>      // Para std::swap y std::forward
+
+/************************************************************************************/
+/********************* Reserva de nodos en bloques contiguos ************************/
+/************************************************************************************/
+
+// Los nodos se sacan de bloques cada vez más grandes (64, 128, ... hasta
+// 65536 nodos) en lugar de pedirlos uno por uno con new, y los que se
+// liberan quedan en una lista para volver a usarlos. Dos reservas pueden
+// juntarse en O(1) (splice): los nodos de una pasan a ser de la otra sin
+// moverse de lugar, que es lo que necesita meld.
+template <typename Node>
+class node_pool {
+public:
+    node_pool() {
+        m_blocks = m_last_block = nullptr;
+        m_free = m_last_free = nullptr;
+        m_next_block_size = 64;
+    }
+
+    node_pool(const node_pool &) = delete;
+    node_pool & operator=(const node_pool &) = delete;
+
+    ~node_pool() {
+        // Los nodos ya tienen que haber sido destruidos con destroy
+        while (m_blocks != nullptr) {
+            block * next = m_blocks->next;
+            ::operator delete(m_blocks);
+            m_blocks = next;
+        }
+    }
+
+    friend
+    void swap(node_pool & x, node_pool & y) {
+        using std::swap;
+        swap(x.m_blocks, y.m_blocks);
+        swap(x.m_last_block, y.m_last_block);
+        swap(x.m_free, y.m_free);
+        swap(x.m_last_free, y.m_last_free);
+        swap(x.m_next_block_size, y.m_next_block_size);
+    }
+
+    template <typename... Args>
+    Node * create(Args &&... args) {
+        void * memory;
+        if (m_free != nullptr) {
+            memory = m_free;
+            m_free = m_free->next;
+            if (m_free == nullptr) {
+                m_last_free = nullptr;
+            }
+        } else {
+            if (m_blocks == nullptr || m_blocks->used == m_blocks->size) {
+                add_block();
+            }
+            memory = m_blocks->slots() + m_blocks->used++;
+        }
+        return new (memory) Node(std::forward<Args>(args)...);
+    }
+
+    void destroy(Node * n) {
+        n->~Node();
+        free_slot * slot = new (n) free_slot { m_free };
+        if (m_free == nullptr) {
+            m_last_free = slot;
+        }
+        m_free = slot;
+    }
+
+    // Se queda con los bloques y los nodos libres de x, que queda vacía. Lo
+    // que quedaba sin usar del bloque actual de x no se vuelve a usar
+    // hasta que se libere toda la reserva.
+    void splice(node_pool & x) {
+        if (x.m_blocks != nullptr) {
+            if (m_blocks == nullptr) {
+                m_blocks = x.m_blocks;
+            } else {
+                m_last_block->next = x.m_blocks;
+            }
+            m_last_block = x.m_last_block;
+        }
+        if (x.m_free != nullptr) {
+            if (m_free == nullptr) {
+                m_free = x.m_free;
+            } else {
+                m_last_free->next = x.m_free;
+            }
+            m_last_free = x.m_last_free;
+        }
+        x.m_blocks = x.m_last_block = nullptr;
+        x.m_free = x.m_last_free = nullptr;
+    }
+
+private:
+    struct free_slot {
+        free_slot * next;
+    };
+
+    using storage = typename std::aligned_storage<(sizeof(Node) > sizeof(free_slot) ? sizeof(Node) : sizeof(free_slot)),
+                                                  (alignof(Node) > alignof(free_slot) ? alignof(Node) : alignof(free_slot))>::type;
+
+    // Cada bloque se pide de una sola vez: la cabecera y a continuación
+    // los nodos
+    struct block {
+        block * next;
+        std::size_t size;
+        std::size_t used;
+
+        static const std::size_t header_size = (sizeof(block *) + 2 * sizeof(std::size_t) + alignof(storage) - 1)
+                                               / alignof(storage) * alignof(storage);
+
+        storage * slots() {
+            return reinterpret_cast<storage *>(reinterpret_cast<char *>(this) + header_size);
+        }
+    };
+
+    void add_block() {
+        std::size_t size = m_next_block_size;
+        void * memory = ::operator new(block::header_size + size * sizeof(storage));
+        block * b = new (memory) block;
+        b->size = size;
+        b->used = 0;
+        // El bloque nuevo va adelante, porque es de donde se sacan los nodos
+        b->next = m_blocks;
+        if (m_blocks == nullptr) {
+            m_last_block = b;
+        }
+        m_blocks = b;
+        if (m_next_block_size < 65536) {
+            m_next_block_size *= 2;
+        }
+    }
+
+    block * m_blocks;
+    block * m_last_block;
+    free_slot * m_free;
+    free_slot * m_last_free;
+    std::size_t m_next_block_size;
+};
+
+#endif // NODE_POOL_H
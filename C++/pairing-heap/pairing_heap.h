@@ -0,0 +1,338 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include "node_pool.h"
+
+#include <cstddef>      // Para std::size_t
+#include <functional>   // Para std::less
+#include <utility>      // Para std::pair, std::swap, std::forward y std::move
+#include <vector>       // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar la cola ****/
+/************************************************************************************/
+
+#include <sstream>
+#include <string>
+
+/************************************************************************************/
+/**************************** Montículo de emparejamiento ***************************/
+/************************************************************************************/
+
+// Un montículo de emparejamiento (pairing heap) es un árbol en el que cada
+// nodo va antes que sus hijos, sin ninguna otra restricción de forma. Juntar
+// dos montículos (link) es O(1): la raíz que va después pasa a ser el primer
+// hijo de la otra. Con eso:
+//
+// - push es juntar el montículo con un nodo nuevo: O(1).
+// - meld es juntar las dos raíces: O(1), sin mover ningún elemento (a
+//   diferencia de priority_queue, que tendría que volver a meter todos los
+//   elementos de una cola en la otra).
+// - pop saca la raíz y junta a sus hijos de a pares de izquierda a derecha y
+//   después los pares de derecha a izquierda: O(log n) amortizado.
+// - decrease_key corta el subárbol del nodo y lo junta con la raíz: O(1),
+//   más un costo amortizado que pagan los pop siguientes (se sabe que es
+//   o(log n) y en la práctica se comporta como O(1)). rank_pairing_heap
+//   garantiza O(1) amortizado.
+//
+// Los hijos de cada nodo forman una lista doblemente enlazada: prev apunta al
+// hermano anterior o, en el primer hijo, al padre.
+//
+// push devuelve un handle del elemento, que sirve para cambiar su prioridad
+// mientras esté en la cola (también después de un meld).
+
+template <typename P, typename T, typename Comparator = std::less<P>>
+class pairing_heap {
+public:
+    using value_type = T;
+    using priority_type = P;
+
+private:
+    struct node {
+        priority_type priority;
+        value_type value;
+        node * child;
+        node * sibling;
+        node * prev;
+
+        template <typename Q, typename... Args>
+        node(Q && priority, Args &&... args)
+            : priority(std::forward<Q>(priority)), value(std::forward<Args>(args)...),
+              child(nullptr), sibling(nullptr), prev(nullptr) {
+        }
+    };
+
+    node * m_root;
+    std::size_t m_size;
+    node_pool<node> m_pool;
+    Comparator m_cmp;
+
+public:
+    class handle {
+    public:
+        handle() : m_node(nullptr) {
+        }
+
+        const priority_type & priority() const {
+            return m_node->priority;
+        }
+
+        value_type & value() const {
+            return m_node->value;
+        }
+
+    private:
+        explicit handle(node * n) : m_node(n) {
+        }
+
+        node * m_node;
+
+        friend class pairing_heap;
+    };
+
+    pairing_heap(Comparator cmp = Comparator()) : m_cmp(cmp) {
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    // La copia tiene los mismos elementos pero no la misma forma: es una
+    // raíz con todos los demás como hijos, que el primer pop reacomoda
+    pairing_heap(const pairing_heap & x) : m_cmp(x.m_cmp) {
+        m_root = nullptr;
+        m_size = 0;
+        x.each_node([this](const node * n) { push(n->priority, n->value); });
+    }
+
+    pairing_heap(pairing_heap && x) : pairing_heap(x.m_cmp) {
+        swap(*this, x);
+    }
+
+    ~pairing_heap() {
+        clear();
+    }
+
+    pairing_heap & operator=(pairing_heap x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(pairing_heap & x, pairing_heap & y) {
+        using std::swap;
+        swap(x.m_root, y.m_root);
+        swap(x.m_size, y.m_size);
+        swap(x.m_pool, y.m_pool);
+        swap(x.m_cmp, y.m_cmp);
+    }
+
+    handle push(const priority_type & priority, const value_type & value) {
+        return insert(m_pool.create(priority, value));
+    }
+
+    handle push(priority_type && priority, value_type && value) {
+        return insert(m_pool.create(std::move(priority), std::move(value)));
+    }
+
+    // Construye el valor con args directamente en el nodo
+    template <typename... Args>
+    handle emplace(const priority_type & priority, Args &&... args) {
+        return insert(m_pool.create(priority, std::forward<Args>(args)...));
+    }
+
+    std::pair<const priority_type &, value_type &> top() {
+        // Precondición: !empty()
+        return { m_root->priority, m_root->value };
+    }
+
+    void pop() {
+        // Precondición: !empty()
+        node * old_root = m_root;
+        m_root = combine(m_root->child);
+        m_pool.destroy(old_root);
+        --m_size;
+    }
+
+    // Saca el valor del tope moviéndolo, sin copiarlo
+    value_type pop_top() {
+        // Precondición: !empty()
+        value_type value = std::move(m_root->value);
+        pop();
+        return value;
+    }
+
+    // Le da al elemento de h una prioridad que va antes (o igual) que la que
+    // tenía
+    void decrease_key(handle h, const priority_type & priority) {
+        // Precondición: h es de un elemento que está en la cola y
+        //               !cmp(h.priority(), priority)
+        node * n = h.m_node;
+        n->priority = priority;
+        if (n != m_root) {
+            cut(n);
+            m_root = link(m_root, n);
+        }
+    }
+
+    // Pasa todos los elementos de x a esta cola en O(1); x queda vacía. Los
+    // handles de los elementos de x siguen valiendo, ahora para esta cola.
+    void meld(pairing_heap & x) {
+        if (this == &x || x.m_root == nullptr) {
+            return;
+        }
+        m_root = m_root == nullptr ? x.m_root : link(m_root, x.m_root);
+        m_size += x.m_size;
+        m_pool.splice(x.m_pool);
+        x.m_root = nullptr;
+        x.m_size = 0;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    void clear() {
+        each_node([this](node * n) { m_pool.destroy(n); });
+        m_root = nullptr;
+        m_size = 0;
+    }
+
+    // Recorre los elementos en un orden cualquiera (el de la forma del árbol)
+    template <typename F>
+    void each(F func) {
+        each_node([&func](node * n) { func(static_cast<const priority_type &>(n->priority), n->value); });
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    handle insert(node * n) {
+        m_root = m_root == nullptr ? n : link(m_root, n);
+        ++m_size;
+        return handle(n);
+    }
+
+    // Junta dos raíces (sin hermanos) y devuelve la nueva raíz
+    node * link(node * x, node * y) {
+        if (m_cmp(y->priority, x->priority)) {
+            std::swap(x, y);
+        }
+        y->sibling = x->child;
+        if (x->child != nullptr) {
+            x->child->prev = y;
+        }
+        y->prev = x;
+        x->child = y;
+        return x;
+    }
+
+    // Desengancha el subárbol de n (que no es la raíz) de su padre y sus
+    // hermanos
+    void cut(node * n) {
+        if (n->prev->child == n) {
+            n->prev->child = n->sibling;
+        } else {
+            n->prev->sibling = n->sibling;
+        }
+        if (n->sibling != nullptr) {
+            n->sibling->prev = n->prev;
+        }
+        n->sibling = n->prev = nullptr;
+    }
+
+    // Junta una lista de hermanos en una sola raíz, en dos pasadas: primero
+    // de a pares de izquierda a derecha, dejando los pares en una lista al
+    // revés, y después recorriendo esa lista (es decir, de derecha a
+    // izquierda) juntando cada par con el resultado acumulado
+    node * combine(node * first) {
+        if (first == nullptr) {
+            return nullptr;
+        }
+        node * pairs = nullptr;
+        while (first != nullptr) {
+            node * x = first;
+            node * y = x->sibling;
+            if (y == nullptr) {
+                x->prev = nullptr;
+                x->sibling = pairs;
+                pairs = x;
+                break;
+            }
+            first = y->sibling;
+            x->sibling = y->sibling = nullptr;
+            x->prev = y->prev = nullptr;
+            node * linked = link(x, y);
+            linked->sibling = pairs;
+            pairs = linked;
+        }
+        node * result = pairs;
+        pairs = pairs->sibling;
+        result->sibling = nullptr;
+        while (pairs != nullptr) {
+            node * next = pairs->sibling;
+            pairs->sibling = nullptr;
+            result = link(pairs, result);
+            pairs = next;
+        }
+        result->prev = nullptr;
+        return result;
+    }
+
+    // Aplica func a todos los nodos con una pila explícita (el árbol puede
+    // ser muy profundo); func puede destruir el nodo que recibe
+    template <typename F>
+    void each_node(F func) const {
+        if (m_root == nullptr) {
+            return;
+        }
+        std::vector<node *> pending { m_root };
+        while (!pending.empty()) {
+            node * n = pending.back();
+            pending.pop_back();
+            if (n->sibling != nullptr) {
+                pending.push_back(n->sibling);
+            }
+            if (n->child != nullptr) {
+                pending.push_back(n->child);
+            }
+            func(n);
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+public:
+
+    // Éste método muestra el árbol con un renglón por nodo, con sus hijos
+    // debajo y con más sangría
+    std::string str() const {
+        std::ostringstream s;
+        std::vector<std::pair<const node *, int>> pending;
+        if (m_root != nullptr) {
+            pending.push_back({ m_root, 0 });
+        }
+        while (!pending.empty()) {
+            const node * n = pending.back().first;
+            int depth = pending.back().second;
+            pending.pop_back();
+            s << std::string(2 * depth, ' ') << n->priority << ":" << n->value << '\n';
+            if (n->sibling != nullptr) {
+                pending.push_back({ n->sibling, depth });
+            }
+            if (n->child != nullptr) {
+                pending.push_back({ n->child, depth + 1 });
+            }
+        }
+        return s.str();
+    }
+};
+
+#endif // PAIRING_HEAP_H
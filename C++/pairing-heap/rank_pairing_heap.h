@@ -0,0 +1,441 @@
+#ifndef RANK_PAIRING_HEAP_H
+#define RANK_PAIRING_HEAP_H
+
+#include "node_pool.h"
+
+#include <cstddef>      // Para std::size_t
+#include <functional>   // Para std::less
+#include <utility>      // Para std::pair, std::swap, std::forward y std::move
+#include <vector>       // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar la cola ****/
+/************************************************************************************/
+
+#include <sstream>
+#include <string>
+
+/************************************************************************************/
+/*********************** Montículo de emparejamiento por rango **********************/
+/************************************************************************************/
+
+// El montículo de emparejamiento por rango (rank-pairing heap, de Haeupler,
+// Sen y Tarjan; acá el de tipo 1) tiene la misma interfaz que pairing_heap,
+// pero decrease_key cuesta O(1) amortizado, no sólo en la práctica.
+//
+// Es una lista circular de medio-árboles: árboles binarios en los que cada
+// nodo va antes que todos los de su subárbol izquierdo (el derecho no tiene
+// nada que ver con él) y cuya raíz no tiene hijo derecho. En las raíces, el
+// enlace right se usa para la lista, que se recorre a partir del mínimo.
+// Cada nodo tiene un rango (el de un hijo que falta es -1): el de una raíz
+// es uno más que el de su hijo izquierdo, y en los demás nodos los rangos de
+// los hijos son ambos uno menos que el del nodo, o uno igual y el otro menor.
+//
+// - push agrega una raíz de rango 0 a la lista: O(1).
+// - meld junta las dos listas circulares: O(1).
+// - pop saca el mínimo, convierte en raíces a los nodos del borde derecho de
+//   su hijo izquierdo y hace una sola pasada de enlaces, juntando raíces del
+//   mismo rango (la que va después pasa a ser el hijo izquierdo de la otra):
+//   O(log n) amortizado.
+// - decrease_key corta al nodo junto con su subárbol izquierdo, pone a su
+//   hijo derecho en su lugar y lo agrega a la lista. Después baja los rangos
+//   de los ancestros mientras haga falta: O(1) amortizado.
+//
+// Como en pairing_heap, push devuelve un handle del elemento, que sirve para
+// cambiar su prioridad mientras esté en la cola (también después de un meld).
+
+template <typename P, typename T, typename Comparator = std::less<P>>
+class rank_pairing_heap {
+public:
+    using value_type = T;
+    using priority_type = P;
+
+private:
+    struct node {
+        priority_type priority;
+        value_type value;
+        node * left;
+        node * right;
+        node * parent;   // nullptr en las raíces
+        int rank;
+
+        template <typename Q, typename... Args>
+        node(Q && priority, Args &&... args)
+            : priority(std::forward<Q>(priority)), value(std::forward<Args>(args)...),
+              left(nullptr), right(nullptr), parent(nullptr), rank(0) {
+        }
+    };
+
+    node * m_min;
+    std::size_t m_size;
+    node_pool<node> m_pool;
+    std::vector<node *> m_buckets;  // Una raíz por rango durante pop; se reusa
+    Comparator m_cmp;
+
+public:
+    class handle {
+    public:
+        handle() : m_node(nullptr) {
+        }
+
+        const priority_type & priority() const {
+            return m_node->priority;
+        }
+
+        value_type & value() const {
+            return m_node->value;
+        }
+
+    private:
+        explicit handle(node * n) : m_node(n) {
+        }
+
+        node * m_node;
+
+        friend class rank_pairing_heap;
+    };
+
+    rank_pairing_heap(Comparator cmp = Comparator()) : m_cmp(cmp) {
+        m_min = nullptr;
+        m_size = 0;
+    }
+
+    // La copia tiene los mismos elementos pero todos como raíces de rango 0,
+    // que el primer pop va enlazando
+    rank_pairing_heap(const rank_pairing_heap & x) : m_cmp(x.m_cmp) {
+        m_min = nullptr;
+        m_size = 0;
+        x.each_node([this](const node * n) { push(n->priority, n->value); });
+    }
+
+    rank_pairing_heap(rank_pairing_heap && x) : rank_pairing_heap(x.m_cmp) {
+        swap(*this, x);
+    }
+
+    ~rank_pairing_heap() {
+        clear();
+    }
+
+    rank_pairing_heap & operator=(rank_pairing_heap x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(rank_pairing_heap & x, rank_pairing_heap & y) {
+        using std::swap;
+        swap(x.m_min, y.m_min);
+        swap(x.m_size, y.m_size);
+        swap(x.m_pool, y.m_pool);
+        swap(x.m_buckets, y.m_buckets);
+        swap(x.m_cmp, y.m_cmp);
+    }
+
+    handle push(const priority_type & priority, const value_type & value) {
+        return insert(m_pool.create(priority, value));
+    }
+
+    handle push(priority_type && priority, value_type && value) {
+        return insert(m_pool.create(std::move(priority), std::move(value)));
+    }
+
+    // Construye el valor con args directamente en el nodo
+    template <typename... Args>
+    handle emplace(const priority_type & priority, Args &&... args) {
+        return insert(m_pool.create(priority, std::forward<Args>(args)...));
+    }
+
+    std::pair<const priority_type &, value_type &> top() {
+        // Precondición: !empty()
+        return { m_min->priority, m_min->value };
+    }
+
+    void pop() {
+        // Precondición: !empty()
+        node * old_min = m_min;
+        node * first = nullptr;
+        // Las otras raíces, sacando al mínimo de la lista
+        if (old_min->right != old_min) {
+            first = old_min->right;
+            node * last = first;
+            while (last->right != old_min) {
+                last = last->right;
+            }
+            last->right = nullptr;
+        }
+        // El borde derecho del hijo izquierdo pasa a ser una lista de raíces
+        // que se agrega adelante
+        if (old_min->left != nullptr) {
+            node * spine = old_min->left;
+            while (spine != nullptr) {
+                node * next = spine->right;
+                spine->parent = nullptr;
+                spine->rank = rank_of(spine->left) + 1;
+                spine->right = first;
+                first = spine;
+                spine = next;
+            }
+        }
+        m_pool.destroy(old_min);
+        --m_size;
+        m_min = link_by_rank(first);
+    }
+
+    // Saca el valor del tope moviéndolo, sin copiarlo
+    value_type pop_top() {
+        // Precondición: !empty()
+        value_type value = std::move(m_min->value);
+        pop();
+        return value;
+    }
+
+    // Le da al elemento de h una prioridad que va antes (o igual) que la que
+    // tenía
+    void decrease_key(handle h, const priority_type & priority) {
+        // Precondición: h es de un elemento que está en la cola y
+        //               !cmp(h.priority(), priority)
+        node * n = h.m_node;
+        n->priority = priority;
+        if (n->parent == nullptr) {
+            if (m_cmp(n->priority, m_min->priority)) {
+                m_min = n;
+            }
+            return;
+        }
+        node * parent = n->parent;
+        node * child = n->right;
+        if (parent->left == n) {
+            parent->left = child;
+        } else {
+            parent->right = child;
+        }
+        if (child != nullptr) {
+            child->parent = parent;
+        }
+        n->parent = nullptr;
+        n->rank = rank_of(n->left) + 1;
+        add_root(n);
+        reduce_ranks(parent);
+    }
+
+    // Pasa todos los elementos de x a esta cola en O(1); x queda vacía. Los
+    // handles de los elementos de x siguen valiendo, ahora para esta cola.
+    void meld(rank_pairing_heap & x) {
+        if (this == &x || x.m_min == nullptr) {
+            return;
+        }
+        if (m_min == nullptr) {
+            m_min = x.m_min;
+        } else {
+            std::swap(m_min->right, x.m_min->right);
+            if (m_cmp(x.m_min->priority, m_min->priority)) {
+                m_min = x.m_min;
+            }
+        }
+        m_size += x.m_size;
+        m_pool.splice(x.m_pool);
+        x.m_min = nullptr;
+        x.m_size = 0;
+    }
+
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    void clear() {
+        each_node([this](node * n) { m_pool.destroy(n); });
+        m_min = nullptr;
+        m_size = 0;
+    }
+
+    // Recorre los elementos en un orden cualquiera (el de la forma del árbol)
+    template <typename F>
+    void each(F func) {
+        each_node([&func](node * n) { func(static_cast<const priority_type &>(n->priority), n->value); });
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    static int rank_of(const node * n) {
+        return n == nullptr ? -1 : n->rank;
+    }
+
+    handle insert(node * n) {
+        add_root(n);
+        ++m_size;
+        return handle(n);
+    }
+
+    // Agrega una raíz a la lista circular, a continuación del mínimo
+    void add_root(node * n) {
+        if (m_min == nullptr) {
+            n->right = n;
+            m_min = n;
+        } else {
+            n->right = m_min->right;
+            m_min->right = n;
+            if (m_cmp(n->priority, m_min->priority)) {
+                m_min = n;
+            }
+        }
+    }
+
+    // Junta dos raíces del mismo rango: la que va después pasa a ser el hijo
+    // izquierdo de la otra, y su hijo izquierdo anterior queda como hijo
+    // derecho de la perdedora
+    node * link(node * x, node * y) {
+        if (m_cmp(y->priority, x->priority)) {
+            std::swap(x, y);
+        }
+        y->right = x->left;
+        if (x->left != nullptr) {
+            x->left->parent = y;
+        }
+        y->parent = x;
+        x->left = y;
+        ++x->rank;
+        return x;
+    }
+
+    // Una sola pasada sobre la lista (terminada en nullptr) de raíces: cada
+    // una se junta con la que esté esperando en su rango, si hay; si no,
+    // espera ella. Los árboles enlazados no vuelven a enlazarse en esta
+    // pasada. Devuelve el mínimo de la nueva lista circular.
+    node * link_by_rank(node * first) {
+        node * result = nullptr;
+        node * last = nullptr;
+        auto append = [&](node * n) {
+            if (result == nullptr || m_cmp(n->priority, result->priority)) {
+                // El mínimo queda adelante para devolverlo como tal
+                if (result == nullptr) {
+                    last = n;
+                }
+                n->right = result;
+                result = n;
+            } else {
+                n->right = nullptr;
+                last->right = n;
+                last = n;
+            }
+        };
+        while (first != nullptr) {
+            node * n = first;
+            first = first->right;
+            std::size_t rank = std::size_t(n->rank);
+            if (rank >= m_buckets.size()) {
+                m_buckets.resize(rank + 1, nullptr);
+            }
+            if (m_buckets[rank] == nullptr) {
+                m_buckets[rank] = n;
+            } else {
+                node * other = m_buckets[rank];
+                m_buckets[rank] = nullptr;
+                append(link(other, n));
+            }
+        }
+        for (auto & waiting : m_buckets) {
+            if (waiting != nullptr) {
+                append(waiting);
+                waiting = nullptr;
+            }
+        }
+        if (last != nullptr) {
+            last->right = result;
+        }
+        return result;
+    }
+
+    // Recalcula los rangos desde n hacia arriba hasta que alguno no baje. Si
+    // los hijos tienen el mismo rango, el del nodo es uno más; si no, es el
+    // mayor de los dos.
+    void reduce_ranks(node * n) {
+        while (n != nullptr) {
+            if (n->parent == nullptr) {
+                n->rank = rank_of(n->left) + 1;
+                return;
+            }
+            int left = rank_of(n->left);
+            int right = rank_of(n->right);
+            int rank = left == right ? left + 1 : (left > right ? left : right);
+            if (rank >= n->rank) {
+                return;
+            }
+            n->rank = rank;
+            n = n->parent;
+        }
+    }
+
+    // Aplica func a todos los nodos con una pila explícita; func puede
+    // destruir el nodo que recibe
+    template <typename F>
+    void each_node(F func) const {
+        if (m_min == nullptr) {
+            return;
+        }
+        std::vector<node *> pending;
+        node * root = m_min;
+        do {
+            pending.push_back(root);
+            root = root->right;
+        } while (root != m_min);
+        while (!pending.empty()) {
+            node * n = pending.back();
+            pending.pop_back();
+            if (n->parent != nullptr && n->right != nullptr) {
+                pending.push_back(n->right);
+            }
+            if (n->left != nullptr) {
+                pending.push_back(n->left);
+            }
+            func(n);
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+public:
+
+    // Éste método muestra cada medio-árbol con un renglón por nodo y su rango
+    // entre corchetes; los hijos van debajo y con más sangría, primero el
+    // izquierdo y después el derecho
+    std::string str() const {
+        std::ostringstream s;
+        if (m_min == nullptr) {
+            return s.str();
+        }
+        std::vector<std::pair<const node *, int>> pending;
+        const node * root = m_min;
+        do {
+            pending.push_back({ root, 0 });
+            root = root->right;
+        } while (root != m_min);
+        // Se apilaron al revés: se invierten para mostrar la lista en orden
+        std::vector<std::pair<const node *, int>> reversed(pending.rbegin(), pending.rend());
+        pending.swap(reversed);
+        while (!pending.empty()) {
+            const node * n = pending.back().first;
+            int depth = pending.back().second;
+            pending.pop_back();
+            s << std::string(2 * depth, ' ') << n->priority << ":" << n->value << " [" << n->rank << "]\n";
+            if (n->parent != nullptr && n->right != nullptr) {
+                pending.push_back({ n->right, depth + 1 });
+            }
+            if (n->left != nullptr) {
+                pending.push_back({ n->left, depth + 1 });
+            }
+        }
+        return s.str();
+    }
+};
+
+#endif // RANK_PAIRING_HEAP_H
@@ -0,0 +1,99 @@
+#include "persistent_map.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+template <typename K, typename V>
+ostream & operator<<(ostream & out, const persistent_map<K, V> & t) {
+    out << "persistent_map { ";
+    for (const auto & x : t) {
+        out << x.first << ":" << x.second << " ";
+    }
+    out << "}";
+    return out;
+}
+
+void show_key_value(const int & k, const string & v) {
+    cout << k << ":" << v << ' ';
+}
+
+int main() {
+    persistent_map<int, string> t1;
+
+    for (const auto & x: { 5, 3, 7, 1, 4, 2, 6, 0, 8 })
+        t1.insert(x, "[" + to_string(x) + "]");
+
+    cout << "t1 = " << t1 << endl;
+    cout << "Graficando t1:" << endl;
+    cout << t1.str();
+
+    cout << endl << "Tomando una instantánea s1 de t1:" << endl;
+    auto s1 = t1.snapshot();
+    cout << "s1 = " << s1 << endl;
+
+    cout << endl << "Haciendo más inserciones y borrados en t1:" << endl;
+    t1.insert(5, "a");
+    t1.insert(9, "b");
+    t1.insert(5, "c");
+    cout << "Borrando un 3 => " << t1.erase(3).first << endl;
+    cout << "Borrando un 42 => " << t1.erase(42).first << endl;
+
+    cout << "t1 = " << t1 << endl << t1.str() << endl;
+    cout << "s1 = " << s1 << endl << s1.str() << endl;
+    cout << "¿t1 == s1? " << boolalpha << (t1 == s1) << endl;
+
+    cout << "¿t1 contiene a 3? " << boolalpha << t1.contains(3) << endl;
+    cout << "¿s1 contiene a 3? " << boolalpha << s1.contains(3) << endl;
+
+    auto p = t1.find(7);
+    if (p != t1.end()) {
+        cout << "El valor asociado a " << p->first << " es: " << p->second;
+        ++p;
+        cout << " y el siguiente es " << p->first << ":" << p->second << endl;
+    }
+
+    cout << "Mínimo de t1 => " << t1.minimum()->first << endl;
+    cout << "Máximo de t1 => " << t1.maximum()->first << endl;
+    cout << "Claves de t1 al revés =>";
+    for (auto q = t1.rbegin(); q != t1.rend(); ++q)
+        cout << ' ' << q->first;
+    cout << endl << endl;
+
+    cout << "Recorriendo s1 con each():" << endl;
+    cout << "s1 = persistent_map { ";
+    s1.each(show_key_value);
+    cout << "}" << endl << endl;
+
+    cout << "Borrando todo t1 de a un elemento a la vez:" << endl;
+    for (auto q = t1.begin(); q != t1.end(); ) {
+        cout << "Borrando un " << q->first << " => ";
+        auto result = t1.erase(q->first);
+        cout << result.first << endl;
+        q = result.second;
+    }
+    cout << "t1 = " << t1 << " - ¿t1 está vacio? " << t1.empty() << endl;
+    cout << "s1 = " << s1 << " - ¿s1 está vacio? " << s1.empty() << endl << endl;
+
+    cout << "Leyendo una instantánea desde otro hilo mientras se modifica el original:" << endl;
+    persistent_map<int, int> t2;
+    for (int x = 0; x < 1000; ++x)
+        t2.insert(x, x);
+
+    auto s2 = t2.snapshot();
+    long long suma = 0;
+    thread lector([&] {
+        for (int i = 0; i < 100; ++i)
+            s2.each([&](const int &, const int & v) { suma += v; });
+    });
+    for (int x = 0; x < 1000; ++x) {
+        t2.erase(x);
+        t2.insert(x + 1000, x);
+    }
+    lector.join();
+
+    cout << "Suma leída por el hilo (100 veces 0 + ... + 999) = " << suma << endl;
+    cout << "Mínimo de t2 => " << t2.minimum()->first << " - Mínimo de s2 => " << s2.minimum()->first << endl;
+}
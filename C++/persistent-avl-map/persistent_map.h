@@ -0,0 +1,597 @@
+#ifndef PERSISTENT_MAP_H
+#define PERSISTENT_MAP_H
+
+#include <algorithm>  // Para std::max
+#include <cstddef>    // Para std::size_t
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <memory>     // Para std::shared_ptr y std::make_shared
+#include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/********* Mapa asociativo persistente implementado con un árbol AVL que ************/
+/********* copia el camino modificado en lugar de modificar los nodos    ************/
+/************************************************************************************/
+
+// Los nodos nunca se modifican una vez creados: insert y erase crean copias
+// de los O(log n) nodos del camino desde la raíz hasta el lugar modificado y
+// comparten (contando referencias) todos los demás con la versión anterior.
+// Gracias a eso, snapshot() (y la copia) son O(1) y una instantánea puede ser
+// leída desde otro hilo mientras el original se sigue modificando.
+//
+// Como los nodos se comparten, no tienen enlace al padre: el iterador guarda
+// en una pila el camino desde la raíz hasta el nodo actual.
+
+template <typename K, typename V>
+class persistent_map {
+public:
+    using value_type = std::pair<const K, V>;
+
+private:
+    struct node;
+    using node_ptr = std::shared_ptr<const node>;
+
+    struct node {
+        value_type data;
+        node_ptr left;
+        node_ptr right;
+        int height;
+
+        const node * find_minimum() const {
+            const node * minimum = this;
+            while (minimum->left != nullptr) {
+                minimum = minimum->left.get();
+            }
+            return minimum;
+        }
+
+        const node * find_maximum() const {
+            const node * maximum = this;
+            while (maximum->right != nullptr) {
+                maximum = maximum->right.get();
+            }
+            return maximum;
+        }
+    };
+
+    node_ptr m_root;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    persistent_map() {
+    }
+
+    // Copiar comparte todos los nodos, así que es O(1).
+    persistent_map(const persistent_map & x) {
+        m_root = x.m_root;
+    }
+
+    persistent_map & operator=(persistent_map x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(persistent_map & x, persistent_map & y) {
+        using namespace std;
+        swap(x.m_root, y.m_root);
+    }
+
+    // Devuelve una vista inmutable del estado actual del mapa en O(1). Las
+    // modificaciones posteriores de este mapa no afectan a la instantánea.
+    persistent_map snapshot() const {
+        return *this;
+    }
+
+    /************************************************************************/
+    /********** ITERADOR CON PILA QUE RECORRE AL ÁRBOL EN ORDEN *************/
+    /************************************************************************/
+
+    // Los valores no pueden modificarse a través del iterador porque los
+    // nodos pueden estar compartidos con otras instantáneas. El iterador se
+    // invalida si se modifica el mapa sobre el que se obtuvo.
+    class iterator {
+    private:
+        // La raíz hace falta para retroceder desde end(), que tiene la pila
+        // vacía
+        const node * m_root;
+        std::vector<const node *> m_path;
+
+        friend class persistent_map;
+
+    public:
+        using value_type = persistent_map::value_type;
+        using pointer = const value_type *;
+        using reference = const value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(const node * root = nullptr) : m_root(root) {
+        }
+
+        reference operator*() {
+            // Precondición: !m_path.empty()
+            return m_path.back()->data;
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            if (x.m_path.empty() || y.m_path.empty()) {
+                return x.m_path.empty() && y.m_path.empty();
+            }
+            return x.m_path.back() == y.m_path.back();
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: !m_path.empty()
+            const node * current = m_path.back();
+            if (current->right != nullptr) {
+                push_minimum(current->right.get());
+            } else {
+                const node * prev;
+                do {
+                    prev = m_path.back();
+                    m_path.pop_back();
+                } while (!m_path.empty() && m_path.back()->right.get() == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        iterator & operator--() {
+            // Precondición: *this != begin()
+            if (m_path.empty()) {
+                push_maximum(m_root);
+                return *this;
+            }
+            const node * current = m_path.back();
+            if (current->left != nullptr) {
+                push_maximum(current->left.get());
+            } else {
+                const node * prev;
+                do {
+                    prev = m_path.back();
+                    m_path.pop_back();
+                } while (m_path.back()->left.get() == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+
+    private:
+        void push_minimum(const node * current) {
+            while (current != nullptr) {
+                m_path.push_back(current);
+                current = current->left.get();
+            }
+        }
+
+        void push_maximum(const node * current) {
+            while (current != nullptr) {
+                m_path.push_back(current);
+                current = current->right.get();
+            }
+        }
+    };
+
+    iterator begin() const {
+        iterator result(m_root.get());
+        result.push_minimum(m_root.get());
+        return result;
+    }
+
+    iterator end() const {
+        return iterator(m_root.get());
+    }
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() const {
+        return m_root == nullptr;
+    }
+
+    friend
+    bool operator==(const persistent_map & x, const persistent_map & y) {
+        if (x.m_root == y.m_root) {
+            return true;
+        }
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(const persistent_map & x, const persistent_map & y) {
+        return !(x == y);
+    }
+
+    iterator find(const K & key) const {
+        iterator result(m_root.get());
+        const node * current = m_root.get();
+        while (current != nullptr) {
+            result.m_path.push_back(current);
+            if (key < current->data.first) {
+                current = current->left.get();
+            } else if (key > current->data.first) {
+                current = current->right.get();
+            } else {
+                return result;
+            }
+        }
+        return end();
+    }
+
+    bool contains(const K & key) const {
+        const node * current = m_root.get();
+        while (current != nullptr) {
+            if (key < current->data.first) {
+                current = current->left.get();
+            } else if (key > current->data.first) {
+                current = current->right.get();
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    iterator minimum() const {
+        return begin();
+    }
+
+    iterator maximum() const {
+        iterator result(m_root.get());
+        result.push_maximum(m_root.get());
+        return result;
+    }
+
+    // Los recorridos sólo leen nodos, que una vez creados no cambian más,
+    // así que también pueden hacerse sobre una instantánea.
+
+    template <typename F>
+    void each(F func) const {
+        visit_in_order([&](const node * n) { func(n->data.first, n->data.second); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) const {
+        return visit_in_order([&](const node * n) { return bool(func(n->data.first, n->data.second)); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) const {
+        visit_preorder([&](const node * n) { func(n->data.first, n->data.second); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) const {
+        visit_postorder([&](const node * n) { func(n->data.first, n->data.second); return true; });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    // Tanto insert como erase crean O(log n) nodos nuevos y dejan intactos a
+    // los nodos de la versión anterior (que siguen vivos mientras alguna
+    // instantánea los use).
+
+    iterator insert(const K & key, const V & value) {
+        m_root = do_insert(m_root, key, value);
+        return find(key);
+    }
+
+    std::pair<bool, iterator> erase(const K & key) {
+        // Mantiene viva la versión anterior hasta terminar, por si key es una
+        // referencia a la clave de uno de los nodos que se van a liberar.
+        node_ptr previous = m_root;
+        bool erased = false;
+        m_root = do_erase(previous, key, erased);
+        if (!erased) {
+            return { false, end() };
+        }
+        return { true, upper_bound(key) };
+    }
+
+    void clear() {
+        m_root = nullptr;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Los recorridos usan una pila explícita en lugar de recursión (los nodos
+    // no tienen enlaces a sus padres).
+    // visit recibe cada nodo y devuelve false para interrumpir el recorrido.
+
+    template <typename F>
+    bool visit_in_order(F visit) const {
+        std::vector<const node *> pending;
+        const node * current = m_root.get();
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left.get();
+            }
+            current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right.get();
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) const {
+        std::vector<const node *> pending;
+        if (m_root.get() != nullptr) {
+            pending.push_back(m_root.get());
+        }
+        while (!pending.empty()) {
+            const node * current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending.push_back(current->right.get());
+            }
+            if (current->left != nullptr) {
+                pending.push_back(current->left.get());
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) const {
+        std::vector<const node *> pending;
+        const node * current = m_root.get();
+        const node * last = nullptr;
+        while (current != nullptr || !pending.empty()) {
+            if (current != nullptr) {
+                pending.push_back(current);
+                current = current->left.get();
+            } else {
+                const node * top = pending.back();
+                if (top->right != nullptr && top->right.get() != last) {
+                    current = top->right.get();
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    pending.pop_back();
+                }
+            }
+        }
+        return true;
+    }
+
+    static int height(const node_ptr & a_node) {
+        return a_node == nullptr ? 0 : a_node->height;
+    }
+
+    static node_ptr make_node(const value_type & data, const node_ptr & left, const node_ptr & right) {
+        int h = 1 + std::max(height(left), height(right));
+        return std::make_shared<const node>(node { data, left, right, h });
+    }
+
+    // Crea un nodo nuevo con data y los subárboles left y right, rotando si la
+    // diferencia de alturas entre ellos es de 2 (lo máximo que puede producir
+    // una única inserción o borrado). Las rotaciones también crean nodos
+    // nuevos en lugar de modificar los existentes.
+    static node_ptr balance_tree(const value_type & data, const node_ptr & left, const node_ptr & right) {
+        int left_height = height(left);
+        int right_height = height(right);
+        if (left_height > right_height + 1) {
+            if (height(left->left) >= height(left->right)) {
+                return make_node(left->data, left->left, make_node(data, left->right, right));
+            }
+            const node_ptr & pivot = left->right;
+            return make_node(pivot->data,
+                             make_node(left->data, left->left, pivot->left),
+                             make_node(data, pivot->right, right));
+        }
+        if (right_height > left_height + 1) {
+            if (height(right->right) >= height(right->left)) {
+                return make_node(right->data, make_node(data, left, right->left), right->right);
+            }
+            const node_ptr & pivot = right->left;
+            return make_node(pivot->data,
+                             make_node(data, left, pivot->left),
+                             make_node(right->data, pivot->right, right->right));
+        }
+        return make_node(data, left, right);
+    }
+
+    node_ptr do_insert(const node_ptr & current, const K & key, const V & value) {
+        if (current == nullptr) {
+            return make_node({ key, value }, nullptr, nullptr);
+        }
+
+        if (key < current->data.first) {
+            return balance_tree(current->data, do_insert(current->left, key, value), current->right);
+        } else if (key > current->data.first) {
+            return balance_tree(current->data, current->left, do_insert(current->right, key, value));
+        }
+        return make_node({ key, value }, current->left, current->right);
+    }
+
+    node_ptr do_erase(const node_ptr & current, const K & key, bool & erased) {
+        if (current == nullptr) {
+            return current;
+        }
+
+        if (key < current->data.first) {
+            node_ptr left = do_erase(current->left, key, erased);
+            return erased ? balance_tree(current->data, left, current->right) : current;
+        } else if (key > current->data.first) {
+            node_ptr right = do_erase(current->right, key, erased);
+            return erased ? balance_tree(current->data, current->left, right) : current;
+        }
+
+        erased = true;
+        if (current->left == nullptr) {
+            return current->right;
+        } else if (current->right == nullptr) {
+            return current->left;
+        }
+        const node * minimum = current->right->find_minimum();
+        return balance_tree(minimum->data, current->left, erase_minimum(current->right));
+    }
+
+    node_ptr erase_minimum(const node_ptr & current) {
+        if (current->left == nullptr) {
+            return current->right;
+        }
+        return balance_tree(current->data, erase_minimum(current->left), current->right);
+    }
+
+    iterator upper_bound(const K & key) const {
+        // Devuelve el primer elemento con clave mayor a key: es el último nodo
+        // del camino de búsqueda en el que se bajó hacia la izquierda.
+        iterator result(m_root.get());
+        std::size_t last_left = 0;
+        const node * current = m_root.get();
+        while (current != nullptr) {
+            result.m_path.push_back(current);
+            if (key < current->data.first) {
+                last_left = result.m_path.size();
+                current = current->left.get();
+            } else {
+                current = current->right.get();
+            }
+        }
+        result.m_path.resize(last_left);
+        return result;
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla
+    void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+        if (current != nullptr) {
+            calculate_nodes_placement(current->left.get(), x, h+1, placements);
+            placements.emplace_back(h, x++, current);
+            calculate_nodes_placement(current->right.get(), x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_root.get(), count, 0, placements);
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << the_node->data.first;
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // PERSISTENT_MAP_H
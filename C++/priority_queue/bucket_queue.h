@@ -0,0 +1,141 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <cstddef>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Cola de baldes (la de Dial) para prioridades enteras sin signo que se usan
+// en forma monótona, como radix_heap, y que además están todas a menos de C
+// de la última sacada (en Dijkstra, C es el peso máximo de las aristas).
+// Hay un balde por cada prioridad posible en un arreglo circular de al menos
+// C baldes, y un cursor que avanza de a una prioridad hasta encontrar un balde
+// no vacío: push es O(1) y pop es O(1) más lo que avanza el cursor, que en
+// total es a lo sumo la prioridad más grande sacada.
+//
+// No hace falta dar C: el arreglo arranca vacío y, si una prioridad no entra,
+// se agranda a la potencia de 2 siguiente y se reparten los elementos. Por
+// eso conviene cuando C es chico; si no, radix_heap usa menos memoria.
+template <typename P, typename T>
+class bucket_queue {
+    static_assert(std::is_integral<P>::value && std::is_unsigned<P>::value,
+                  "Las prioridades tienen que ser enteros sin signo");
+
+public:
+    using value_type = T;
+    using priority_type = P;
+
+    bucket_queue() {
+        m_last = 0;
+        m_size = 0;
+    }
+
+    void push(const priority_type & priority, const value_type & value) {
+        // Precondición: priority >= la última prioridad sacada
+        bucket_for(priority).push_back({priority, value});
+        ++m_size;
+    }
+
+    void push(priority_type && priority, value_type && value) {
+        // Precondición: priority >= la última prioridad sacada
+        bucket_for(priority).emplace_back(std::move(priority), std::move(value));
+        ++m_size;
+    }
+
+    // Construye el valor con args directamente en su balde
+    template <typename... Args>
+    void emplace(const priority_type & priority, Args &&... args) {
+        // Precondición: priority >= la última prioridad sacada
+        bucket_for(priority).emplace_back(std::piecewise_construct, std::forward_as_tuple(priority),
+                                          std::forward_as_tuple(std::forward<Args>(args)...));
+        ++m_size;
+    }
+
+    std::pair<const priority_type, value_type &> top() {
+        // Precondición: !empty()
+        auto & bucket = first_bucket();
+        return { bucket.back().first, bucket.back().second };
+    }
+
+    void pop() {
+        // Precondición: !empty()
+        first_bucket().pop_back();
+        --m_size;
+    }
+
+    // Saca el valor del tope moviéndolo, sin copiarlo
+    value_type pop_top() {
+        // Precondición: !empty()
+        auto & bucket = first_bucket();
+        value_type value = std::move(bucket.back().second);
+        bucket.pop_back();
+        --m_size;
+        return value;
+    }
+
+    bool empty() {
+        return m_size == 0;
+    }
+
+    size_t size() {
+        return m_size;
+    }
+
+    friend
+    std::ostream & operator<<(std::ostream & out, bucket_queue & q) {
+        out << "bucket_queue { ";
+        for (auto & bucket : q.m_buckets) {
+            for (auto & d : bucket) {
+                out << d.first << ':' << d.second << ' ';
+            }
+        }
+        return out << "}";
+    }
+
+private:
+    using data_type = std::pair<priority_type, value_type>;
+
+    // La resta se vuelve a llevar a priority_type porque, si P es más chico
+    // que int, la promoción la hace en int y se compararía con signo contra
+    // size()
+    std::vector<data_type> & bucket_for(const priority_type & priority) {
+        std::size_t spread = std::size_t(priority_type(priority - m_last));
+        if (spread >= m_buckets.size()) {
+            grow(spread);
+        }
+        return m_buckets[priority & (m_buckets.size() - 1)];
+    }
+
+    // Avanza el cursor hasta el primer balde no vacío
+    std::vector<data_type> & first_bucket() {
+        std::size_t mask = m_buckets.size() - 1;
+        while (m_buckets[m_last & mask].empty()) {
+            ++m_last;
+        }
+        return m_buckets[m_last & mask];
+    }
+
+    // Agranda el arreglo para que entren las prioridades hasta m_last + spread
+    void grow(std::size_t spread) {
+        std::size_t size = m_buckets.empty() ? 16 : m_buckets.size();
+        while (size <= spread) {
+            size *= 2;
+        }
+        std::vector<std::vector<data_type>> buckets(size);
+        for (auto & bucket : m_buckets) {
+            for (auto & d : bucket) {
+                buckets[d.first & (size - 1)].push_back(std::move(d));
+            }
+        }
+        m_buckets.swap(buckets);
+    }
+
+    std::vector<std::vector<data_type>> m_buckets;
+    priority_type m_last;
+    size_t m_size;
+};
+
+#endif // BUCKET_QUEUE_H
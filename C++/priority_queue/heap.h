@@ -2,55 +2,167 @@
 #define HEAP_H
 
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <new>
 #include <utility>
 
-template <typename Container, typename Comparator = std::less<>>
-void up_heap(Container & data, std::size_t index, Comparator cmp = Comparator{}) {
-    using std::swap;
+// Las funciones trabajan sobre montículos de Arity hijos por nodo (2 por
+// defecto): los hijos de index son Arity * index + 1 ... Arity * index + Arity.
+// Con más hijos el montículo es menos profundo, así que pop recorre menos
+// niveles (cada uno con un fallo de caché) a cambio de más comparaciones por
+// nivel, que son baratas si los hermanos están en la misma línea de caché.
+
+// En vez de intercambiar un elemento con su padre o su hijo en cada nivel,
+// up_heap y down_heap lo mueven afuera una sola vez y van corriendo el
+// "hueco" que deja: cada nivel cuesta un solo movimiento y el elemento se
+// mueve de nuevo recién al llegar a su lugar. Container tiene que tener
+// value_type, size() y operator[] (std::vector, std::deque, etc.).
 
+// Sube el hueco index hasta el lugar de value y lo deja ahí
+template <std::size_t Arity, typename Container, typename Comparator>
+void fill_hole_upwards(Container & data, std::size_t index,
+                       typename Container::value_type & value, Comparator & cmp) {
     while (index > 0) {
-        size_t parent = (index - 1) / 2;
-        if (cmp(data[index], data[parent])) {
-            swap(data[index], data[parent]);
-            index = parent;
-        } else {
+        std::size_t parent = (index - 1) / Arity;
+        if (!cmp(value, data[parent])) {
             break;
         }
+        data[index] = std::move(data[parent]);
+        index = parent;
+    }
+    data[index] = std::move(value);
+}
+
+// El hijo que va primero entre first y last - 1
+template <typename Container, typename Comparator>
+std::size_t best_child(Container & data, std::size_t first, std::size_t last, Comparator & cmp) {
+    std::size_t selected = first;
+    for (std::size_t child = first + 1; child < last; ++child) {
+        if (cmp(data[child], data[selected])) {
+            selected = child;
+        }
     }
+    return selected;
+}
+
+template <std::size_t Arity = 2, typename Container, typename Comparator = std::less<>>
+void up_heap(Container & data, std::size_t index, Comparator cmp = Comparator{}) {
+    static_assert(Arity >= 2, "Cada nodo tiene que tener al menos 2 hijos");
+
+    typename Container::value_type value = std::move(data[index]);
+    fill_hole_upwards<Arity>(data, index, value, cmp);
 }
 
-template <typename Container, typename Comparator = std::less<>>
+template <std::size_t Arity = 2, typename Container, typename Comparator = std::less<>>
 void down_heap(Container & data, std::size_t index, Comparator cmp = Comparator{}) {
-    using std::swap;
+    static_assert(Arity >= 2, "Cada nodo tiene que tener al menos 2 hijos");
 
+    std::size_t size = data.size();
+    if (Arity * index + 1 >= size) {
+        return;
+    }
+    typename Container::value_type value = std::move(data[index]);
     while (true) {
-        std::size_t left = 2 * index + 1;
-        std::size_t right = left + 1;
-        std::size_t selected = index;
-        if (left < data.size() && cmp(data[left], data[selected])) {
-            selected = left;
-        }
-        if (right < data.size() && cmp(data[right], data[selected])) {
-            selected = right;
+        std::size_t first = Arity * index + 1;
+        if (first >= size) {
+            break;
         }
-        if (selected == index) {
+        std::size_t selected = best_child(data, first, first + Arity < size ? first + Arity : size, cmp);
+        if (!cmp(data[selected], value)) {
             break;
         }
-        swap(data[index], data[selected]);
+        data[index] = std::move(data[selected]);
         index = selected;
     }
+    data[index] = std::move(value);
+}
+
+// Saca la raíz del montículo con la variante de Floyd: el último elemento,
+// que reemplaza a la raíz, casi siempre vuelve cerca de las hojas, así que
+// en lugar de compararlo en cada nivel al bajar (down_heap) se baja el hueco
+// de la raíz hasta una hoja por el camino de los mejores hijos y recién
+// ahí se sube el último elemento hasta su lugar, que suele estar a uno o
+// dos niveles. Así se ahorra casi una comparación por nivel.
+template <std::size_t Arity = 2, typename Container, typename Comparator = std::less<>>
+void remove_top(Container & data, Comparator cmp = Comparator{}) {
+    // Precondición: data.size() > 0
+    static_assert(Arity >= 2, "Cada nodo tiene que tener al menos 2 hijos");
+
+    std::size_t size = data.size() - 1;
+    if (size > 0) {
+        typename Container::value_type value = std::move(data[size]);
+        std::size_t index = 0;
+        while (true) {
+            std::size_t first = Arity * index + 1;
+            if (first >= size) {
+                break;
+            }
+            std::size_t selected = best_child(data, first, first + Arity < size ? first + Arity : size, cmp);
+            data[index] = std::move(data[selected]);
+            index = selected;
+        }
+        fill_hole_upwards<Arity>(data, index, value, cmp);
+    }
+    data.pop_back();
 }
 
-template <typename Container, typename Comparator = std::less<>>
+template <std::size_t Arity = 2, typename Container, typename Comparator = std::less<>>
 void heapify(Container & data, Comparator cmp = Comparator{}) {
     if (data.size() < 2) {
         return;
     }
-    std::size_t parent = (data.size() - 2) / 2;
+    std::size_t parent = (data.size() - 2) / Arity;
     do {
-        down_heap(data, parent, cmp);
+        down_heap<Arity>(data, parent, cmp);
     } while (parent-- > 0);
 }
 
+// Asignador para el arreglo de un montículo: deja el elemento 1 (el primer
+// hijo de la raíz) al principio de una línea de caché. Como los grupos de
+// hermanos empiezan en Arity * index + 1, si Arity * sizeof(T) divide a 64
+// (o es múltiplo de 64) ningún grupo queda partido entre dos líneas.
+//
+// El puntero que devolvió operator new se guarda justo antes del arreglo
+// para poder liberarlo.
+template <typename T>
+struct heap_allocator {
+    using value_type = T;
+
+    static const std::size_t cache_line = 64;
+
+    heap_allocator() = default;
+
+    template <typename U>
+    heap_allocator(const heap_allocator<U> &) {
+    }
+
+    T * allocate(std::size_t count) {
+        std::size_t extra = sizeof(void *) + cache_line;
+        char * raw = static_cast<char *>(::operator new(count * sizeof(T) + extra));
+        std::uintptr_t second = std::uintptr_t(raw + sizeof(void *) + sizeof(T));
+        second = (second + cache_line - 1) & ~std::uintptr_t(cache_line - 1);
+        char * first = reinterpret_cast<char *>(second) - sizeof(T);
+        std::memcpy(first - sizeof(void *), &raw, sizeof(void *));
+        return reinterpret_cast<T *>(first);
+    }
+
+    void deallocate(T * data, std::size_t) {
+        void * raw;
+        std::memcpy(&raw, reinterpret_cast<char *>(data) - sizeof(void *), sizeof(void *));
+        ::operator delete(raw);
+    }
+
+    friend
+    bool operator==(const heap_allocator &, const heap_allocator &) {
+        return true;
+    }
+
+    friend
+    bool operator!=(const heap_allocator &, const heap_allocator &) {
+        return false;
+    }
+};
+
 #endif // HEAP_H
@@ -0,0 +1,207 @@
+#ifndef INDEXED_PRIORITY_QUEUE_H
+#define INDEXED_PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "heap.h"
+
+// Cola con prioridad de "manijas": números entre 0 y n - 1 (por ejemplo los
+// vértices de un grafo) que pueden estar a lo sumo una vez en la cola. Además
+// del montículo se guarda la posición de cada manija dentro de él, así que
+// se puede cambiar la prioridad de una manija que ya está en la cola o
+// sacarla en O(log n), sin buscarla.
+//
+// El montículo se maneja con las mismas funciones de heap.h: se les pasa una
+// vista del arreglo que, cada vez que esas funciones mueven un elemento,
+// actualiza la posición de su manija.
+template <typename P, typename Comparator = std::less<P>, std::size_t Arity = 2>
+class indexed_priority_queue {
+public:
+    using priority_type = P;
+    using handle_type = std::size_t;
+
+    indexed_priority_queue(Comparator cmp = Comparator()) {
+        m_cmp = priority_comparator { cmp };
+    }
+
+    // Reserva lugar para las manijas entre 0 y count - 1
+    explicit indexed_priority_queue(std::size_t count, Comparator cmp = Comparator()) {
+        m_cmp = priority_comparator { cmp };
+        m_position.resize(count, absent);
+        m_data.reserve(count);
+    }
+
+    void push(handle_type handle, const priority_type & priority) {
+        // Precondición: !contains(handle)
+        if (handle >= m_position.size()) {
+            m_position.resize(handle + 1, absent);
+        }
+        std::size_t i = m_data.size();
+        m_data.push_back({priority, handle});
+        m_position[handle] = i;
+        view heap { m_data, m_position };
+        up_heap<Arity>(heap, i, m_cmp);
+    }
+
+    void pop() {
+        // Precondición: !empty()
+        m_position[m_data.front().handle] = absent;
+        view heap { m_data, m_position };
+        remove_top<Arity>(heap, m_cmp);
+    }
+
+    std::pair<const priority_type &, handle_type> top() {
+        // Precondición: !empty()
+        return { m_data.front().priority, m_data.front().handle };
+    }
+
+    bool contains(handle_type handle) {
+        return handle < m_position.size() && m_position[handle] != absent;
+    }
+
+    const priority_type & priority(handle_type handle) {
+        // Precondición: contains(handle)
+        return m_data[m_position[handle]].priority;
+    }
+
+    // Le da a handle una prioridad que va antes (o igual) que la que tenía
+    void decrease_key(handle_type handle, const priority_type & priority) {
+        // Precondición: contains(handle) && !cmp(this->priority(handle), priority)
+        std::size_t i = m_position[handle];
+        m_data[i].priority = priority;
+        view heap { m_data, m_position };
+        up_heap<Arity>(heap, i, m_cmp);
+    }
+
+    // Le da a handle una prioridad que va después (o igual) que la que tenía
+    void increase_key(handle_type handle, const priority_type & priority) {
+        // Precondición: contains(handle) && !cmp(priority, this->priority(handle))
+        std::size_t i = m_position[handle];
+        m_data[i].priority = priority;
+        view heap { m_data, m_position };
+        down_heap<Arity>(heap, i, m_cmp);
+    }
+
+    // Saca a handle de la cola, esté donde esté. Devuelve si estaba.
+    bool erase(handle_type handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        std::size_t i = m_position[handle];
+        std::size_t last = m_data.size() - 1;
+        m_position[handle] = absent;
+        view heap { m_data, m_position };
+        if (i != last) {
+            // El último ocupa el lugar de handle y puede tener que subir o
+            // bajar desde ahí
+            heap[i] = m_data[last];
+            heap.pop_back();
+            if (i > 0 && m_cmp(m_data[i], m_data[(i - 1) / Arity])) {
+                up_heap<Arity>(heap, i, m_cmp);
+            } else {
+                down_heap<Arity>(heap, i, m_cmp);
+            }
+        } else {
+            heap.pop_back();
+        }
+        return true;
+    }
+
+    bool empty() {
+        return m_data.empty();
+    }
+
+    std::size_t size() {
+        return m_data.size();
+    }
+
+    friend
+    std::ostream & operator<<(std::ostream & out, indexed_priority_queue & q) {
+        out << "indexed_priority_queue { ";
+        for (auto & d : q.m_data) {
+            out << d.handle << ':' << d.priority << ' ';
+        }
+        return out << "}";
+    }
+
+private:
+    static const std::size_t absent = std::size_t(-1);
+
+    struct data_type {
+        priority_type priority;
+        handle_type handle;
+    };
+
+    struct priority_comparator {
+        Comparator cmp;
+
+        bool operator()(const data_type & x, const data_type & y) {
+            return cmp(x.priority, y.priority);
+        }
+    };
+
+    // Lo que ven up_heap, down_heap y remove_top: un arreglo cuyos
+    // casilleros, al asignarles un elemento, anotan en m_position dónde
+    // quedó su manija
+    class view {
+    public:
+        using value_type = data_type;
+
+        class slot {
+        public:
+            slot(view & heap, std::size_t index) : m_heap(heap), m_index(index) {
+            }
+
+            operator data_type &() const {
+                return m_heap.m_data[m_index];
+            }
+
+            slot & operator=(const data_type & x) {
+                m_heap.m_data[m_index] = x;
+                m_heap.m_position[x.handle] = m_index;
+                return *this;
+            }
+
+            slot & operator=(const slot & x) {
+                return *this = static_cast<data_type &>(x);
+            }
+
+        private:
+            view & m_heap;
+            std::size_t m_index;
+        };
+
+        view(std::vector<data_type, heap_allocator<data_type>> & data, std::vector<std::size_t> & position)
+            : m_data(data), m_position(position) {
+        }
+
+        slot operator[](std::size_t index) {
+            return slot(*this, index);
+        }
+
+        std::size_t size() {
+            return m_data.size();
+        }
+
+        void pop_back() {
+            m_data.pop_back();
+        }
+
+    private:
+        std::vector<data_type, heap_allocator<data_type>> & m_data;
+        std::vector<std::size_t> & m_position;
+    };
+
+    std::vector<data_type, heap_allocator<data_type>> m_data;
+    std::vector<std::size_t> m_position;
+    priority_comparator m_cmp;
+};
+
+template <typename P, typename Comparator, std::size_t Arity>
+const std::size_t indexed_priority_queue<P, Comparator, Arity>::absent;
+
+#endif // INDEXED_PRIORITY_QUEUE_H
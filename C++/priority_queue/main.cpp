@@ -1,9 +1,14 @@
 #include <iostream>
 #include <functional>
+#include <random>
 #include <vector>
 
 #include "heap.h"
 #include "priority_queue.h"
+#include "indexed_priority_queue.h"
+#include "radix_heap.h"
+#include "bucket_queue.h"
+#include "../benchmark/measure.h"
 
 using namespace std;
 
@@ -16,6 +21,50 @@ ostream & operator<<(ostream & out, const vector<T> & vec) {
     return out << "}";
 }
 
+// Mete todas las prioridades en una cola de Arity hijos por nodo y después
+// las saca, verificando que salgan en orden
+template <size_t Arity>
+void benchmark(const vector<int> & priorities) {
+    priority_queue<int, int, less<int>, Arity> q;
+    double push_time = measure([&] {
+        for (int p : priorities) {
+            q.push(p, p);
+        }
+    });
+    bool sorted = true;
+    int last = 0;
+    double pop_time = measure([&] {
+        while (!q.empty()) {
+            sorted = sorted && last <= q.top().first;
+            last = q.top().first;
+            q.pop();
+        }
+    });
+    cerr << "  " << Arity << " hijos: push " << push_time << " s, pop " << pop_time
+         << " s - ¿en orden? " << boolalpha << sorted << endl;
+}
+
+// Uso monótono como el de Dijkstra: cada vez que se saca la prioridad d se
+// meten dos prioridades entre d + 1 y d + max_step, hasta hacer n pops
+template <typename Queue>
+double monotone_workload(int n, unsigned max_step, unsigned long long & checksum) {
+    Queue q;
+    mt19937 rng(42);
+    return measure([&] {
+        for (unsigned i = 0; i < 1000; ++i) {
+            q.push(i, i);
+        }
+        for (int i = 0; i < n; ++i) {
+            unsigned d = q.top().first;
+            checksum += q.top().second;
+            q.pop();
+            for (int j = 0; j < 2 && int(q.size()) < 1000000; ++j) {
+                q.push(d + 1 + rng() % max_step, unsigned(i));
+            }
+        }
+    });
+}
+
 int main() {
     int data[] = {1, 10, 4, 20, 5, 7, 3, 12, 15, 11, 18, 25, 2, 0, 8, 1};
 
@@ -34,12 +83,20 @@ int main() {
 
     while (!v.empty()) {
         cerr << "v.top() => " << v.front() << endl;
-        v.front() = v.back();
-        v.pop_back();
-        down_heap(v, 0, cmp);
+        remove_top(v, cmp);
     }
 
     cerr << "v = " << v << endl;
+
+    // Lo mismo con 4 hijos por nodo
+    v.assign(begin(data), end(data));
+    heapify<4>(v, cmp);
+    cerr << "v (4 hijos) = " << v << endl;
+    while (!v.empty()) {
+        cerr << v.front() << ' ';
+        remove_top<4>(v, cmp);
+    }
+    cerr << endl;
     cerr << string(70, '=') << endl;
 
     // Probando la cola con prioridades *************************************
@@ -93,13 +150,95 @@ int main() {
     q4.push(100, "cien");
     q4.push(-20, "menos veinte");
 
+    q4.emplace(50, 3, '*');
+    q4.push(7, string("siete"));
+
     cerr << "q3 = " << q3 << endl;
     cerr << "q4 = " << q4 << endl;
     cerr << string(70, '=') << endl;
 
     while (!q4.empty()) {
-        cerr << "q4.top() => " << q4.top().first  << ", " << q4.top().second << endl;
-        q4.pop();
+        cerr << "q4.top().first => " << q4.top().first << ", ";
+        cerr << "q4.pop_top() => " << q4.pop_top() << endl;
+    }
+    cerr << string(70, '=') << endl;
+
+    // Probando la cola indexada *******************************************
+
+    indexed_priority_queue<int> q6;
+    for (size_t h = 0; h < 8; ++h) {
+        q6.push(h, int(10 * h));
+    }
+    cerr << "q6 = " << q6 << endl;
+    q6.decrease_key(6, 5);
+    q6.increase_key(0, 45);
+    cerr << "Bajando 6 a 5 y subiendo 0 a 45 => q6 = " << q6 << endl;
+    cerr << "Borrando 3 => " << boolalpha << q6.erase(3) << ", ¿q6 contiene a 3? " << q6.contains(3) << endl;
+    while (!q6.empty()) {
+        cerr << "q6.top() => " << q6.top().second << ':' << q6.top().first << endl;
+        q6.pop();
     }
     cerr << string(70, '=') << endl;
+
+    // Probando las colas monótonas ****************************************
+
+    radix_heap<unsigned, string> q7;
+    bucket_queue<unsigned, string> q8;
+    for (unsigned x : {5u, 3u, 12u, 3u, 40u, 7u}) {
+        q7.push(x, to_string(x));
+        q8.push(x, to_string(x));
+    }
+    cerr << "q7 = " << q7 << endl;
+    cerr << "q8 = " << q8 << endl;
+    for (int i = 0; i < 3; ++i) {
+        cerr << "q7.pop_top() => " << q7.pop_top() << ", q8.pop_top() => " << q8.pop_top() << endl;
+    }
+    q7.push(6, "6");
+    q8.push(6, "6");
+    cerr << "Después de sacar hasta 5 y meter 6: q7 = " << q7 << endl;
+    while (!q7.empty()) {
+        cerr << "q7.top() => " << q7.top().first << ", q8.top() => " << q8.top().first << endl;
+        q7.pop();
+        q8.pop();
+    }
+    cerr << string(70, '=') << endl;
+
+    const int n = 10000000;
+    cerr << "Metiendo y sacando " << n << " prioridades al azar según los hijos por nodo:" << endl;
+    vector<int> priorities(n);
+    mt19937 rng(42);
+    for (auto & p : priorities) {
+        p = int(rng() >> 1);
+    }
+    benchmark<2>(priorities);
+    benchmark<4>(priorities);
+    benchmark<8>(priorities);
+
+    const int m = 1000000;
+    cerr << "Metiendo y sacando " << m << " prioridades con valores de 16 enteros:" << endl;
+    priority_queue<int, vector<int>> q5;
+    long long sum = 0;
+    double push_time = measure([&] {
+        for (int i = 0; i < m; ++i) {
+            q5.emplace(priorities[i], 16, priorities[i]);
+        }
+    });
+    double pop_time = measure([&] {
+        while (!q5.empty()) {
+            sum += q5.pop_top()[3];
+        }
+    });
+    cerr << "  push " << push_time << " s, pop " << pop_time << " s (suma " << sum << ")" << endl;
+
+    cerr << "Uso monótono (como en Dijkstra) con " << n << " pops:" << endl;
+    for (unsigned max_step : { 1000u, 10u }) {
+        unsigned long long c1 = 0;
+        unsigned long long c2 = 0;
+        unsigned long long c3 = 0;
+        double binary_time = monotone_workload<priority_queue<unsigned, unsigned>>(n, max_step, c1);
+        double radix_time = monotone_workload<radix_heap<unsigned, unsigned>>(n, max_step, c2);
+        double bucket_time = monotone_workload<bucket_queue<unsigned, unsigned>>(n, max_step, c3);
+        cerr << "  saltos de hasta " << max_step << ": priority_queue " << binary_time << " s, radix_heap "
+             << radix_time << " s, bucket_queue " << bucket_time << " s" << endl;
+    }
 }
@@ -3,12 +3,17 @@
 
 #include <cstddef>
 #include <functional>
+#include <ostream>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "heap.h"
 
-template <typename P, typename T, typename Comparator = std::less<P>>
+// Arity es la cantidad de hijos de cada nodo del montículo (ver heap.h).
+// Con 4 u 8 hijos pop baja por menos niveles, lo que conviene cuando la cola
+// es grande y los pares (prioridad, valor) son chicos.
+template <typename P, typename T, typename Comparator = std::less<P>, std::size_t Arity = 2>
 class priority_queue {
 public:
     using value_type = T;
@@ -21,14 +26,35 @@ public:
     void push(const priority_type & priority, const value_type & value) {
         size_t i = m_data.size();
         m_data.push_back({priority, value});
-        up_heap(m_data, i, m_cmp);
+        up_heap<Arity>(m_data, i, m_cmp);
+    }
+
+    void push(priority_type && priority, value_type && value) {
+        size_t i = m_data.size();
+        m_data.emplace_back(std::move(priority), std::move(value));
+        up_heap<Arity>(m_data, i, m_cmp);
+    }
+
+    // Construye el valor con args directamente en el arreglo del montículo
+    template <typename... Args>
+    void emplace(const priority_type & priority, Args &&... args) {
+        size_t i = m_data.size();
+        m_data.emplace_back(std::piecewise_construct, std::forward_as_tuple(priority),
+                            std::forward_as_tuple(std::forward<Args>(args)...));
+        up_heap<Arity>(m_data, i, m_cmp);
     }
 
     void pop() {
-        m_data.front() = m_data.back();
-        m_data.pop_back();
-        down_heap(m_data, 0, m_cmp);
+        // Precondición: !empty()
+        remove_top<Arity>(m_data, m_cmp);
+    }
 
+    // Saca el valor del tope moviéndolo, sin copiarlo
+    value_type pop_top() {
+        // Precondición: !empty()
+        value_type value = std::move(m_data.front().second);
+        remove_top<Arity>(m_data, m_cmp);
+        return value;
     }
 
     std::pair<const priority_type, value_type &> top() {
@@ -63,7 +89,7 @@ private:
         }
     };
 
-    std::vector<data_type> m_data;
+    std::vector<data_type, heap_allocator<data_type>> m_data;
     priority_comparator m_cmp;
 };
 
@@ -0,0 +1,157 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Cola con prioridad para prioridades enteras sin signo que se usan en forma
+// monótona: nunca se mete una prioridad menor que la última que se sacó
+// (como las distancias en el algoritmo de Dijkstra). En lugar de comparar
+// elementos, los reparte en baldes según el bit más alto en el que su
+// prioridad difiere de la última sacada (last): el balde 0 tiene los de
+// prioridad igual a last y el balde i, aquellos cuyo bit más alto distinto
+// del de last es el i - 1.
+//
+// Cuando el balde 0 se vacía, se busca el primer balde no vacío, su mínimo
+// pasa a ser last y sus elementos se reparten en baldes más chicos. Cada
+// elemento sólo puede bajar de balde, así que se mueve a lo sumo una vez por
+// bit: push es O(1) y pop es O(log C) amortizado, siendo C el rango de las
+// prioridades.
+template <typename P, typename T>
+class radix_heap {
+    static_assert(std::is_integral<P>::value && std::is_unsigned<P>::value,
+                  "Las prioridades tienen que ser enteros sin signo");
+
+public:
+    using value_type = T;
+    using priority_type = P;
+
+    radix_heap() {
+        m_last = 0;
+        m_size = 0;
+    }
+
+    void push(const priority_type & priority, const value_type & value) {
+        // Precondición: priority >= la última prioridad sacada
+        m_buckets[bucket_of(priority)].push_back({priority, value});
+        ++m_size;
+    }
+
+    void push(priority_type && priority, value_type && value) {
+        // Precondición: priority >= la última prioridad sacada
+        m_buckets[bucket_of(priority)].emplace_back(std::move(priority), std::move(value));
+        ++m_size;
+    }
+
+    // Construye el valor con args directamente en su balde
+    template <typename... Args>
+    void emplace(const priority_type & priority, Args &&... args) {
+        // Precondición: priority >= la última prioridad sacada
+        m_buckets[bucket_of(priority)].emplace_back(std::piecewise_construct, std::forward_as_tuple(priority),
+                                                    std::forward_as_tuple(std::forward<Args>(args)...));
+        ++m_size;
+    }
+
+    std::pair<const priority_type, value_type &> top() {
+        // Precondición: !empty()
+        refill();
+        return { m_buckets[0].back().first, m_buckets[0].back().second };
+    }
+
+    void pop() {
+        // Precondición: !empty()
+        refill();
+        m_buckets[0].pop_back();
+        --m_size;
+    }
+
+    // Saca el valor del tope moviéndolo, sin copiarlo
+    value_type pop_top() {
+        // Precondición: !empty()
+        refill();
+        value_type value = std::move(m_buckets[0].back().second);
+        m_buckets[0].pop_back();
+        --m_size;
+        return value;
+    }
+
+    bool empty() {
+        return m_size == 0;
+    }
+
+    size_t size() {
+        return m_size;
+    }
+
+    friend
+    std::ostream & operator<<(std::ostream & out, radix_heap & h) {
+        out << "radix_heap { ";
+        for (int i = 0; i < buckets; ++i) {
+            if (!h.m_buckets[i].empty()) {
+                out << i << ": [ ";
+                for (auto & d : h.m_buckets[i]) {
+                    out << d.first << ':' << d.second << ' ';
+                }
+                out << "] ";
+            }
+        }
+        return out << "}";
+    }
+
+private:
+    using data_type = std::pair<priority_type, value_type>;
+
+    static const int buckets = std::numeric_limits<P>::digits + 1;
+
+    // Cantidad de bits significativos de x
+    static int bit_width(unsigned long long x) {
+#ifdef __GNUC__
+        return x == 0 ? 0 : std::numeric_limits<unsigned long long>::digits - __builtin_clzll(x);
+#else
+        int width = 0;
+        while (x != 0) {
+            x >>= 1;
+            ++width;
+        }
+        return width;
+#endif
+    }
+
+    int bucket_of(const priority_type & priority) {
+        return bit_width((unsigned long long)(priority ^ m_last));
+    }
+
+    // Deja en el balde 0 los elementos de prioridad mínima
+    void refill() {
+        if (!m_buckets[0].empty()) {
+            return;
+        }
+        int i = 1;
+        while (m_buckets[i].empty()) {
+            ++i;
+        }
+        auto & bucket = m_buckets[i];
+        priority_type minimum = bucket.front().first;
+        for (auto & d : bucket) {
+            if (d.first < minimum) {
+                minimum = d.first;
+            }
+        }
+        m_last = minimum;
+        for (auto & d : bucket) {
+            m_buckets[bucket_of(d.first)].push_back(std::move(d));
+        }
+        bucket.clear();
+    }
+
+    std::vector<data_type> m_buckets[buckets];
+    priority_type m_last;
+    size_t m_size;
+};
+
+#endif // RADIX_HEAP_H
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <string>
+#include <utility>
 
 using namespace std;
 
@@ -81,6 +82,11 @@ int main() {
 
     cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
     cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+    cout << ":: Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << *p << " ";
+    }
+    cout << endl;
 
     cout << "  t1 = " << t1 << endl;
     for (int x : {8, 12, 4, 10, 42}) {
@@ -98,6 +104,22 @@ int main() {
         cout << "  t2 = " << t2 << endl;
     }
 
+    cout << ":: Cambiando el 3 de t2 por un 30 sin pedir memoria:" << endl;
+    auto nodo = t2.extract(3);
+    nodo.value() = 30;
+    t2.insert(move(nodo));
+    cout << "  t2 = " << t2 << endl;
+
+    cout << ":: Sacando el mínimo de t2 y volviéndolo a poner:" << endl;
+    t2.insert(t2.extract(t2.begin()));
+    cout << "  t2 = " << t2 << endl;
+
+    cout << ":: Mezclando una copia de t1 con t2:" << endl;
+    tree<int> otro = t1;
+    t2.merge(otro);
+    cout << "  t2 = " << t2 << endl;
+    cout << "  otro = " << otro << " (los valores que ya estaban en t2 quedan en otro)" << endl;
+
     cout << ":: Asignando t2 = t1:" << endl;
     t2 = t1;
     cout << "  t1 = " << t1 << " - ¿t1 está vacio? " << t1.empty() << endl;
@@ -2,8 +2,7 @@
 #define BINARY_SEARCH_TREE_H
 
 #include <cstddef>    // Para std::size_t
-#include <functional> // Para std::function
-#include <iterator>   // Para std::forward_iterator_tag
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
 #include <stack>      // Para std::stack
 #include <utility>    // Para std::pair y std::swap
 
@@ -25,26 +24,47 @@
 template <typename T>
 class tree {
 private:
-    struct node {
-        T value;
-        node * left;
-        node * right;
-        node * parent;
+    // Los enlaces de un nodo; node agrega el valor y m_root tiene sólo esto
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
 
-        node * find_minimum() {
+        node_base * find_minimum() {
             if (left != nullptr)
                 return left->find_minimum();
             return this;
         }
 
-        node * find_maximum() {
+        node_base * find_maximum() {
             if (right != nullptr)
                 return right->find_maximum();
             return this;
         }
     };
 
-    node * m_root;
+    struct node : node_base {
+        T value;
+
+        node(const T & a_value, node_base * a_parent) : value(a_value) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // m_root no guarda ningún valor: hace de nodo cabecera, del que cuelga
+    // la raíz por la izquierda. Es el padre de la raíz y el final de los
+    // recorridos, así que desde end() se puede retroceder al máximo. Como no
+    // tiene valor, T no necesita poder construirse por defecto.
+    node_base m_root;
 
 public:
 
@@ -53,14 +73,12 @@ public:
     /************************************************************************/
 
     tree() {
-        m_root = nullptr;
+        m_root.left = m_root.right = m_root.parent = nullptr;
     }
 
     tree(tree & x) {
-        m_root = nullptr;
-        if (x.m_root != nullptr) {
-            copy_nodes(x.m_root, m_root, nullptr);
-        }
+        m_root.left = m_root.right = m_root.parent = nullptr;
+        copy_nodes(x.m_root.left, m_root.left, &m_root);
     }
 
     ~tree() {
@@ -75,31 +93,35 @@ public:
     friend
     void swap(tree & x, tree & y) {
         using namespace std;
-        swap(x.m_root, y.m_root);
+        swap(x.m_root.left, y.m_root.left);
+        x.assign_parent(x.m_root.left, &x.m_root);
+        y.assign_parent(y.m_root.left, &y.m_root);
     }
 
     /************************************************************************/
-    /************ ITERADOR LIVIANO QUE RECORRE AL ÁRBOL EN ORDEN ************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
     /************************************************************************/
 
     class iterator {
     private:
-        node * m_current;
+        node_base * m_current;
+
+        friend class tree;
 
     public:
         using value_type = T;
         using pointer = T *;
         using reference = T &;
         using difference_type = std::size_t;
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
 
-        iterator(node * current = nullptr) {
+        iterator(node_base * current = nullptr) {
             m_current = current;
         }
 
         reference operator*() {
-            // Precondición: m_current != nullptr
-            return m_current->value;
+            // Precondición: m_current != end()
+            return value_of(m_current);
         }
 
         pointer operator->() {
@@ -117,15 +139,15 @@ public:
         }
 
         iterator & operator++() {
-            // Precondición: m_current != nullptr
+            // Precondición: m_current != end()
             if (m_current->right != nullptr) {
                 m_current = m_current->right->find_minimum();
             } else {
-                node * prev;
+                node_base * prev;
                 do {
                     prev = m_current;
                     m_current = m_current->parent;
-                } while (m_current != nullptr and m_current->right == prev);
+                } while (m_current->right == prev);
             }
             return *this;
         }
@@ -135,17 +157,44 @@ public:
             operator++();
             return tmp;
         }
+
+        iterator & operator--() {
+            // Precondición: *this != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
     };
 
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
     iterator begin() {
-        if (empty()) {
-            return end();
-        }
-        return iterator(m_root->find_minimum());
+        return iterator(m_root.find_minimum());
     }
 
     iterator end() {
-        return iterator();
+        return iterator(&m_root);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
     }
 
     /************************************************************************/
@@ -153,7 +202,7 @@ public:
     /************************************************************************/
 
     bool empty() {
-        return m_root == nullptr;
+        return m_root.left == nullptr;
     }
 
     friend
@@ -175,7 +224,7 @@ public:
     }
 
     iterator find(const T & value) {
-        return do_find(m_root, value);
+        return do_find(m_root.left, value);
     }
 
     bool contains(const T & value) {
@@ -183,19 +232,39 @@ public:
     }
 
     iterator minimum() {
-        if (m_root == nullptr)
-            return end();
-        return m_root->find_minimum();
+        return begin();
     }
 
     iterator maximum() {
-        if (m_root == nullptr)
+        if (m_root.left == nullptr)
             return end();
-        return m_root->find_maximum();
+        return m_root.left->find_maximum();
     }
 
-    void each(std::function<void(const T &)> func) {
-        do_each(m_root, func);
+    // func se pasa por referencia en cada llamada recursiva para no copiarlo
+    // en cada nivel.
+
+    template <typename F>
+    void each(F func) {
+        auto visit = [&](const T & value) { func(value); return true; };
+        do_each(m_root.left, visit);
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return do_each(m_root.left, func);
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        do_each_preorder(m_root.left, func);
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        do_each_postorder(m_root.left, func);
     }
 
     /************************************************************************/
@@ -203,16 +272,117 @@ public:
     /************************************************************************/
 
     iterator insert(const T & value) {
-        return do_insert(m_root, nullptr, value);
+        return do_insert(m_root.left, &m_root, value);
     }
 
     std::pair<bool, iterator> erase(const T & value) {
-        return do_erase(m_root, value);
+        return do_erase(m_root.left, value);
     }
 
     void clear() {
-        do_clear(m_root);
-        m_root = nullptr;
+        do_clear(m_root.left);
+        m_root.left = nullptr;
+    }
+
+    /************************************************************************/
+    /********** NODOS SUELTOS: EXTRAER, REINSERTAR Y MEZCLAR ÁRBOLES ********/
+    /************************************************************************/
+
+    // Un node_handle es dueño de un nodo sacado del árbol con extract, que
+    // puede volver a insertarse (en éste o en otro árbol, quizás con otro
+    // valor) sin liberar ni pedir memoria. Si se destruye sin reinsertarlo,
+    // libera el nodo.
+    class node_handle {
+    private:
+        node * m_node;
+
+        friend class tree;
+
+        explicit node_handle(node * a_node) {
+            m_node = a_node;
+        }
+
+    public:
+        node_handle() {
+            m_node = nullptr;
+        }
+
+        node_handle(node_handle && x) {
+            m_node = x.m_node;
+            x.m_node = nullptr;
+        }
+
+        node_handle & operator=(node_handle && x) {
+            if (this != &x) {
+                delete m_node;
+                m_node = x.m_node;
+                x.m_node = nullptr;
+            }
+            return *this;
+        }
+
+        ~node_handle() {
+            delete m_node;
+        }
+
+        bool empty() const {
+            return m_node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return !empty();
+        }
+
+        T & value() {
+            // Precondición: !empty()
+            return m_node->value;
+        }
+    };
+
+    // Devuelve un node_handle vacío si value no está en el árbol
+    node_handle extract(const T & value) {
+        iterator position = find(value);
+        if (position == end()) {
+            return node_handle();
+        }
+        return extract(position);
+    }
+
+    node_handle extract(iterator position) {
+        // Precondición: position != end()
+        node_base * n = position.m_current;
+        unlink_node(link_to(n));
+        return node_handle(static_cast<node *>(n));
+    }
+
+    // Si el valor ya estaba, el nodo queda en handle y devuelve la posición
+    // del que ya estaba junto con false.
+    std::pair<iterator, bool> insert(node_handle && handle) {
+        if (handle.empty()) {
+            return { end(), false };
+        }
+        auto result = insert_node(handle.m_node);
+        if (result.second) {
+            handle.m_node = nullptr;
+        }
+        return result;
+    }
+
+    // Pasa a este árbol los nodos de other cuyos valores no están en éste
+    // (los demás quedan en other). Los nodos se enganchan en pre-orden, así
+    // que los que vuelven a other conservan la forma que tenían.
+    void merge(tree & other) {
+        if (&other == this) {
+            return;
+        }
+        node_base * pending = other.m_root.left;
+        other.m_root.left = nullptr;
+        while (pending != nullptr) {
+            node_base * n = detach_preorder_first(pending);
+            if (!insert_node(n).second) {
+                other.insert_node(n);
+            }
+        }
     }
 
 private:
@@ -221,52 +391,72 @@ private:
     /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
     /************************************************************************/
 
-    void copy_nodes(const node * other_node, node * & this_node, node * parent) {
+    void copy_nodes(const node_base * other_node, node_base * & this_node, node_base * parent) {
         if (other_node != nullptr) {
-            this_node = new node { other_node->value, nullptr, nullptr, parent };
+            this_node = new node(value_of(other_node), parent);
             copy_nodes(other_node->left, this_node->left, this_node);
             copy_nodes(other_node->right, this_node->right, this_node);
         }
     }
 
-    iterator do_find(node * current, const T & value) {
+    iterator do_find(node_base * current, const T & value) {
         if (current == nullptr) {
             return end();
-        } else if (value < current->value ) {
+        } else if (value < value_of(current) ) {
             return do_find(current->left, value);
-        } else if (value > current->value) {
+        } else if (value > value_of(current)) {
             return do_find(current->right, value);
         } else {
             return { current };
         }
     }
 
-    void do_each(const node * current, std::function<void(const T &)> func) {
+    template <typename F>
+    bool do_each(const node_base * current, F & func) {
+        if (current == nullptr) {
+            return true;
+        }
+        return do_each(current->left, func)
+            && func(value_of(current))
+            && do_each(current->right, func);
+    }
+
+    template <typename F>
+    void do_each_preorder(const node_base * current, F & func) {
         if (current != nullptr) {
-            do_each(current->left, func);
-            func(current->value);
-            do_each(current->right, func);
+            func(value_of(current));
+            do_each_preorder(current->left, func);
+            do_each_preorder(current->right, func);
         }
     }
 
-    iterator do_insert(node * & current, node * parent, const T & value) {
+    template <typename F>
+    void do_each_postorder(const node_base * current, F & func) {
+        if (current != nullptr) {
+            do_each_postorder(current->left, func);
+            do_each_postorder(current->right, func);
+            func(value_of(current));
+        }
+    }
+
+    iterator do_insert(node_base * & current, node_base * parent, const T & value) {
         if (current == nullptr) {
-            current = new node { value, nullptr, nullptr, parent };
-        } else if (value < current->value) {
+            current = new node(value, parent);
+        } else if (value < value_of(current)) {
             return do_insert(current->left, current, value);
-        } else if (value > current->value) {
+        } else if (value > value_of(current)) {
             return do_insert(current->right, current, value);
         }
         return { current };
     }
 
-    std::pair<bool, iterator> do_erase(node * & current, const T & value) {
+    std::pair<bool, iterator> do_erase(node_base * & current, const T & value) {
         if (current == nullptr)
             return { false, end() };
 
-        if (value < current->value) {
+        if (value < value_of(current)) {
             return do_erase(current->left, value);
-        } else if (value > current->value) {
+        } else if (value > value_of(current)) {
             return do_erase(current->right, value);
         }
 
@@ -275,8 +465,58 @@ private:
         return { true, next };
     }
 
-    void erase_node(node * & n) {
-        node * removed = n;
+    // Saca la raíz de pending, un árbol de nodos sueltos que se recorre en
+    // preorden, y deja en pending el resto con el mismo preorden: el
+    // subárbol derecho se cuelga del último nodo en preorden del izquierdo.
+    // Así merge no necesita una pila para recordar los subárboles derechos.
+    static node_base * detach_preorder_first(node_base * & pending) {
+        node_base * first = pending;
+        if (first->left == nullptr) {
+            pending = first->right;
+        } else {
+            pending = first->left;
+            if (first->right != nullptr) {
+                node_base * last = pending;
+                while (last->left != nullptr || last->right != nullptr) {
+                    last = last->right != nullptr ? last->right : last->left;
+                }
+                last->right = first->right;
+            }
+        }
+        return first;
+    }
+
+    // Engancha un nodo suelto como hoja, salvo que su valor ya esté
+    std::pair<iterator, bool> insert_node(node_base * n) {
+        return do_insert_node(m_root.left, &m_root, n);
+    }
+
+    std::pair<iterator, bool> do_insert_node(node_base * & current, node_base * parent, node_base * n) {
+        if (current == nullptr) {
+            n->left = n->right = nullptr;
+            n->parent = parent;
+            current = n;
+            return { iterator(n), true };
+        } else if (value_of(n) < value_of(current)) {
+            return do_insert_node(current->left, current, n);
+        } else if (value_of(n) > value_of(current)) {
+            return do_insert_node(current->right, current, n);
+        }
+        return { iterator(current), false };
+    }
+
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de m_root)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    void erase_node(node_base * & n) {
+        delete static_cast<node *>(unlink_node(n));
+    }
+
+    // Desengancha (sin liberarlo) al nodo apuntado por el enlace n y lo devuelve
+    node_base * unlink_node(node_base * & n) {
+        node_base * removed = n;
         if (n->left == nullptr) {
             n = n->right;
         } else if (n->right == nullptr) {
@@ -285,12 +525,12 @@ private:
             move_maximum_to(n, n->left);
         }
         assign_parent(n, removed->parent);
-        delete removed;
+        return removed;
     }
 
-    void move_maximum_to(node * & root, node * & current) {
+    void move_maximum_to(node_base * & root, node_base * & current) {
         if (current->right == nullptr) {
-            node * max = current;
+            node_base * max = current;
             assign_parent(max->left, max->parent);
             current = max->left;
             max->left = root->left;
@@ -303,17 +543,17 @@ private:
         }
     }
 
-    void assign_parent(node * & n, node * parent) {
+    void assign_parent(node_base * & n, node_base * parent) {
         if (n != nullptr) {
             n->parent = parent;
         }
     }
 
-    void do_clear(node * & current) {
+    void do_clear(node_base * & current) {
         if (current != nullptr) {
             do_clear(current->left);
             do_clear(current->right);
-            delete current;
+            delete static_cast<node *>(current);
         }
     }
 
@@ -321,10 +561,10 @@ private:
     /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
     /************************************************************************/
 
-    using nodes_placement = std::vector<std::tuple<int, int, const node *>>;
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
 
     // Calcula la posición de los nodos para poder mostrarlos en pantalla
-    void calculate_nodes_placement(const node * current, int & x, int h, nodes_placement & placements) const {
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
         if (current != nullptr) {
             calculate_nodes_placement(current->left, x, h+1, placements);
             placements.emplace_back(h, x++, current);
@@ -338,7 +578,7 @@ public:
     std::string str() const {
         int count = 0;
         nodes_placement placements;
-        calculate_nodes_placement(m_root, count, 0, placements);
+        calculate_nodes_placement(m_root.left, count, 0, placements);
 
         const int node_value_size = 3;
         std::vector<std::string> lines;
@@ -346,7 +586,7 @@ public:
         for (const auto & placement: placements) {
             int level;
             int pos;
-            const node * the_node;
+            const node_base * the_node;
             std::tie(level, pos, the_node) = placement;
 
             while (int(lines.size()) <= 2 * level) {
@@ -356,7 +596,7 @@ public:
             std::ostringstream s;
             int i = 2 * level;
             s << std::setw(pos * node_value_size - lines[i].size()) << "";
-            s << std::setw(node_value_size) << the_node->value;
+            s << std::setw(node_value_size) << value_of(the_node);
             lines[i] += s.str();
 
             if (prev_level != -1) {
@@ -0,0 +1,141 @@
+#include "rb_tree.h"
+#include "../avl/avl.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+ostream & operator<<(ostream & out, rb_tree<T> & t) {
+    out << "rb_tree { ";
+    for (const auto & x : t) {
+        out << x << " ";
+    }
+    out << "}" << endl << t.str();
+    return out;
+}
+
+void show_int(int v) {
+    cout << v << ' ';
+}
+
+// Una operación del benchmark: buscar, insertar o borrar key
+struct operation {
+    int kind;
+    int key;
+};
+
+template <typename Tree>
+long run(Tree & t, const vector<operation> & operations) {
+    long result = 0;
+    for (const auto & op : operations) {
+        if (op.kind == 0) {
+            result += t.contains(op.key);
+        } else if (op.kind == 1) {
+            t.insert(op.key);
+        } else {
+            result += t.erase(op.key).first;
+        }
+    }
+    return result;
+}
+
+int main() {
+    cout << ":: Insertando en t1 valores del 1 al 16 en orden:" << endl;
+    rb_tree<int> t1;
+    for (int x = 1; x < 17; ++x) {
+        t1.insert(x);
+    }
+    cout << "  t1 = " << t1 << endl;
+
+    cout << ":: Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "  ¿t1 == t2? " << boolalpha << (t1 == t2) << endl;
+
+    for (int x : {4, 8, 42}) {
+        cout << ":: Borrando un " << x << " en t1 => " << t1.erase(x).first << endl;
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
+    cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+    cout << ":: Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << *p << " ";
+    }
+    cout << endl;
+
+    cout << ":: Recorriendo t2 con each():" << endl;
+    cout << "  t2 = rb_tree { ";
+    t2.each(show_int);
+    cout << "}" << endl;
+
+    cout << endl << ":: Operaciones de conjuntos entre t3 (pares) y t4 (múltiplos de 3):" << endl;
+    rb_tree<int> t3, t4;
+    for (int x = 0; x < 20; ++x) {
+        t3.insert(2 * x);
+        t4.insert(3 * x);
+    }
+
+    rb_tree<int> unido = t3;
+    unido.set_union(t4);
+    cout << ":: t3 ∪ t4 = " << unido << endl;
+
+    rb_tree<int> interseccion = t3;
+    interseccion.set_intersection(t4);
+    cout << ":: t3 ∩ t4 = " << interseccion << endl;
+
+    cout << ":: Partiendo a t3 en 17:" << endl;
+    auto mayores = t3.split(17);
+    cout << "  t3 = " << t3 << endl;
+    cout << "  mayores = " << mayores << endl;
+
+    cout << ":: Volviendo a unir t3 con mayores:" << endl;
+    t3.join(mayores);
+    cout << "  t3 = " << t3 << endl;
+
+    cout << ":: Cambiando el 12 de t3 por un 13 sin pedir memoria:" << endl;
+    auto nodo = t3.extract(12);
+    nodo.value() = 13;
+    t3.insert(move(nodo));
+    cout << "  t3 = " << t3 << endl;
+
+    cout << ":: Mezclando una copia de t1 con t3:" << endl;
+    rb_tree<int> otro = t1;
+    t3.merge(otro);
+    cout << "  t3 = " << t3 << endl;
+    cout << "  otro = " << otro << " (los valores que ya estaban en t3 quedan en otro)" << endl;
+
+    const int n = 200000;
+    const int count = 2000000;
+    cout << ":: Comparando con el árbol AVL (" << n << " claves iniciales, " << count
+         << " operaciones al azar; las modificaciones son mitad inserciones y mitad borrados):" << endl;
+    mt19937 rng(42);
+    rb_tree<int> rb_base;
+    tree<int> avl_base;
+    for (int i = 0; i < n; ++i) {
+        int key = int(rng() % (2 * n));
+        rb_base.insert(key);
+        avl_base.insert(key);
+    }
+
+    for (int reads : {10, 50, 90}) {
+        vector<operation> operations(count);
+        for (auto & op : operations) {
+            op.key = int(rng() % (2 * n));
+            op.kind = int(rng() % 100) < reads ? 0 : 1 + int(rng() % 2);
+        }
+        rb_tree<int> rb = rb_base;
+        tree<int> avl = avl_base;
+        long rb_result = 0;
+        long avl_result = 0;
+        double rb_time = measure([&] { rb_result = run(rb, operations); });
+        double avl_time = measure([&] { avl_result = run(avl, operations); });
+        cout << "  " << reads << "% búsquedas: árbol rojinegro " << rb_time << " s, árbol AVL "
+             << avl_time << " s - ¿mismos resultados? " << (rb_result == avl_result) << endl;
+    }
+}
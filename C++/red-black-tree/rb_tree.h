@@ -0,0 +1,1215 @@
+#ifndef RB_TREE_H
+#define RB_TREE_H
+
+#include <algorithm>  // Para std::max y std::min
+#include <cstddef>    // Para std::size_t
+#include <future>     // Para std::async y std::future
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <system_error> // Para std::system_error
+#include <thread>     // Para std::thread::hardware_concurrency
+#include <utility>    // Para std::pair y std::swap
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/************************************************************************************/
+/************ Árbol rojinegro balanceado implementado con iterador liviano **********/
+/************************************************************************************/
+
+// Cada nodo es rojo o negro; la raíz es negra, un nodo rojo no tiene hijos
+// rojos y todos los caminos desde un nodo hasta un hijo nulo pasan por la
+// misma cantidad de nodos negros (su altura negra). Eso alcanza para que la
+// altura sea menor a 2 * log2(n + 1), algo más que en un árbol AVL, pero a
+// cambio cada inserción hace a lo sumo 2 rotaciones y cada borrado a lo sumo
+// 3; el resto de los arreglos son cambios de color que pueden subir hasta la
+// raíz pero no mueven nodos. Conviene cuando las modificaciones son tantas o
+// más que las búsquedas.
+
+template <typename T>
+class rb_tree {
+    // Enlaces y color, sin el valor: la cabecera es sólo esto (como en avl.h)
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
+        bool red;
+
+        node_base * find_minimum() {
+            node_base * minimum = this;
+            while (minimum->left != nullptr) {
+                minimum = minimum->left;
+            }
+            return minimum;
+        }
+
+        node_base * find_maximum() {
+            node_base * maximum = this;
+            while (maximum->right != nullptr) {
+                maximum = maximum->right;
+            }
+            return maximum;
+        }
+    };
+
+    struct node : node_base {
+        T value;
+
+        node(const T & a_value, node_base * a_parent, bool a_red) : value(a_value) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+            this->red = a_red;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // La raíz cuelga a la izquierda de m_header, un nodo cabecera negro que
+    // hace de padre de la raíz y de posición final de los iteradores (como
+    // en el árbol AVL). Como la cabecera no tiene valor, T no necesita poder
+    // construirse por defecto.
+    node_base m_header;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    rb_tree() {
+        init_header();
+    }
+
+    rb_tree(const rb_tree & x) {
+        init_header();
+        copy_nodes(x.m_header.left);
+    }
+
+    rb_tree(rb_tree && x) {
+        init_header();
+        set_root(x.m_header.left);
+        x.m_header.left = nullptr;
+    }
+
+    ~rb_tree() {
+        clear();
+    }
+
+    rb_tree & operator=(rb_tree x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(rb_tree & x, rb_tree & y) {
+        node_base * root = x.m_header.left;
+        x.set_root(y.m_header.left);
+        y.set_root(root);
+    }
+
+    /************************************************************************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        node_base * m_current;
+
+        friend class rb_tree;
+
+    public:
+        using value_type = T;
+        using pointer = value_type *;
+        using reference = value_type &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(node_base * current = nullptr) {
+            m_current = current;
+        }
+
+        reference operator*() {
+            // Precondición: m_current != end()
+            return value_of(m_current);
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        // Al subir desde el máximo se llega a la cabecera, que es end()
+        iterator & operator++() {
+            // Precondición: m_current != end()
+            if (m_current->right != nullptr) {
+                m_current = m_current->right->find_minimum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->right == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        // Desde end() baja al máximo, porque la raíz es el hijo izquierdo
+        // de la cabecera.
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        return iterator(m_header.find_minimum());
+    }
+
+    iterator end() {
+        return iterator(&m_header);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_header.left == nullptr;
+    }
+
+    friend
+    bool operator==(rb_tree & x, rb_tree & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(rb_tree & x, rb_tree & y) {
+        return !(x == y);
+    }
+
+    iterator find(const T & value) {
+        node_base * current = m_header.left;
+        while (current != nullptr) {
+            if (value < value_of(current)) {
+                current = current->left;
+            } else if (value > value_of(current)) {
+                current = current->right;
+            } else {
+                return iterator(current);
+            }
+        }
+        return end();
+    }
+
+    bool contains(const T & value) {
+        return find(value) != end();
+    }
+
+    iterator minimum() {
+        return begin();
+    }
+
+    iterator maximum() {
+        if (empty())
+            return end();
+        return iterator(m_header.left->find_maximum());
+    }
+
+    // Los recorridos usan la pila de tamaño fijo de visit_in_order (ver
+    // max_height más abajo) y no dependen del color de los nodos.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    iterator insert(const T & value) {
+        node_base * parent;
+        node_base ** ptr = find_link(value, parent);
+        if (*ptr != nullptr) {
+            return iterator(*ptr);
+        }
+        node_base * inserted = new node(value, parent, true);
+        *ptr = inserted;
+        insert_fixup(inserted);
+        return iterator(inserted);
+    }
+
+    std::pair<bool, iterator> erase(const T & value) {
+        node_base * current = m_header.left;
+        while (current != nullptr) {
+            if (value < value_of(current)) {
+                current = current->left;
+            } else if (value > value_of(current)) {
+                current = current->right;
+            } else {
+                iterator next = ++iterator(current);
+                erase_node(current);
+                return { true, next };
+            }
+        }
+        return { false, end() };
+    }
+
+    void clear() {
+        do_clear(m_header.left);
+        m_header.left = nullptr;
+    }
+
+    /************************************************************************/
+    /********** NODOS SUELTOS: EXTRAER, REINSERTAR Y MEZCLAR ÁRBOLES ********/
+    /************************************************************************/
+
+    // Un node_handle es dueño de un nodo que se sacó del árbol con extract.
+    // Permite cambiar el valor y volver a insertar el nodo (en éste o en otro
+    // árbol) sin liberar ni pedir memoria. Si se destruye sin reinsertarlo,
+    // libera el nodo.
+    class node_handle {
+    private:
+        node * m_node;
+
+        friend class rb_tree;
+
+        explicit node_handle(node * a_node) {
+            m_node = a_node;
+        }
+
+    public:
+        node_handle() {
+            m_node = nullptr;
+        }
+
+        node_handle(node_handle && x) {
+            m_node = x.m_node;
+            x.m_node = nullptr;
+        }
+
+        node_handle & operator=(node_handle && x) {
+            if (this != &x) {
+                delete m_node;
+                m_node = x.m_node;
+                x.m_node = nullptr;
+            }
+            return *this;
+        }
+
+        ~node_handle() {
+            delete m_node;
+        }
+
+        bool empty() const {
+            return m_node == nullptr;
+        }
+
+        explicit operator bool() const {
+            return !empty();
+        }
+
+        T & value() {
+            // Precondición: !empty()
+            return m_node->value;
+        }
+    };
+
+    // Devuelve un node_handle vacío si value no está en el árbol
+    node_handle extract(const T & value) {
+        iterator position = find(value);
+        if (position == end()) {
+            return node_handle();
+        }
+        return extract(position);
+    }
+
+    node_handle extract(iterator position) {
+        // Precondición: position != end()
+        unlink_node(position.m_current);
+        return node_handle(static_cast<node *>(position.m_current));
+    }
+
+    // Si el valor ya estaba, el nodo queda en handle y devuelve la posición
+    // del que ya estaba junto con false.
+    std::pair<iterator, bool> insert(node_handle && handle) {
+        if (handle.empty()) {
+            return { end(), false };
+        }
+        auto result = insert_node(handle.m_node);
+        if (result.second) {
+            handle.m_node = nullptr;
+        }
+        return result;
+    }
+
+    // Pasa a este árbol los nodos de other cuyos valores no están en éste
+    // (los demás quedan en other) sin liberar ni pedir memoria para nodos.
+    void merge(rb_tree & other) {
+        if (&other == this) {
+            return;
+        }
+        node_base * pending = other.m_header.left;
+        other.m_header.left = nullptr;
+        while (pending != nullptr) {
+            node_base * n = detach_preorder_first(pending);
+            if (!insert_node(n).second) {
+                other.insert_node(n);
+            }
+        }
+    }
+
+    /************************************************************************/
+    /************ OPERACIONES DE CONJUNTOS BASADAS EN JOIN Y SPLIT ***********/
+    /************************************************************************/
+
+    // Agrega al final de este árbol todos los valores de x, dejando a x vacío.
+    // Precondición: todos los valores de x son mayores a los de este árbol.
+    void join(rb_tree & x) {
+        int height;
+        set_root(do_join(m_header.left, black_height(m_header.left),
+                         x.m_header.left, black_height(x.m_header.left), height));
+        x.m_header.left = nullptr;
+    }
+
+    // Deja en este árbol los valores menores o iguales a value y devuelve un
+    // nuevo árbol con los mayores. Ambos quedan balanceados en O(log n).
+    rb_tree split(const T & value) {
+        rb_tree greater;
+        node_base * less;
+        node_base * greater_root;
+        int less_height;
+        int greater_height;
+        node_base * found = do_split(m_header.left, black_height(m_header.left), value,
+                                less, less_height, greater_root, greater_height);
+        if (found != nullptr) {
+            less = do_join(less, less_height, found, nullptr, 0, less_height);
+        }
+        set_root(less);
+        greater.set_root(greater_root);
+        return greater;
+    }
+
+    // Las siguientes operaciones consumen los nodos de x y realizan
+    // O(m log(n/m + 1)) trabajo (m es el tamaño del árbol más chico),
+    // repartiendo en paralelo los subárboles grandes entre los núcleos.
+
+    void set_union(rb_tree x) {
+        int height;
+        set_root(do_union(m_header.left, black_height(m_header.left),
+                          x.m_header.left, black_height(x.m_header.left), parallel_depth(), height));
+        x.m_header.left = nullptr;
+    }
+
+    void set_intersection(rb_tree x) {
+        int height;
+        set_root(do_intersection(m_header.left, black_height(m_header.left),
+                                 x.m_header.left, black_height(x.m_header.left), parallel_depth(), height));
+        x.m_header.left = nullptr;
+    }
+
+    void set_difference(rb_tree x) {
+        int height;
+        set_root(do_difference(m_header.left, black_height(m_header.left),
+                               x.m_header.left, black_height(x.m_header.left), parallel_depth(), height));
+        x.m_header.left = nullptr;
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Los recorridos usan una pila de tamaño fijo en lugar de recursión: la
+    // altura de un árbol rojinegro con n nodos es menor a 2 * log2(n + 1),
+    // así que max_height niveles alcanzan para cualquier árbol que entre en
+    // memoria. visit recibe cada nodo y devuelve false para interrumpir el
+    // recorrido.
+
+    static const int max_height = 128;
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        while (current != nullptr || size > 0) {
+            while (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            }
+            current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        if (m_header.left != nullptr) {
+            pending[size++] = m_header.left;
+        }
+        while (size > 0) {
+            node_base * current = pending[--size];
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending[size++] = current->right;
+            }
+            if (current->left != nullptr) {
+                pending[size++] = current->left;
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) {
+        node_base * pending[max_height];
+        int size = 0;
+        node_base * current = m_header.left;
+        node_base * last = nullptr;
+        while (current != nullptr || size > 0) {
+            if (current != nullptr) {
+                pending[size++] = current;
+                current = current->left;
+            } else {
+                node_base * top = pending[size - 1];
+                if (top->right != nullptr && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    --size;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Copia los nodos de other sin recursión ni pila: avanza en pre-orden
+    // sobre ambos árboles a la vez, subiendo por los enlaces a los padres.
+    void copy_nodes(const node_base * other) {
+        if (other == nullptr) {
+            return;
+        }
+        const node_base * other_root = other;
+        set_root(new node(value_of(other), nullptr, other->red));
+        node_base * current = m_header.left;
+        while (true) {
+            if (other->left != nullptr && current->left == nullptr) {
+                other = other->left;
+                current->left = new node(value_of(other), current, other->red);
+                current = current->left;
+            } else if (other->right != nullptr && current->right == nullptr) {
+                other = other->right;
+                current->right = new node(value_of(other), current, other->red);
+                current = current->right;
+            } else if (other != other_root) {
+                other = other->parent;
+                current = current->parent;
+            } else {
+                break;
+            }
+        }
+    }
+
+    // Devuelve el enlace donde está (o debería estar) value y deja en parent
+    // al nodo del que cuelga ese enlace.
+    node_base ** find_link(const T & value, node_base * & parent) {
+        node_base ** ptr = &m_header.left;
+        parent = &m_header;
+        while (*ptr != nullptr) {
+            if (value < value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->left;
+            } else if (value > value_of(*ptr)) {
+                parent = *ptr;
+                ptr = &parent->right;
+            } else {
+                break;
+            }
+        }
+        return ptr;
+    }
+
+    // Saca la raíz de pending, un árbol de nodos sueltos, y deja en pending
+    // el resto en el mismo preorden, colgando el subárbol derecho del último
+    // nodo en preorden del izquierdo. Los colores no importan: insert_node
+    // los vuelve a poner.
+    static node_base * detach_preorder_first(node_base * & pending) {
+        node_base * first = pending;
+        if (first->left == nullptr) {
+            pending = first->right;
+        } else {
+            pending = first->left;
+            if (first->right != nullptr) {
+                node_base * last = pending;
+                while (last->left != nullptr || last->right != nullptr) {
+                    last = last->right != nullptr ? last->right : last->left;
+                }
+                last->right = first->right;
+            }
+        }
+        return first;
+    }
+
+    // Engancha un nodo suelto como hoja, salvo que su valor ya esté
+    std::pair<iterator, bool> insert_node(node_base * n) {
+        node_base * parent;
+        node_base ** ptr = find_link(value_of(n), parent);
+        if (*ptr != nullptr) {
+            return { iterator(*ptr), false };
+        }
+        n->left = n->right = nullptr;
+        n->parent = parent;
+        n->red = true;
+        *ptr = n;
+        insert_fixup(n);
+        return { iterator(n), true };
+    }
+
+    void init_header() {
+        m_header.left = m_header.right = m_header.parent = nullptr;
+        m_header.red = false;
+    }
+
+    // La raíz siempre es negra
+    void set_root(node_base * root) {
+        m_header.left = root;
+        if (root != nullptr) {
+            root->parent = &m_header;
+            root->red = false;
+        }
+    }
+
+    // Devuelve el enlace que apunta a n (la raíz cuelga a la izquierda de la
+    // cabecera)
+    node_base * & link_to(node_base * n) {
+        return n->parent->left == n ? n->parent->left : n->parent->right;
+    }
+
+    static bool is_red(const node_base * a_node) {
+        return a_node != nullptr && a_node->red;
+    }
+
+    // Un nodo recién insertado es rojo, así que sólo puede romperse la regla
+    // de que un rojo no tenga hijos rojos. Si el tío también es rojo se pasa
+    // el rojo del padre y el tío al abuelo y se sigue desde él; si no, una o
+    // dos rotaciones lo arreglan y se termina. La cabecera es negra, así que
+    // el ciclo se detiene en la raíz.
+    void insert_fixup(node_base * n) {
+        while (is_red(n->parent)) {
+            node_base * parent = n->parent;
+            node_base * grandparent = parent->parent;
+            if (parent == grandparent->left) {
+                node_base * uncle = grandparent->right;
+                if (is_red(uncle)) {
+                    parent->red = uncle->red = false;
+                    grandparent->red = true;
+                    n = grandparent;
+                    continue;
+                }
+                if (n == parent->right) {
+                    rotate_left(grandparent->left);
+                    parent = n;
+                }
+                parent->red = false;
+                grandparent->red = true;
+                rotate_right(link_to(grandparent));
+            } else {
+                node_base * uncle = grandparent->left;
+                if (is_red(uncle)) {
+                    parent->red = uncle->red = false;
+                    grandparent->red = true;
+                    n = grandparent;
+                    continue;
+                }
+                if (n == parent->left) {
+                    rotate_right(grandparent->right);
+                    parent = n;
+                }
+                parent->red = false;
+                grandparent->red = true;
+                rotate_left(link_to(grandparent));
+            }
+            break;
+        }
+        m_header.left->red = false;
+    }
+
+    // Al quitar un nodo negro, el camino que pasa por n (que puede ser nulo)
+    // tiene un negro de menos. Si el hermano es negro y sus hijos también, se
+    // lo pinta de rojo y el faltante sube al padre; en los demás casos
+    // bastan una o dos rotaciones (tres si el hermano era rojo).
+    void erase_fixup(node_base * n, node_base * parent) {
+        while (n != m_header.left && !is_red(n)) {
+            if (n == parent->left) {
+                node_base * sibling = parent->right;
+                if (sibling->red) {
+                    sibling->red = false;
+                    parent->red = true;
+                    rotate_left(link_to(parent));
+                    sibling = parent->right;
+                }
+                if (!is_red(sibling->left) && !is_red(sibling->right)) {
+                    sibling->red = true;
+                    n = parent;
+                    parent = n->parent;
+                    continue;
+                }
+                if (!is_red(sibling->right)) {
+                    sibling->left->red = false;
+                    sibling->red = true;
+                    rotate_right(parent->right);
+                    sibling = parent->right;
+                }
+                sibling->red = parent->red;
+                parent->red = false;
+                sibling->right->red = false;
+                rotate_left(link_to(parent));
+            } else {
+                node_base * sibling = parent->left;
+                if (sibling->red) {
+                    sibling->red = false;
+                    parent->red = true;
+                    rotate_right(link_to(parent));
+                    sibling = parent->left;
+                }
+                if (!is_red(sibling->left) && !is_red(sibling->right)) {
+                    sibling->red = true;
+                    n = parent;
+                    parent = n->parent;
+                    continue;
+                }
+                if (!is_red(sibling->left)) {
+                    sibling->right->red = false;
+                    sibling->red = true;
+                    rotate_left(parent->left);
+                    sibling = parent->left;
+                }
+                sibling->red = parent->red;
+                parent->red = false;
+                sibling->left->red = false;
+                rotate_right(link_to(parent));
+            }
+            n = m_header.left;
+        }
+        if (n != nullptr) {
+            n->red = false;
+        }
+    }
+
+    void assign_parent(node_base * & n, node_base * p) {
+        if (n != nullptr) {
+            n->parent = p;
+        }
+    }
+
+    void rotate_left(node_base * & root) {
+        node_base * right_tree = root->right;
+        root->right = right_tree->left;
+        assign_parent(root->right, root);
+        right_tree->left = root;
+        right_tree->parent = root->parent;
+        root->parent = right_tree;
+        root = right_tree;
+    }
+
+    void rotate_right(node_base * & root) {
+        node_base * left_tree = root->left;
+        root->left = left_tree->right;
+        assign_parent(root->left, root);
+        left_tree->right = root;
+        left_tree->parent = root->parent;
+        root->parent = left_tree;
+        root = left_tree;
+    }
+
+    void erase_node(node_base * n) {
+        unlink_node(n);
+        delete static_cast<node *>(n);
+    }
+
+    // Desengancha a n del árbol (sin liberarlo) y rebalancea. Si tiene dos
+    // hijos, su predecesor (el máximo del subárbol izquierdo) ocupa su lugar
+    // y toma su color, así que el nodo que realmente desaparece de su
+    // posición es el predecesor.
+    void unlink_node(node_base * n) {
+        node_base * child;
+        node_base * child_parent;
+        bool removed_red;
+        if (n->left != nullptr && n->right != nullptr) {
+            node_base * max = n->left->find_maximum();
+            removed_red = max->red;
+            child = max->left;
+            if (max->parent == n) {
+                child_parent = max;
+            } else {
+                child_parent = max->parent;
+                link_to(max) = child;
+                assign_parent(child, child_parent);
+                max->left = n->left;
+                assign_parent(max->left, max);
+            }
+            max->right = n->right;
+            assign_parent(max->right, max);
+            max->parent = n->parent;
+            max->red = n->red;
+            link_to(n) = max;
+        } else {
+            child = n->left != nullptr ? n->left : n->right;
+            child_parent = n->parent;
+            removed_red = n->red;
+            link_to(n) = child;
+            assign_parent(child, child_parent);
+        }
+        if (!removed_red) {
+            erase_fixup(child, child_parent);
+        }
+    }
+
+    // Borra los nodos sin recursión ni pila: baja hasta una hoja, la borra y
+    // vuelve a su padre, que eventualmente se convierte también en hoja.
+    void do_clear(node_base * current) {
+        assign_parent(current, nullptr);
+        while (current != nullptr) {
+            if (current->left != nullptr) {
+                current = current->left;
+            } else if (current->right != nullptr) {
+                current = current->right;
+            } else {
+                node_base * parent = current->parent;
+                if (parent != nullptr) {
+                    if (parent->left == current) {
+                        parent->left = nullptr;
+                    } else {
+                        parent->right = nullptr;
+                    }
+                }
+                delete static_cast<node *>(current);
+                current = parent;
+            }
+        }
+    }
+
+    /************************************************************************/
+    /********* MÉTODOS AUXILIARES PARA LAS OPERACIONES DE CONJUNTOS *********/
+    /************************************************************************/
+
+    // Los siguientes métodos trabajan sobre subárboles sueltos: el puntero al
+    // padre de la raíz que devuelven queda sin definir y lo asigna quien llama.
+    // La raíz de un subárbol suelto puede ser roja. Cada subárbol viaja junto
+    // con su altura negra (la de sus hijos más uno si la raíz es negra), que
+    // se actualiza al bajar y al unir para no tener que recalcularla.
+
+    static int black_height(const node_base * root) {
+        int height = 0;
+        for (; root != nullptr; root = root->left) {
+            height += !root->red;
+        }
+        return height;
+    }
+
+    // Une left, middle y right (en ese orden) en un único árbol balanceado.
+    // Pinta de negro las raíces, baja por el borde del más alto hasta un nodo
+    // negro con la altura negra del otro y cuelga ahí a middle en rojo; si eso
+    // deja dos rojos seguidos, se arregla con una rotación al volver. Toma
+    // O(|left_height - right_height|) y deja en height la altura negra del
+    // resultado.
+    node_base * do_join(node_base * left, int left_height, node_base * middle,
+                   node_base * right, int right_height, int & height) {
+        if (is_red(left)) {
+            left->red = false;
+            ++left_height;
+        }
+        if (is_red(right)) {
+            right->red = false;
+            ++right_height;
+        }
+        node_base * root;
+        if (left_height > right_height) {
+            root = join_right(left, left_height, middle, right, right_height);
+        } else if (right_height > left_height) {
+            root = join_left(left, left_height, middle, right, right_height);
+        } else {
+            root = link(left, middle, right);
+        }
+        height = std::max(left_height, right_height);
+        if (root->red && (is_red(root->left) || is_red(root->right))) {
+            root->red = false;
+            ++height;
+        }
+        return root;
+    }
+
+    node_base * join_right(node_base * left, int left_height, node_base * middle, node_base * right, int right_height) {
+        if (!is_red(left) && left_height == right_height) {
+            return link(left, middle, right);
+        }
+        left->right = join_right(left->right, left_height - !left->red, middle, right, right_height);
+        left->right->parent = left;
+        if (!left->red && is_red(left->right) && is_red(left->right->right)) {
+            left->right->right->red = false;
+            rotate_left(left);
+        }
+        return left;
+    }
+
+    node_base * join_left(node_base * left, int left_height, node_base * middle, node_base * right, int right_height) {
+        if (!is_red(right) && left_height == right_height) {
+            return link(left, middle, right);
+        }
+        right->left = join_left(left, left_height, middle, right->left, right_height - !right->red);
+        right->left->parent = right;
+        if (!right->red && is_red(right->left) && is_red(right->left->left)) {
+            right->left->left->red = false;
+            rotate_right(right);
+        }
+        return right;
+    }
+
+    // Cuelga left y right (negros y de igual altura negra) de middle en rojo
+    node_base * link(node_base * left, node_base * middle, node_base * right) {
+        middle->left = left;
+        middle->right = right;
+        middle->red = true;
+        assign_parent(middle->left, middle);
+        assign_parent(middle->right, middle);
+        return middle;
+    }
+
+    node_base * do_join(node_base * left, int left_height, node_base * right, int right_height, int & height) {
+        if (left == nullptr) {
+            height = right_height;
+            return right;
+        }
+        node_base * less;
+        node_base * greater;
+        int less_height;
+        int greater_height;
+        node_base * maximum = do_split(left, left_height, value_of(left->find_maximum()),
+                                  less, less_height, greater, greater_height);
+        return do_join(less, less_height, maximum, right, right_height, height);
+    }
+
+    // Reparte los nodos de root (de altura negra height) entre less y greater.
+    // Devuelve el nodo que contenía a value (desenganchado del resto) o
+    // nullptr si no estaba.
+    node_base * do_split(node_base * root, int height, const T & value,
+                    node_base * & less, int & less_height, node_base * & greater, int & greater_height) {
+        if (root == nullptr) {
+            less = greater = nullptr;
+            less_height = greater_height = 0;
+            return nullptr;
+        }
+
+        node_base * left = root->left;
+        node_base * right = root->right;
+        int child_height = height - !root->red;
+        node_base * found;
+        if (value < value_of(root)) {
+            found = do_split(left, child_height, value, less, less_height, greater, greater_height);
+            greater = do_join(greater, greater_height, root, right, child_height, greater_height);
+        } else if (value > value_of(root)) {
+            found = do_split(right, child_height, value, less, less_height, greater, greater_height);
+            less = do_join(left, child_height, root, less, less_height, less_height);
+        } else {
+            root->left = root->right = nullptr;
+            less = left;
+            greater = right;
+            less_height = greater_height = child_height;
+            found = root;
+        }
+        return found;
+    }
+
+    node_base * do_union(node_base * a, int a_height, node_base * b, int b_height, int depth, int & height) {
+        if (a == nullptr) {
+            height = b_height;
+            return b;
+        }
+        if (b == nullptr) {
+            height = a_height;
+            return a;
+        }
+
+        bool parallel = depth > 0 && std::min(a_height, b_height) >= parallel_min_black_height;
+        node_base * a_less;
+        node_base * a_greater;
+        int a_less_height;
+        int a_greater_height;
+        delete static_cast<node *>(do_split(a, a_height, value_of(b), a_less, a_less_height,
+                                            a_greater, a_greater_height));
+
+        int b_child_height = b_height - !b->red;
+        node_base * less;
+        node_base * greater;
+        int less_height;
+        int greater_height;
+        fork_join(parallel,
+                  [&] { less = do_union(a_less, a_less_height, b->left, b_child_height,
+                                        depth - 1, less_height); },
+                  [&] { greater = do_union(a_greater, a_greater_height, b->right, b_child_height,
+                                           depth - 1, greater_height); });
+        return do_join(less, less_height, b, greater, greater_height, height);
+    }
+
+    node_base * do_intersection(node_base * a, int a_height, node_base * b, int b_height, int depth, int & height) {
+        if (a == nullptr || b == nullptr) {
+            do_clear(a);
+            do_clear(b);
+            height = 0;
+            return nullptr;
+        }
+
+        bool parallel = depth > 0 && std::min(a_height, b_height) >= parallel_min_black_height;
+        node_base * a_less;
+        node_base * a_greater;
+        int a_less_height;
+        int a_greater_height;
+        node_base * found = do_split(a, a_height, value_of(b), a_less, a_less_height, a_greater, a_greater_height);
+
+        int b_child_height = b_height - !b->red;
+        node_base * less;
+        node_base * greater;
+        int less_height;
+        int greater_height;
+        fork_join(parallel,
+                  [&] { less = do_intersection(a_less, a_less_height, b->left, b_child_height,
+                                               depth - 1, less_height); },
+                  [&] { greater = do_intersection(a_greater, a_greater_height, b->right, b_child_height,
+                                                  depth - 1, greater_height); });
+        if (found != nullptr) {
+            delete static_cast<node *>(found);
+            return do_join(less, less_height, b, greater, greater_height, height);
+        }
+        delete static_cast<node *>(b);
+        return do_join(less, less_height, greater, greater_height, height);
+    }
+
+    node_base * do_difference(node_base * a, int a_height, node_base * b, int b_height, int depth, int & height) {
+        if (a == nullptr || b == nullptr) {
+            do_clear(b);
+            height = a_height;
+            return a;
+        }
+
+        bool parallel = depth > 0 && std::min(a_height, b_height) >= parallel_min_black_height;
+        node_base * a_less;
+        node_base * a_greater;
+        int a_less_height;
+        int a_greater_height;
+        delete static_cast<node *>(do_split(a, a_height, value_of(b), a_less, a_less_height,
+                                            a_greater, a_greater_height));
+
+        int b_child_height = b_height - !b->red;
+        node_base * less;
+        node_base * greater;
+        int less_height;
+        int greater_height;
+        fork_join(parallel,
+                  [&] { less = do_difference(a_less, a_less_height, b->left, b_child_height,
+                                             depth - 1, less_height); },
+                  [&] { greater = do_difference(a_greater, a_greater_height, b->right, b_child_height,
+                                                depth - 1, greater_height); });
+        delete static_cast<node *>(b);
+        return do_join(less, less_height, greater, greater_height, height);
+    }
+
+    // Por debajo de esta altura negra (unos cientos de nodos) no conviene
+    // crear tareas: el costo de lanzarlas supera al trabajo que se reparte.
+    static const int parallel_min_black_height = 8;
+
+    // Cantidad de niveles de la recursión en los que se crean tareas nuevas:
+    // alcanza para ocupar todos los núcleos con algo de margen para las
+    // tareas que terminan antes.
+    static int parallel_depth() {
+        unsigned cores = std::thread::hardware_concurrency();
+        int depth = 2;
+        while (cores > 1) {
+            cores /= 2;
+            ++depth;
+        }
+        return depth;
+    }
+
+    // Ejecuta first en una tarea aparte y second en el hilo actual, esperando
+    // a que ambas terminen. Si no hay que (o no se puede) lanzar la tarea,
+    // las ejecuta una detrás de la otra.
+    template <typename F1, typename F2>
+    static void fork_join(bool parallel, F1 first, F2 second) {
+        if (parallel) {
+            std::future<void> task;
+            try {
+                task = std::async(std::launch::async, first);
+            } catch (const std::system_error &) {
+                parallel = false;
+            }
+            if (parallel) {
+                second();
+                task.get();
+                return;
+            }
+        }
+        first();
+        second();
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
+        if (current != nullptr) {
+            calculate_nodes_placement(current->left, x, h+1, placements);
+            placements.emplace_back(h, x++, current);
+            calculate_nodes_placement(current->right, x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_header.left, count, 0, placements);
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node_base * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << value_of(the_node);
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // RB_TREE_H
@@ -0,0 +1,122 @@
+#include "splay_tree.h"
+#include "../avl/avl.h"
+#include "../benchmark/measure.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+ostream & operator<<(ostream & out, splay_tree<T> & t) {
+    out << "splay_tree { ";
+    for (const auto & x : t) {
+        out << x << " ";
+    }
+    out << "}" << endl << t.str();
+    return out;
+}
+
+void show_int(int v) {
+    cout << v << ' ';
+}
+
+// Genera accesos a las claves 0..n-1: con s == 0 todas son igual de
+// probables y con s > 0 la i-ésima clave más usada tiene probabilidad
+// proporcional a 1 / i^s (Zipf). El orden de popularidad es al azar, así
+// que las claves más usadas quedan en cualquier lugar del árbol.
+vector<int> make_trace(int n, int count, double s, mt19937 & rng) {
+    vector<double> weights(n);
+    for (int i = 0; i < n; ++i) {
+        weights[i] = 1.0 / pow(i + 1.0, s);
+    }
+    vector<int> keys(n);
+    iota(keys.begin(), keys.end(), 0);
+    shuffle(keys.begin(), keys.end(), rng);
+
+    discrete_distribution<int> rank(weights.begin(), weights.end());
+    vector<int> trace(count);
+    for (auto & key : trace) {
+        key = keys[rank(rng)];
+    }
+    return trace;
+}
+
+template <typename Tree>
+long lookups(Tree & t, const vector<int> & trace) {
+    long found = 0;
+    for (int key : trace) {
+        found += t.find(key) != t.end();
+    }
+    return found;
+}
+
+int main() {
+    cout << ":: Creando t1 e insertando 1..9 en orden." << endl;
+    splay_tree<int> t1;
+    for (int x = 1; x <= 9; ++x) {
+        t1.insert(x);
+    }
+    cout << "  t1 = " << t1 << endl;
+
+    for (int x : {1, 5, 42}) {
+        cout << ":: Busco a " << x << " en t1: ";
+        auto p = t1.find(x);
+        if (p != t1.end()) {
+            cout << "lo encontré y quedó en la raíz." << endl;
+        } else {
+            cout << "no está; quedó en la raíz el último nodo visitado." << endl;
+        }
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
+    cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+    cout << ":: Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << *p << " ";
+    }
+    cout << endl;
+
+    cout << ":: Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "  ¿t1 == t2? " << boolalpha << (t1 == t2) << endl;
+
+    for (int x : {4, 9, 42}) {
+        cout << ":: Borrando un " << x << " en t1 => " << t1.erase(x).first << endl;
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << ":: Recorriendo t2 con each():" << endl;
+    cout << "  t2 = splay_tree { ";
+    t2.each(show_int);
+    cout << "}" << endl << endl;
+
+    const int n = 100000;
+    const int count = 2000000;
+    mt19937 rng(42);
+    vector<int> keys(n);
+    iota(keys.begin(), keys.end(), 0);
+    shuffle(keys.begin(), keys.end(), rng);
+
+    splay_tree<int> splay;
+    tree<int> avl;
+    for (int key : keys) {
+        splay.insert(key);
+        avl.insert(key);
+    }
+
+    cout << ":: Comparando con el árbol AVL (" << n << " claves, " << count << " búsquedas):" << endl;
+    for (double s : {0.0, 0.99}) {
+        vector<int> trace = make_trace(n, count, s, rng);
+        long found = 0;
+        double splay_time = measure([&] { found += lookups(splay, trace); });
+        double avl_time = measure([&] { found -= lookups(avl, trace); });
+        cout << "  " << (s == 0 ? "uniforme:   " : "Zipf(0.99): ") << "árbol biselado " << splay_time
+             << " s, árbol AVL " << avl_time << " s - ¿mismos resultados? " << (found == 0) << endl;
+    }
+}
@@ -0,0 +1,617 @@
+#ifndef SPLAY_TREE_H
+#define SPLAY_TREE_H
+
+#include <cstddef>    // Para std::size_t
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <stack>      // Para std::stack
+#include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/************ Árbol biselado (splay tree) con biselado de arriba hacia abajo ********/
+/************************************************************************************/
+
+// Cada búsqueda, inserción o borrado "bisela" el árbol: con rotaciones hace
+// subir hasta la raíz al nodo buscado (o al último visitado si no estaba).
+// No garantiza altura logarítmica, pero el costo amortizado de cada operación
+// es O(log n) y las claves que se usan seguido quedan cerca de la raíz, así
+// que con accesos muy desparejos (por ejemplo, con distribución Zipf) se
+// visitan menos nodos que en un árbol AVL.
+//
+// El biselado se hace de arriba hacia abajo en una sola pasada: mientras
+// se baja, los nodos menores que value se van colgando de un árbol izquierdo
+// y los mayores de uno derecho, y al final se rearman alrededor del nodo
+// encontrado. Como find modifica al árbol, no es const.
+
+template <typename T>
+class splay_tree {
+private:
+    // Los enlaces de un nodo; node agrega el valor y m_root tiene sólo esto
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        node_base * parent;
+
+        node_base * find_minimum() {
+            // Pre-condición: this != nullptr
+            node_base * current = this;
+            while (current->left != nullptr) {
+                current = current->left;
+            }
+            return current;
+        }
+
+        node_base * find_maximum() {
+            // Pre-condición: this != nullptr
+            node_base * current = this;
+            while (current->right != nullptr) {
+                current = current->right;
+            }
+            return current;
+        }
+    };
+
+    struct node : node_base {
+        T value;
+
+        node(const T & a_value, node_base * a_parent) : value(a_value) {
+            this->left = this->right = nullptr;
+            this->parent = a_parent;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // m_root no guarda ningún valor: hace de nodo cabecera, del que cuelga
+    // la raíz por la izquierda, y es la posición de end(). Mientras se
+    // bisela también sostiene a los árboles izquierdo y derecho. Como no
+    // tiene valor, T no necesita poder construirse por defecto.
+    node_base m_root;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    splay_tree() {
+        m_root.left = m_root.right = m_root.parent = nullptr;
+    }
+
+    splay_tree(splay_tree & x) {
+        m_root.left = m_root.right = m_root.parent = nullptr;
+        if (x.m_root.left != nullptr) {
+            copy_nodes(x.m_root);
+        }
+    }
+
+    ~splay_tree() {
+        clear();
+    }
+
+    splay_tree & operator=(splay_tree x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    friend
+    void swap(splay_tree & x, splay_tree & y) {
+        using namespace std;
+        swap(x.m_root, y.m_root);
+        x.assign_parent(x.m_root.left, &x.m_root);
+        y.assign_parent(y.m_root.left, &y.m_root);
+    }
+
+    /************************************************************************/
+    /***** ITERADOR LIVIANO BIDIRECCIONAL QUE RECORRE AL ÁRBOL EN ORDEN *****/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        node_base * m_current;
+
+        friend class splay_tree;
+
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(node_base * current = nullptr) {
+            m_current = current;
+        }
+
+        reference operator*() {
+            // Precondición: m_current != end()
+            return value_of(m_current);
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        iterator & operator++() {
+            // Precondición: m_current != end()
+            if (m_current->right != nullptr) {
+                m_current = m_current->right->find_minimum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->right == prev);
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        iterator & operator--() {
+            // Precondición: m_current != begin()
+            if (m_current->left != nullptr) {
+                m_current = m_current->left->find_maximum();
+            } else {
+                node_base * prev;
+                do {
+                    prev = m_current;
+                    m_current = m_current->parent;
+                } while (m_current->left == prev);
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            --*this;
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        return iterator(m_root.find_minimum());
+    }
+
+    iterator end() {
+        return iterator(&m_root);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_root.left == nullptr;
+    }
+
+    friend
+    bool operator==(splay_tree & x, splay_tree & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(splay_tree & x, splay_tree & y) {
+        return !(x == y);
+    }
+
+    iterator find(const T & value) {
+        if (empty() || !splay(value)) {
+            return end();
+        }
+        return iterator(m_root.left);
+    }
+
+    bool contains(const T & value) {
+        return find(value) != end();
+    }
+
+    iterator minimum() {
+        if (m_root.left == nullptr)
+            return end();
+        return m_root.left->find_minimum();
+    }
+
+    iterator maximum() {
+        if (m_root.left == nullptr)
+            return end();
+        return m_root.left->find_maximum();
+    }
+
+    // A diferencia de find, los recorridos no biselan: visitan los nodos sin
+    // cambiar la forma del árbol.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    // Después de biselar, la raíz es el vecino de value: el nodo nuevo pasa
+    // a ser la raíz y la vieja raíz queda de un lado con el subárbol que le
+    // corresponde, mientras que el otro subárbol pasa al nodo nuevo. Sólo se
+    // reserva memoria cuando el valor no estaba.
+    iterator insert(const T & value) {
+        if (!empty() && splay(value)) {
+            return iterator(m_root.left);
+        }
+        node_base * n = new node(value, nullptr);
+        if (!empty()) {
+            node_base * root = m_root.left;
+            if (value < value_of(root)) {
+                n->left = root->left;
+                n->right = root;
+                root->left = nullptr;
+            } else {
+                n->right = root->right;
+                n->left = root;
+                root->right = nullptr;
+            }
+            assign_parent(n->left, n);
+            assign_parent(n->right, n);
+        }
+        set_root(n);
+        return iterator(n);
+    }
+
+    // Después de biselar, value está en la raíz. Biselando su subárbol
+    // izquierdo con value (que es mayor a todo lo que hay en él) sube el
+    // máximo, que no tiene hijo derecho y puede tomar al subárbol derecho.
+    std::pair<bool, iterator> erase(const T & value) {
+        if (empty() || !splay(value)) {
+            return { false, end() };
+        }
+        node_base * removed = m_root.left;
+        iterator next = ++iterator(removed);
+        if (removed->left == nullptr) {
+            set_root(removed->right);
+        } else {
+            set_root(removed->left);
+            splay(value);
+            m_root.left->right = removed->right;
+            assign_parent(removed->right, m_root.left);
+        }
+        delete static_cast<node *>(removed);
+        return { true, next };
+    }
+
+    void clear() {
+        if (m_root.left == nullptr) {
+            return;
+        }
+        std::stack<node_base *> nodes;
+        nodes.push(m_root.left);
+        m_root.left = nullptr;
+        while (!nodes.empty()) {
+            node_base * current = nodes.top();
+            nodes.pop();
+            if (current->left != nullptr) {
+                nodes.push(current->left);
+            }
+            if (current->right != nullptr) {
+                nodes.push(current->right);
+            }
+            delete static_cast<node *>(current);
+        }
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    // Los recorridos usan una pila explícita en lugar de recursión (que, a
+    // diferencia de los enlaces a los padres, visita cada nodo una sola vez).
+    // visit recibe cada nodo y devuelve false para interrumpir el recorrido.
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = m_root.left;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            }
+            current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            current = current->right;
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_preorder(F visit) {
+        std::vector<node_base *> pending;
+        if (m_root.left != nullptr) {
+            pending.push_back(m_root.left);
+        }
+        while (!pending.empty()) {
+            node_base * current = pending.back();
+            pending.pop_back();
+            if (!visit(current)) {
+                return false;
+            }
+            if (current->right != nullptr) {
+                pending.push_back(current->right);
+            }
+            if (current->left != nullptr) {
+                pending.push_back(current->left);
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = m_root.left;
+        node_base * last = nullptr;
+        while (current != nullptr || !pending.empty()) {
+            if (current != nullptr) {
+                pending.push_back(current);
+                current = current->left;
+            } else {
+                node_base * top = pending.back();
+                if (top->right != nullptr && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    pending.pop_back();
+                }
+            }
+        }
+        return true;
+    }
+
+    void copy_nodes(node_base & root) {
+        struct info {
+            node_base * from;
+            node_base * & to;
+            node_base * parent;
+        };
+        std::stack<info> nodes;
+        nodes.push({ root.left, m_root.left, &m_root });
+        while (!nodes.empty()) {
+            auto data = nodes.top();
+            nodes.pop();
+            data.to = new node(value_of(data.from), data.parent);
+            if (data.from->left != nullptr) {
+                nodes.push({ data.from->left, data.to->left, data.to });
+            }
+            if (data.from->right != nullptr) {
+                nodes.push({ data.from->right, data.to->right, data.to });
+            }
+        }
+    }
+
+    void set_root(node_base * root) {
+        m_root.left = root;
+        assign_parent(root, &m_root);
+    }
+
+    // Bisela de arriba hacia abajo buscando value y devuelve si lo encontró.
+    // Los árboles izquierdo y derecho que se van armando cuelgan de m_root
+    // (el derecho de m_root.left y el izquierdo de m_root.right): left_max es
+    // el máximo del izquierdo, del que se engancha por la derecha lo que se
+    // agrega, y right_min es el mínimo del derecho. Los padres que quedan
+    // apuntando a m_root se corrigen al rearmar.
+    // Precondición: !empty()
+    bool splay(const T & value) {
+        node_base * current = m_root.left;
+        m_root.left = m_root.right = nullptr;
+        node_base * left_max = &m_root;
+        node_base * right_min = &m_root;
+        while (true) {
+            if (value < value_of(current)) {
+                if (current->left == nullptr)
+                    break;
+                if (value < value_of(current->left)) {
+                    current = rotate_right(current);
+                    if (current->left == nullptr)
+                        break;
+                }
+                right_min->left = current;
+                current->parent = right_min;
+                right_min = current;
+                current = current->left;
+            } else if (value > value_of(current)) {
+                if (current->right == nullptr)
+                    break;
+                if (value > value_of(current->right)) {
+                    current = rotate_left(current);
+                    if (current->right == nullptr)
+                        break;
+                }
+                left_max->right = current;
+                current->parent = left_max;
+                left_max = current;
+                current = current->right;
+            } else {
+                break;
+            }
+        }
+
+        left_max->right = current->left;
+        assign_parent(current->left, left_max);
+        right_min->left = current->right;
+        assign_parent(current->right, right_min);
+        current->left = m_root.right;
+        assign_parent(current->left, current);
+        current->right = m_root.left;
+        assign_parent(current->right, current);
+        m_root.right = nullptr;
+        set_root(current);
+        return !(value < value_of(current)) && !(value > value_of(current));
+    }
+
+    // Las rotaciones devuelven la nueva raíz del subárbol, sin ajustar su padre
+    node_base * rotate_right(node_base * n) {
+        node_base * child = n->left;
+        n->left = child->right;
+        assign_parent(n->left, n);
+        child->right = n;
+        n->parent = child;
+        return child;
+    }
+
+    node_base * rotate_left(node_base * n) {
+        node_base * child = n->right;
+        n->right = child->left;
+        assign_parent(n->right, n);
+        child->left = n;
+        n->parent = child;
+        return child;
+    }
+
+    void assign_parent(node_base * & n, node_base * parent) {
+        if (n != nullptr) {
+            n->parent = parent;
+        }
+    }
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
+
+    // Calcula la posición de los nodos para poder mostrarlos en pantalla
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
+        if (current != nullptr) {
+            calculate_nodes_placement(current->left, x, h+1, placements);
+            placements.emplace_back(h, x++, current);
+            calculate_nodes_placement(current->right, x, h+1, placements);
+        }
+    }
+
+public:
+
+    // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+    std::string str() const {
+        int count = 0;
+        nodes_placement placements;
+        calculate_nodes_placement(m_root.left, count, 0, placements);
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node_base * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << value_of(the_node);
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // SPLAY_TREE_H
@@ -0,0 +1,175 @@
+#include "threaded_tree.h"
+#include "../iterative-BST-fat-iterator/tree.h"
+#include "../benchmark/measure.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+ostream & operator<<(ostream & out, threaded_tree<T> & t) {
+    out << "threaded_tree { ";
+    for (const auto & x : t) {
+        out << x << " ";
+    }
+    out << "}" << endl << t.str();
+    return out;
+}
+
+void show_int(int v) {
+    cout << v << ' ';
+}
+
+// Recorre todo el árbol varias veces con un for por rango
+template <typename Tree>
+long full_scans(Tree & t, int times) {
+    long sum = 0;
+    for (int i = 0; i < times; ++i) {
+        for (int x : t) {
+            sum += x;
+        }
+    }
+    return sum;
+}
+
+// Recorre el árbol de atrás para adelante con rbegin y rend (std::reverse_iterator
+// copia el iterador en cada acceso)
+template <typename Tree>
+long reverse_scans(Tree & t, int times) {
+    long sum = 0;
+    for (int i = 0; i < times; ++i) {
+        for (auto p = t.rbegin(); p != t.rend(); ++p) {
+            sum += *p;
+        }
+    }
+    return sum;
+}
+
+// Busca cada clave y avanza length posiciones usando el post-incremento
+template <typename Tree>
+long range_scans(Tree & t, const vector<int> & keys, int length) {
+    long sum = 0;
+    for (int key : keys) {
+        auto p = t.find(key);
+        for (int i = 0; i < length && p != t.end(); ++i) {
+            sum += *p++;
+        }
+    }
+    return sum;
+}
+
+int main() {
+    cout << ":: Creando t1 vacío." << endl;
+    threaded_tree<int> t1;
+    cout << "  t1 = " << t1 << endl;
+
+    for (int x : {10, 8, 4, 1, 5, 12, 21, 14, 17}) {
+        cout << ":: Insertando " << x << " en t1 " << endl;
+        t1.insert(x);
+    }
+    cout << "  t1 = " << t1 << endl;
+
+    cout << ":: Creando t2 como copia de t1:" << endl;
+    auto t2 = t1;
+    cout << "  t2 = " << t2 << endl;
+
+    cout << ":: Haciendo más inserciones en t1: 2, 13, 2" << endl;
+    t1.insert(2);
+    t1.insert(13);
+    t1.insert(2);
+    cout << "  t1 = " << t1 << endl;
+    cout << ":: ¿t1 == t2? " << boolalpha << (t1 == t2) << endl;
+
+    for (int x : {4, 17, 0}) {
+        cout << ":: Busco a " << x << " en t1: " << endl;
+        auto p = t1.find(x);
+        if (p != end(t1)) {
+            cout << "  Lo encontré! El valor es " << *p;
+            ++p;
+            cout << " y el siguiente es " << *p << endl;
+        } else {
+            cout << "  No encontré el valor buscado." << endl;
+        }
+    }
+
+    cout << ":: Mínimo de t1 => " << *t1.minimum() << endl;
+    cout << ":: Máximo de t1 => " << *t1.maximum() << endl;
+    cout << ":: Recorriendo t1 al revés => ";
+    for (auto p = t1.rbegin(); p != t1.rend(); ++p) {
+        cout << *p << " ";
+    }
+    cout << endl;
+
+    cout << ":: Recorriendo t1 en pre-orden => ";
+    t1.each_preorder(show_int);
+    cout << endl;
+    cout << ":: Recorriendo t1 en post-orden => ";
+    t1.each_postorder(show_int);
+    cout << endl;
+
+    for (int x : {8, 12, 4, 10, 42}) {
+        cout << ":: Borrando un " << x << " en t1 => " << t1.erase(x).first << endl;
+        cout << "  t1 = " << t1 << endl;
+    }
+
+    cout << ":: Asignando t2 = t1 y vaciando t1:" << endl;
+    t2 = t1;
+    t1.clear();
+    cout << "  t1 = " << t1 << " - ¿t1 está vacio? " << t1.empty() << endl;
+    cout << "  t2 = " << t2 << " - ¿t2 está vacio? " << t2.empty() << endl;
+
+    const int n = 200000;
+    const int times = 20;
+    const int scans = 1000000;
+    const int length = 16;
+    cout << ":: Comparando con el árbol de iterador pesado (" << n << " claves al azar)" << endl;
+    cout << "  tamaño del iterador: enhebrado " << sizeof(threaded_tree<int>::iterator)
+         << " bytes, pesado " << sizeof(tree<int>::iterator) << " bytes (más la pila en el heap)" << endl;
+
+    mt19937 rng(42);
+    threaded_tree<int> threaded;
+    tree<int> fat;
+    for (int i = 0; i < n; ++i) {
+        int key = int(rng() % (4 * n));
+        threaded.insert(key);
+        fat.insert(key);
+    }
+    vector<int> keys(scans);
+    for (auto & key : keys) {
+        key = int(rng() % (4 * n));
+    }
+
+    const int small_n = 1000;
+    const int small_times = 4000;
+    threaded_tree<int> small_threaded;
+    tree<int> small_fat;
+    for (int i = 0; i < small_n; ++i) {
+        int key = int(rng() % (4 * small_n));
+        small_threaded.insert(key);
+        small_fat.insert(key);
+    }
+
+    long threaded_sum = 0;
+    long fat_sum = 0;
+    double threaded_small = measure([&] { threaded_sum += full_scans(small_threaded, small_times); });
+    double fat_small = measure([&] { fat_sum += full_scans(small_fat, small_times); });
+    double threaded_full = measure([&] { threaded_sum += full_scans(threaded, times); });
+    double fat_full = measure([&] { fat_sum += full_scans(fat, times); });
+    double threaded_reverse = measure([&] { threaded_sum += reverse_scans(threaded, times); });
+    double fat_reverse = measure([&] { fat_sum += reverse_scans(fat, times); });
+    double threaded_range = measure([&] { threaded_sum += range_scans(threaded, keys, length); });
+    double fat_range = measure([&] { fat_sum += range_scans(fat, keys, length); });
+
+    cout << "  " << small_times << " recorridos de un árbol de " << small_n << " claves: enhebrado " << threaded_small
+         << " s, pesado " << fat_small << " s" << endl;
+    cout << "  " << times << " recorridos completos:     enhebrado " << threaded_full
+         << " s, pesado " << fat_full << " s" << endl;
+    cout << "  " << times << " recorridos con rbegin:    enhebrado " << threaded_reverse
+         << " s, pesado " << fat_reverse << " s" << endl;
+    cout << "  " << scans << " find + " << length << " x p++:  enhebrado " << threaded_range
+         << " s, pesado " << fat_range << " s" << endl;
+    cout << "  ¿mismos resultados? " << boolalpha << (threaded_sum == fat_sum) << endl;
+}
@@ -0,0 +1,647 @@
+#ifndef THREADED_TREE_H
+#define THREADED_TREE_H
+
+#include <cstddef>    // Para std::size_t
+#include <iterator>   // Para std::bidirectional_iterator_tag y std::reverse_iterator
+#include <stack>      // Para std::stack
+#include <utility>    // Para std::pair y std::swap
+#include <vector>     // Para std::vector
+
+/************************************************************************************/
+/*** Funcionalidad adicional no estrictamente necesaria para implementar el árbol ***/
+/************************************************************************************/
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+/************************************************************************************/
+/****** Árbol Binario de Búsqueda enhebrado con iterador liviano y sin pila *********/
+/************************************************************************************/
+
+// En un árbol enhebrado los enlaces a hijos que serían nulos se aprovechan
+// como "hilos": el izquierdo apunta al anterior en orden y el derecho al
+// siguiente. Una marca en cada nodo indica si el enlace es a un hijo o es un
+// hilo. Así el iterador puede avanzar y retroceder guardando sólo un puntero,
+// sin enlaces a los padres (como iterative-BST-light-iterator) y sin una pila
+// de ancestros (como iterative-BST-fat-iterator): copiarlo es copiar un
+// puntero y recorrer el árbol no pide memoria.
+//
+// A cambio, al subir hay que leer el hilo del nodo actual para saber a qué
+// nodo ir, mientras que el iterador pesado ya tiene esa dirección en su pila
+// y el procesador puede pedirla antes. Por eso un recorrido completo que no
+// copia el iterador puede ser algo más lento que con el iterador pesado.
+
+template <typename T>
+class threaded_tree {
+private:
+    // Los enlaces de un nodo; node agrega el valor y m_root tiene sólo esto
+    struct node_base {
+        node_base * left;
+        node_base * right;
+        bool left_thread;   // left apunta al anterior en orden, no a un hijo
+        bool right_thread;  // right apunta al siguiente en orden, no a un hijo
+
+        node_base * find_minimum() {
+            node_base * current = this;
+            while (!current->left_thread) {
+                current = current->left;
+            }
+            return current;
+        }
+
+        node_base * find_maximum() {
+            node_base * current = this;
+            while (!current->right_thread) {
+                current = current->right;
+            }
+            return current;
+        }
+    };
+
+    struct node : node_base {
+        T value;
+
+        node(const T & a_value, bool a_left_thread, bool a_right_thread) : value(a_value) {
+            this->left = this->right = nullptr;
+            this->left_thread = a_left_thread;
+            this->right_thread = a_right_thread;
+        }
+    };
+
+    static T & value_of(node_base * n) {
+        return static_cast<node *>(n)->value;
+    }
+
+    static const T & value_of(const node_base * n) {
+        return static_cast<const node *>(n)->value;
+    }
+
+    // m_root no guarda ningún valor: hace de nodo cabecera, del que cuelga
+    // la raíz por la izquierda. Los hilos del mínimo y del máximo apuntan a
+    // él, que es también la posición de end(). Como no tiene valor, T no
+    // necesita poder construirse por defecto.
+    node_base m_root;
+
+public:
+
+    /************************************************************************/
+    /************* CONSTRUCTORES, DESTRUCTOR, ASIGNACIÓN Y SWAP *************/
+    /************************************************************************/
+
+    threaded_tree() {
+        init_root();
+    }
+
+    threaded_tree(threaded_tree & x) {
+        init_root();
+        if (!x.empty()) {
+            copy_nodes(x.m_root.left);
+        }
+    }
+
+    ~threaded_tree() {
+        clear();
+    }
+
+    threaded_tree & operator=(threaded_tree x) {
+        swap(*this, x);
+        return *this;
+    }
+
+    // Además de intercambiar las raíces hay que redirigir los hilos del
+    // mínimo y del máximo, que apuntan a la cabecera de cada árbol.
+    friend
+    void swap(threaded_tree & x, threaded_tree & y) {
+        using namespace std;
+        swap(x.m_root.left, y.m_root.left);
+        swap(x.m_root.left_thread, y.m_root.left_thread);
+        x.fix_end_threads();
+        y.fix_end_threads();
+    }
+
+    /************************************************************************/
+    /******** ITERADOR LIVIANO BIDIRECCIONAL QUE SIGUE LOS HILOS ************/
+    /************************************************************************/
+
+    class iterator {
+    private:
+        node_base * m_current;
+
+        friend class threaded_tree;
+
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+        using difference_type = std::size_t;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        iterator(node_base * current = nullptr) {
+            m_current = current;
+        }
+
+        reference operator*() {
+            // Precondición: *this != end()
+            return value_of(m_current);
+        }
+
+        pointer operator->() {
+            return &operator*();
+        }
+
+        friend
+        bool operator==(const iterator & x, const iterator & y) {
+            return x.m_current == y.m_current;
+        }
+
+        friend
+        bool operator!=(const iterator & x, const iterator & y) {
+            return !(x == y);
+        }
+
+        // El siguiente es el mínimo del hijo derecho o, si no hay hijo
+        // derecho, el nodo al que apunta el hilo.
+        iterator & operator++() {
+            // Precondición: *this != end()
+            if (m_current->right_thread) {
+                m_current = m_current->right;
+            } else {
+                m_current = m_current->right->find_minimum();
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto tmp = *this;
+            operator++();
+            return tmp;
+        }
+
+        iterator & operator--() {
+            // Precondición: *this != begin()
+            if (m_current->left_thread) {
+                m_current = m_current->left;
+            } else {
+                m_current = m_current->left->find_maximum();
+            }
+            return *this;
+        }
+
+        iterator operator--(int) {
+            auto tmp = *this;
+            operator--();
+            return tmp;
+        }
+    };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    iterator begin() {
+        return iterator(m_root.find_minimum());
+    }
+
+    iterator end() {
+        return iterator(&m_root);
+    }
+
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+
+    /************************************************************************/
+    /******* MÉTODOS QUE PERMITEN CONSULTAR AL ÁRBOL SIN MODIFICARLO ********/
+    /************************************************************************/
+
+    bool empty() {
+        return m_root.left_thread;
+    }
+
+    friend
+    bool operator==(threaded_tree & x, threaded_tree & y) {
+        auto i = x.begin();
+        auto j = y.begin();
+        while (i != x.end() && j != y.end()) {
+            if (*i != *j)
+                return false;
+            ++i;
+            ++j;
+        }
+        return i == x.end() && j == y.end();
+    }
+
+    friend
+    bool operator!=(threaded_tree & x, threaded_tree & y) {
+        return !(x == y);
+    }
+
+    iterator find(const T & value) {
+        node_base * parent;
+        node_base * n = find_node(value, parent);
+        if (n == nullptr) {
+            return end();
+        }
+        return iterator(n);
+    }
+
+    bool contains(const T & value) {
+        return find(value) != end();
+    }
+
+    iterator minimum() {
+        return begin();
+    }
+
+    iterator maximum() {
+        if (empty())
+            return end();
+        return iterator(m_root.left->find_maximum());
+    }
+
+    // each y each_preorder siguen los hilos, así que no usan pila ni memoria
+    // adicional.
+
+    template <typename F>
+    void each(F func) {
+        visit_in_order([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    // Como each, pero se detiene en cuanto func devuelve false. Devuelve true
+    // si llegó a recorrer todo el árbol.
+    template <typename F>
+    bool each_while(F func) {
+        return visit_in_order([&](const node_base * n) { return bool(func(value_of(n))); });
+    }
+
+    template <typename F>
+    void each_preorder(F func) {
+        visit_preorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    template <typename F>
+    void each_postorder(F func) {
+        visit_postorder([&](const node_base * n) { func(value_of(n)); return true; });
+    }
+
+    /************************************************************************/
+    /******************* MÉTODOS QUE MODIFICAN AL ÁRBOL *********************/
+    /************************************************************************/
+
+    // El nodo nuevo es una hoja que hereda el hilo que tenía su padre de ese
+    // lado y pasa a ser el destino del hilo del otro lado.
+    iterator insert(const T & value) {
+        node_base * parent = &m_root;
+        bool to_left = true;
+        while (!(to_left ? parent->left_thread : parent->right_thread)) {
+            node_base * current = to_left ? parent->left : parent->right;
+            if (value < value_of(current)) {
+                to_left = true;
+            } else if (value > value_of(current)) {
+                to_left = false;
+            } else {
+                return iterator(current);
+            }
+            parent = current;
+        }
+
+        node_base * n = new node(value, true, true);
+        if (to_left) {
+            n->left = parent->left;
+            n->right = parent;
+            parent->left = n;
+            parent->left_thread = false;
+        } else {
+            n->left = parent;
+            n->right = parent->right;
+            parent->right = n;
+            parent->right_thread = false;
+        }
+        return iterator(n);
+    }
+
+    // Si el nodo tiene dos hijos se desengancha a su sucesor, que no tiene
+    // hijo izquierdo, y se lo pone en el lugar del nodo borrado. Los valores
+    // no se mueven, así que los iteradores a otros nodos siguen siendo
+    // válidos.
+    std::pair<bool, iterator> erase(const T & value) {
+        node_base * parent;
+        node_base * n = find_node(value, parent);
+        if (n == nullptr) {
+            return { false, end() };
+        }
+        if (!n->left_thread && !n->right_thread) {
+            node_base * next_parent = n;
+            node_base * next = n->right;
+            while (!next->left_thread) {
+                next_parent = next;
+                next = next->left;
+            }
+            unlink_node(next, next_parent);
+            replace_node(n, next, parent);
+            delete static_cast<node *>(n);
+            return { true, iterator(next) };
+        }
+        iterator next = ++iterator(n);
+        unlink_node(n, parent);
+        delete static_cast<node *>(n);
+        return { true, next };
+    }
+
+    // Se recorre en orden siguiendo los hilos y cada nodo se libera después
+    // de pasar al siguiente, que nunca es uno ya visitado.
+    void clear() {
+        node_base * current = m_root.find_minimum();
+        while (current != &m_root) {
+            node_base * next = (++iterator(current)).m_current;
+            delete static_cast<node *>(current);
+            current = next;
+        }
+        init_root();
+    }
+
+private:
+
+    /************************************************************************/
+    /************** MÉTODOS AUXILIARES PARA LA IMPLEMENTACIÓN ***************/
+    /************************************************************************/
+
+    void init_root() {
+        m_root.left = m_root.right = &m_root;
+        m_root.left_thread = m_root.right_thread = true;
+    }
+
+    // Hace que los hilos del mínimo y del máximo apunten a la cabecera
+    void fix_end_threads() {
+        if (empty()) {
+            m_root.left = &m_root;
+        } else {
+            m_root.left->find_minimum()->left = &m_root;
+            m_root.left->find_maximum()->right = &m_root;
+        }
+    }
+
+    // Devuelve el nodo que tiene a value (o nullptr si no está), dejando en
+    // parent a su padre (la cabecera, si es la raíz).
+    node_base * find_node(const T & value, node_base * & parent) {
+        parent = &m_root;
+        if (m_root.left_thread) {
+            return nullptr;
+        }
+        node_base * current = m_root.left;
+        while (true) {
+            if (value < value_of(current)) {
+                if (current->left_thread)
+                    return nullptr;
+                parent = current;
+                current = current->left;
+            } else if (value > value_of(current)) {
+                if (current->right_thread)
+                    return nullptr;
+                parent = current;
+                current = current->right;
+            } else {
+                return current;
+            }
+        }
+    }
+
+    // Desengancha de parent (sin liberarlo) a n, que tiene a lo sumo un hijo.
+    // Si lo tiene, el hilo del subárbol que apuntaba a n se redirige al vecino
+    // de n del otro lado.
+    void unlink_node(node_base * n, node_base * parent) {
+        node_base * child = nullptr;
+        if (!n->left_thread) {
+            child = n->left;
+            child->find_maximum()->right = n->right;
+        } else if (!n->right_thread) {
+            child = n->right;
+            child->find_minimum()->left = n->left;
+        }
+
+        if (!parent->left_thread && parent->left == n) {
+            if (child != nullptr) {
+                parent->left = child;
+            } else {
+                parent->left = n->left;
+                parent->left_thread = true;
+            }
+        } else {
+            if (child != nullptr) {
+                parent->right = child;
+            } else {
+                parent->right = n->right;
+                parent->right_thread = true;
+            }
+        }
+    }
+
+    // Pone a other, que está suelto, en el lugar de n, que tiene hijo
+    // izquierdo. Los únicos hilos que pueden apuntar a n son el derecho de su
+    // anterior y el izquierdo de su siguiente.
+    void replace_node(node_base * n, node_base * other, node_base * parent) {
+        other->left = n->left;
+        other->left_thread = n->left_thread;
+        other->right = n->right;
+        other->right_thread = n->right_thread;
+        other->left->find_maximum()->right = other;
+        if (!other->right_thread) {
+            other->right->find_minimum()->left = other;
+        }
+        if (!parent->left_thread && parent->left == n) {
+            parent->left = other;
+        } else {
+            parent->right = other;
+        }
+    }
+
+    // Los recorridos en orden y en pre-orden siguen los hilos, sin pila. El
+    // post-orden necesita una pila explícita, como en los otros árboles.
+    // visit recibe cada nodo y devuelve false para interrumpir el recorrido.
+
+    template <typename F>
+    bool visit_in_order(F visit) {
+        for (node_base * current = m_root.find_minimum(); current != &m_root; ) {
+            if (!visit(current)) {
+                return false;
+            }
+            current = (++iterator(current)).m_current;
+        }
+        return true;
+    }
+
+    // Después de un nodo sin hijo izquierdo viene el hijo derecho del primer
+    // nodo que lo tenga, siguiendo los hilos derechos desde él.
+    template <typename F>
+    bool visit_preorder(F visit) {
+        if (empty()) {
+            return true;
+        }
+        node_base * current = m_root.left;
+        while (current != &m_root) {
+            if (!visit(current)) {
+                return false;
+            }
+            if (!current->left_thread) {
+                current = current->left;
+            } else {
+                while (current != &m_root && current->right_thread) {
+                    current = current->right;
+                }
+                if (current != &m_root) {
+                    current = current->right;
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename F>
+    bool visit_postorder(F visit) {
+        std::vector<node_base *> pending;
+        node_base * current = empty() ? nullptr : m_root.left;
+        node_base * last = nullptr;
+        while (current != nullptr || !pending.empty()) {
+            if (current != nullptr) {
+                pending.push_back(current);
+                current = current->left_thread ? nullptr : current->left;
+            } else {
+                node_base * top = pending.back();
+                if (!top->right_thread && top->right != last) {
+                    current = top->right;
+                } else {
+                    if (!visit(top)) {
+                        return false;
+                    }
+                    last = top;
+                    pending.pop_back();
+                }
+            }
+        }
+        return true;
+    }
+
+    // Copia la forma con una pila explícita y después enhebra la copia
+    // recorriéndola en orden: cada hilo izquierdo apunta al nodo anterior y
+    // cada hilo derecho al siguiente.
+    void copy_nodes(node_base * root) {
+        struct info {
+            node_base * from;
+            node_base * & to;
+        };
+        std::stack<info> nodes;
+        nodes.push({ root, m_root.left });
+        m_root.left_thread = false;
+        while (!nodes.empty()) {
+            auto data = nodes.top();
+            nodes.pop();
+            data.to = new node(value_of(data.from), data.from->left_thread, data.from->right_thread);
+            if (!data.from->left_thread) {
+                nodes.push({ data.from->left, data.to->left });
+            }
+            if (!data.from->right_thread) {
+                nodes.push({ data.from->right, data.to->right });
+            }
+        }
+
+        std::vector<node_base *> pending;
+        node_base * prev = &m_root;
+        node_base * current = m_root.left;
+        while (current != nullptr || !pending.empty()) {
+            while (current != nullptr) {
+                pending.push_back(current);
+                current = current->left_thread ? nullptr : current->left;
+            }
+            current = pending.back();
+            pending.pop_back();
+            if (current->left_thread) {
+                current->left = prev;
+            }
+            if (prev != &m_root && prev->right_thread) {
+                prev->right = current;
+            }
+            prev = current;
+            current = current->right_thread ? nullptr : current->right;
+        }
+        prev->right = &m_root;
+    }
+
+
+    /************************************************************************/
+    /************** AQUÍ NO HAY NADA PARA VER... ¡CIRCULE! :-P **************/
+    /************************************************************************/
+
+    using nodes_placement = std::vector<std::tuple<int, int, const node_base *>>;
+
+    void calculate_nodes_placement(const node_base * current, int & x, int h, nodes_placement & placements) const {
+        if (!current->left_thread) {
+            calculate_nodes_placement(current->left, x, h+1, placements);
+        }
+        placements.emplace_back(h, x++, current);
+        if (!current->right_thread) {
+            calculate_nodes_placement(current->right, x, h+1, placements);
+        }
+    }
+
+public:
+
+    std::string str() const {
+        // Éste método genera una representación "gráfica" del árbol usando caracteres ASCII
+        int count = 0;
+        nodes_placement placements;
+        if (!m_root.left_thread) {
+            calculate_nodes_placement(m_root.left, count, 0, placements);
+        }
+
+        const int node_value_size = 3;
+        std::vector<std::string> lines;
+        int prev_level = -1;
+        for (const auto & placement: placements) {
+            int level;
+            int pos;
+            const node_base * the_node;
+            std::tie(level, pos, the_node) = placement;
+
+            while (int(lines.size()) <= 2 * level) {
+                lines.emplace_back();
+            }
+
+            std::ostringstream s;
+            int i = 2 * level;
+            s << std::setw(pos * node_value_size - lines[i].size()) << "";
+            s << std::setw(node_value_size) << value_of(the_node);
+            lines[i] += s.str();
+
+            if (prev_level != -1) {
+                char c;
+                if (prev_level < level) {
+                    i = 2 * prev_level + 1;
+                    c = '\\';
+                } else {
+                    i = 2 * level + 1;
+                    c = '/';
+                }
+
+                s.str("");
+                s << std::setw(pos * node_value_size - lines[i].size()) << "";
+                s << std::setw(node_value_size / 2) << c;
+                lines[i] += s.str();
+            }
+            prev_level = level;
+        }
+
+        std::string result;
+        for (const auto & line: lines) {
+            result += line;
+            result += '\n';
+        }
+        return result;
+    }
+};
+
+#endif // THREADED_TREE_H